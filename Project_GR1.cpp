@@ -11,15 +11,58 @@
 #include <cctype>
 #include <string>
 #include <algorithm> // for transform()
+#include "thread_utils.hpp"
+#include "file_utils.hpp"
+#include "report_writer.hpp"
+#include "backup_store.hpp"
+#include "memory_stats.hpp"
+#include "metrics.hpp"
+#include "tracing.hpp"
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <signal.h>
+#include <errno.h>
+#endif
 using namespace std;
 
 // Constants
-const int MAX_STUDENTS = 100;
+const int MAX_STUDENTS = 100;           // Admin capacity, and the initial student capacity
 const int MAX_APPLICATIONS = 200;
 const int TABLE_SIZE = 10;
 const int MAX_JOBS = 50;
 const int MAX_STAFF = 20;
 const string LOG_FILE = "system_log.txt";
+const int APPLICATION_BUCKETS = 64;     // Initial bucket count of the application index
+const int IMPORT_CHUNK_ROWS = 8192;     // Rows validated per parallel import chunk
+const long LOAD_CHUNK_BYTES = 1L << 20; // Data files are parsed in pieces of about this size
+const int MAX_RECORD_FIELDS = 7;        // Widest data file row (students.txt table layout)
+const int REVIEW_PAGE_SIZE = 10;        // Applications shown per review page
+const int DECISION_LOG_COMPACT_ROWS = 5000; // Fold the decision log into applications.txt after this many rows
+const string DECISION_LOG_FILE = "application_decisions.txt";
+const string BACKUP_DIRECTORY = "backups";   // Chunk store and snapshot manifests, see backupSystemData()
+const int MAX_SERVER_CONNECTIONS = 256; // Concurrent clients in server mode
+const int MAX_CATALOG_READERS = 64;     // Threads reading the job catalog at once
+const int MAX_CATALOG_RETIRED = 32;     // Old catalog snapshots awaiting reclamation
+const int PARALLEL_SORT_THRESHOLD = 4096; // Smaller arrays are sorted on the calling thread only
+const int REPORT_TOP_STUDENTS = 10;     // Students listed in the performance report ranking
+const int MAX_RANKED_CANDIDATES = 100;  // Best applicants kept per job by the candidate ranking
+const int MAX_RANKED_SKILLS = 16;       // Job requirements a candidate is scored against
+const float CANDIDATE_CGPA_WEIGHT = 60.0f;   // Share of the 100-point candidate score from CGPA,
+const float CANDIDATE_SKILLS_WEIGHT = 40.0f; // and from the job's requirements found in the skills
+const double HEALTH_FRAGMENTATION_WARN = 0.30;  // Free share of the heap arena that costs health points,
+const double HEALTH_FRAGMENTATION_BAD = 0.50;   // and that costs more
+const long HEALTH_FRAGMENTATION_MIN_BYTES = 32L * 1024 * 1024; // Free heap below this is never counted as fragmentation
+const double HEALTH_RSS_SHARE_WARN = 0.25;      // Resident memory as a share of the machine's RAM
+const double HEALTH_RSS_SHARE_BAD = 0.50;
+const int METRICS_EXPORT_SECONDS = 15;         // How often --metrics rewrites its file
+const int HEALTH_CHAIN_WARN = 24;               // Longest application index chain before lookups slow down (2 per bucket on average)
+const long DATASET_MAX_SCALE = 10000000;       // Most students --generate writes
+const unsigned long DATASET_SEED = 20240601UL; // Default --generate seed, also picks the benchmark lookup keys
+const int BENCHMARK_ROUNDS = 5;                 // Timed runs of each benchmark unless --rounds says otherwise
+const int MAX_BENCHMARK_ROUNDS = 100;
+const int BENCHMARK_LOOKUPS = 100000;           // Keys looked up per run of a lookup benchmark
 
 
 // Forward declarations
@@ -120,19 +163,259 @@ struct LogEntry
 
 
 
+// One shared copy of each string that repeats across many records, such as
+// the job title and company of every application to the same job. Entries
+// are never freed, so returned references stay valid for the whole run.
+// The table is split into independently locked stripes so the parallel
+// loader's workers rarely wait for each other.
+class StringPool
+{
+private:
+    static const int STRIPES = 16;
+
+    struct Entry
+    {
+        string value;
+        Entry* next;
+        Entry(const string& text, Entry* chain) : value(text), next(chain) {}
+    };
+
+    struct Stripe
+    {
+        Mutex mutex;
+        Entry** buckets;
+        int bucketCount;
+        int count;
+    };
+
+    Stripe stripes[STRIPES];
+
+    static unsigned int hash(const string& value)
+    {
+        unsigned int h = 2166136261u;
+        for (size_t i = 0; i < value.length(); i++) {
+            h = (h ^ (unsigned char)value[i]) * 16777619u;
+        }
+        return h;
+    }
+
+    static void grow(Stripe& stripe)
+    {
+        int newCount = stripe.bucketCount * 2;
+        Entry** bigger = new Entry*[newCount];
+        for (int i = 0; i < newCount; i++) bigger[i] = NULL;
+        for (int i = 0; i < stripe.bucketCount; i++) {
+            Entry* entry = stripe.buckets[i];
+            while (entry != NULL) {
+                Entry* next = entry->next;
+                int bucket = (int)((hash(entry->value) / STRIPES) % (unsigned int)newCount);
+                entry->next = bigger[bucket];
+                bigger[bucket] = entry;
+                entry = next;
+            }
+        }
+        delete[] stripe.buckets;
+        stripe.buckets = bigger;
+        stripe.bucketCount = newCount;
+    }
+
+    StringPool(const StringPool&);
+    StringPool& operator=(const StringPool&);
+
+public:
+    StringPool()
+    {
+        for (int s = 0; s < STRIPES; s++) {
+            stripes[s].bucketCount = 16;
+            stripes[s].count = 0;
+            stripes[s].buckets = new Entry*[16];
+            for (int i = 0; i < 16; i++) stripes[s].buckets[i] = NULL;
+        }
+    }
+
+    ~StringPool()
+    {
+        for (int s = 0; s < STRIPES; s++) {
+            for (int i = 0; i < stripes[s].bucketCount; i++) {
+                Entry* entry = stripes[s].buckets[i];
+                while (entry != NULL) {
+                    Entry* next = entry->next;
+                    delete entry;
+                    entry = next;
+                }
+            }
+            delete[] stripes[s].buckets;
+        }
+    }
+
+    const string& intern(const string& value)
+    {
+        unsigned int h = hash(value);
+        Stripe& stripe = stripes[h % STRIPES];
+        ScopedLock guard(stripe.mutex);
+
+        int bucket = (int)((h / STRIPES) % (unsigned int)stripe.bucketCount);
+        for (Entry* entry = stripe.buckets[bucket]; entry != NULL; entry = entry->next) {
+            if (entry->value == value) return entry->value;
+        }
+        if (stripe.count >= stripe.bucketCount) {
+            grow(stripe);
+            bucket = (int)((h / STRIPES) % (unsigned int)stripe.bucketCount);
+        }
+        Entry* entry = new Entry(value, stripe.buckets[bucket]);
+        stripe.buckets[bucket] = entry;
+        stripe.count++;
+        return entry->value;
+    }
+
+    // Distinct strings held and the heap behind them, for diagnostics
+    int measure(long& objectBytes, long& stringBytes)
+    {
+        int entries = 0;
+        for (int s = 0; s < STRIPES; s++) {
+            ScopedLock guard(stripes[s].mutex);
+            objectBytes += heapBlockBytes(stripes[s].bucketCount * sizeof(Entry*));
+            for (int i = 0; i < stripes[s].bucketCount; i++) {
+                for (Entry* entry = stripes[s].buckets[i]; entry != NULL; entry = entry->next) {
+                    objectBytes += heapBlockBytes(sizeof(Entry));
+                    stringBytes += stringHeapBytes(entry->value);
+                    entries++;
+                }
+            }
+        }
+        return entries;
+    }
+};
+
+// Job titles and companies of applications; see ApplicationNode
+StringPool applicationStrings;
+
+
+// Timed operations and counted events, see metrics.hpp. Shown by
+// runSystemDiagnostics() and exported with --metrics.
+enum MetricId
+{
+    METRIC_LOGIN, METRIC_LOGIN_FAILURES, METRIC_LOOKUP, METRIC_SEARCH, METRIC_SORT, METRIC_LOAD,
+    METRIC_SAVE, METRIC_APPLY, METRIC_DECIDE, METRIC_RANK, METRIC_QUERY, METRIC_REPORT, METRIC_IMPORT,
+    METRIC_BACKUP, METRIC_RESTORE, METRIC_REQUEST, METRIC_REQUEST_ERRORS, METRIC_COMMAND, METRIC_COMMAND_ERRORS,
+    METRIC_COUNT
+};
+
+const MetricDefinition METRIC_DEFINITIONS[METRIC_COUNT] = {
+    { "login", "Credential checks of student, staff and admin logins", METRIC_TIMER },
+    { "login_failures", "Logins refused", METRIC_COUNTER },
+    { "lookup", "Student and job lookups by ID", METRIC_TIMER },
+    { "search", "Student and job searches", METRIC_TIMER },
+    { "sort", "Sorts of the student or job list", METRIC_TIMER },
+    { "load", "Data file loads", METRIC_TIMER },
+    { "save", "Data file saves", METRIC_TIMER },
+    { "apply", "Applications submitted", METRIC_TIMER },
+    { "decide", "Batches of application decisions", METRIC_TIMER },
+    { "rank", "Candidate rankings", METRIC_TIMER },
+    { "query", "Applicant queries", METRIC_TIMER },
+    { "report", "Reports and exports", METRIC_TIMER },
+    { "import", "Bulk imports", METRIC_TIMER },
+    { "backup", "Backups written", METRIC_TIMER },
+    { "restore", "Restores", METRIC_TIMER },
+    { "request", "Server requests", METRIC_TIMER },
+    { "request_errors", "Server requests answered with ERR", METRIC_COUNTER },
+    { "command", "Commands run from --run or --script", METRIC_TIMER },
+    { "command_errors", "Commands that failed", METRIC_COUNTER }
+};
+
+MetricsRegistry metrics(METRIC_DEFINITIONS, METRIC_COUNT);
+
+
+// Keeps the K best items offered so far, weakest at the root of a heap,
+// so ranking a whole array needs K slots instead of a sorted copy
+template <class T, int K, bool (*Better)(const T&, const T&)>
+class BoundedTopK
+{
+private:
+    T items[K];
+    int count;
+
+    void siftUp(int i)
+    {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!Better(items[parent], items[i])) break;
+            swap(items[parent], items[i]);
+            i = parent;
+        }
+    }
+
+    void siftDown(int i)
+    {
+        while (true) {
+            int weakest = i;
+            int left = 2 * i + 1, right = left + 1;
+            if (left < count && Better(items[weakest], items[left])) weakest = left;
+            if (right < count && Better(items[weakest], items[right])) weakest = right;
+            if (weakest == i) break;
+            swap(items[weakest], items[i]);
+            i = weakest;
+        }
+    }
+
+public:
+    BoundedTopK() : count(0) {}
+
+    int getCount() const { return count; }
+
+    // Kept items in heap order, weakest first
+    const T& get(int index) const { return items[index]; }
+
+    void offer(const T& item)
+    {
+        if (count < K) {
+            items[count] = item;
+            siftUp(count++);
+        } else if (Better(item, items[0])) {
+            items[0] = item;
+            siftDown(0);
+        }
+    }
+
+    void merge(const BoundedTopK& other)
+    {
+        for (int i = 0; i < other.count; i++) offer(other.items[i]);
+    }
+
+    // Copies the kept items into out, best first; returns how many
+    int getRanked(T* out) const
+    {
+        for (int i = 0; i < count; i++) {
+            T item = items[i];
+            int j = i;
+            while (j > 0 && Better(item, out[j - 1])) {
+                out[j] = out[j - 1];
+                j--;
+            }
+            out[j] = item;
+        }
+        return count;
+    }
+};
+
+
 // Dynamic Non-Primitive Data Structure - Linked List for Applications
 struct ApplicationNode 
 {
     string studentID;
     string jobID;
-    string jobTitle;
-    string company;
+    const string& jobTitle;        // Shared through applicationStrings, one copy per distinct value
+    const string& company;
     string status;
+    long sequence;                 // Arrival order, used as review priority
     ApplicationNode* next;
+    ApplicationNode* nextInBucket; // Chain inside ApplicationList's hash index
 
 
     ApplicationNode(string sid, string jid, string title, string comp, string stat)
-        : studentID(sid), jobID(jid), jobTitle(title), company(comp), status(stat), next(NULL) {}
+        : studentID(sid), jobID(jid), jobTitle(applicationStrings.intern(title)),
+          company(applicationStrings.intern(comp)), status(stat),
+          sequence(0), next(NULL), nextInBucket(NULL) {}
 };
 
 
@@ -140,23 +423,46 @@ class ApplicationList
 {
 private:
     ApplicationNode* head;
+    ApplicationNode* tail;
     int count;
+    long nextSequence;
+
+    // Hash index on (studentID, jobID) so search() does not walk the list
+    ApplicationNode** buckets;
+    int bucketCount;
+
+    int bucketFor(const string& studentID, const string& jobID) const;
+    void rehash(int newBucketCount);
 
 public:
-    ApplicationList() : head(NULL), count(0) {}
+    ApplicationList() : head(NULL), tail(NULL), count(0), nextSequence(0), bucketCount(APPLICATION_BUCKETS)
+    {
+        buckets = new ApplicationNode*[bucketCount];
+        for (int i = 0; i < bucketCount; i++) buckets[i] = NULL;
+    }
     ~ApplicationList() 
     {
         clear();
+        delete[] buckets;
     }
 
 
-    void insert(string studentID, string jobID, string jobTitle, string company, string status);
+    ApplicationNode* insert(string studentID, string jobID, string jobTitle, string company, string status);
+    ApplicationNode* append(ApplicationNode* node);
+    void reserve(int expectedCount);
     void display();
     void clear();
     bool search(string studentID, string jobID);
-    void saveToFile(const string& filename);
+    ApplicationNode* find(const string& studentID, const string& jobID) const;
+    void saveToFile(const string& filename, DurableSaver& saver);
+    void writeTo(OutputBuffer& out) const;
+    static void writeLine(OutputBuffer& out, const ApplicationNode* node, const string& status);
     void loadFromFile(const string& filename);
     int getCount() const { return count; }
+    ApplicationNode* getHead() const { return head; }
+    ApplicationNode* getTail() const { return tail; }
+    long indexBytes() const { return heapBlockBytes(bucketCount * sizeof(ApplicationNode*)); }
+    int longestChain() const;
     
 
     friend class Student;
@@ -164,190 +470,718 @@ public:
 };
 
 
-// Base class - Person
-class Person 
+// An application belongs to a department when its company field names it
+inline bool departmentMatches(const string& company, const string& department)
 {
-protected:
-    string id;
-    string name;
-    string email;
-    
-public:
-    Person() : id(""), name(""), email("") {}
-    Person(string id, string name, string email) : id(id), name(name), email(email) {}
-    virtual ~Person() {}
+    return company.find(department) != string::npos;
+}
 
 
-    virtual void displayInfo() = 0;
-    virtual bool login() = 0;
-    
+// Min-heap of one department's pending applications, oldest first.
+// Entries decided elsewhere stay in the heap and are dropped when popped;
+// an application reopened before its old entry was dropped pops once.
+class ReviewQueue
+{
+private:
+    string department;
+    ApplicationNode** heap;
+    int size;
+    int capacity;
 
-    // Overloaded functions
-    void setInfo(string id);
-    void setInfo(string id, string name);
-    void setInfo(string id, string name, string email);
+    void siftUp(int index);
+    void siftDown(int index);
+
+public:
+    ReviewQueue(const string& department);
+    ~ReviewQueue() { delete[] heap; }
 
+    void push(ApplicationNode* node);
+    ApplicationNode* popPending();
+    void clear() { size = 0; }
 
-    string getID() const { return id; }
-    string getName() const { return name; }
-    string getEmail() const { return email; }
+    bool matches(const string& company) const { return departmentMatches(company, department); }
+    string getDepartment() const { return department; }
+    int getSize() const { return size; }
+    long memoryBytes() const
+    {
+        return heapBlockBytes(sizeof(ReviewQueue)) + stringHeapBytes(department) +
+               heapBlockBytes(capacity * sizeof(ApplicationNode*));
+    }
+};
 
 
-    friend class InternshipSystem;
+// Application counts for one job inside a department
+struct JobStatusCounts
+{
+    string jobID;
+    string jobTitle;
+    int total;
+    int pending;
+    int approved;
+    int rejected;
 };
 
-// Derived class - Student
-class Student : public Person 
+
+// Running application counts for one department. Kept current by
+// InternshipSystem::addApplication() and setApplicationStatus(), so
+// reading them never touches applications.txt.
+class DepartmentStats
 {
 private:
-    float cgpa;
-    string diploma;
-    string skills;
-    static int totalStudents;
-
-public:
-    Student() : Person(), cgpa(0.0), diploma(""), skills("") { totalStudents++; }
-    Student(string id, string name, string email, float cgpa, string diploma, string skills)
-        : Person(id, name, email), cgpa(cgpa), diploma(diploma), skills(skills) { totalStudents++; }
+    string department;
+    JobStatusCounts overall;
+    JobStatusCounts* jobs;
+    int jobCount;
+    int jobCapacity;
 
+    JobStatusCounts* findJob(const string& jobID, const string& jobTitle);
+    static void adjust(JobStatusCounts& counts, const string& status, int delta);
 
-    ~Student() { totalStudents--; }
+public:
+    DepartmentStats(const string& department);
+    ~DepartmentStats() { delete[] jobs; }
 
-    void displayInfo();
-    bool login();
+    void add(const ApplicationNode* node);
+    void changeStatus(const ApplicationNode* node, const string& oldStatus, const string& newStatus);
+    void clear();
 
-    
+    bool matches(const string& company) const { return departmentMatches(company, department); }
+    string getDepartment() const { return department; }
+    const JobStatusCounts& getTotals() const { return overall; }
+    int getJobCount() const { return jobCount; }
+    const JobStatusCounts& getJobCounts(int index) const { return jobs[index]; }
+    long memoryBytes() const;
+};
 
-    // Overloaded functions
-    void updateProfile();
-    void updateProfile(string newEmail);
-    void updateProfile(string newEmail, float newCGPA);
-    void updateProfile(string newEmail, float newCGPA, string newSkills);
 
+// An applicant scored for one job, see InternshipSystem::rankCandidates()
+struct RankedCandidate
+{
+    ApplicationNode* application;
+    float score;          // Out of 100
+    int matchedSkills;    // Job requirements found in the student's skills
+};
 
-    void viewInternships();
-    void applyForInternship();
-    void viewMyApplications();
-    void generateSummaryReport();
+// Higher score first; ties go to the earlier application
+inline bool candidateRankedHigher(const RankedCandidate& a, const RankedCandidate& b)
+{
+    if (a.score != b.score) return a.score > b.score;
+    return a.application->sequence < b.application->sequence;
+}
 
+typedef BoundedTopK<RankedCandidate, MAX_RANKED_CANDIDATES, candidateRankedHigher> CandidateHeap;
 
-    // Getters and Setters
-    float getCGPA() const { return cgpa; }
-    string getDiploma() const { return diploma; }
-    string getSkills() const { return skills; }
-    
 
-    void setCGPA(float cgpa) { this->cgpa = cgpa; }
-    void setDiploma(string diploma) { this->diploma = diploma; }
-    void setSkills(string skills) { this->skills = skills; }
+// Best candidates of one job and the requirements they were scored against
+struct CandidateRanking
+{
+    CandidateHeap best;
+    string requirements[MAX_RANKED_SKILLS];
+    int requirementCount;
 
-    
-    static int getTotalStudents() { return totalStudents; }
+    bool holds(const ApplicationNode* node) const
+    {
+        for (int i = 0; i < best.getCount(); i++) {
+            if (best.get(i).application == node) return true;
+        }
+        return false;
+    }
+};
 
 
-    friend void saveStudentToFile(Student& student, ostream& file);
-    friend class Admin;
+// All applications for one job
+struct JobApplicants
+{
+    string jobID;
+    ApplicationNode** nodes;
+    int count;
+    int capacity;
+    CandidateRanking* ranking;  // NULL until ranked, and again after a change it cannot absorb
+    JobApplicants* next;        // Chain inside JobApplicantIndex's buckets
 };
 
 
-// Derived class - Admin
-class Admin : public Person 
+// Applications grouped by job ID, so ranking a job reads only its own
+// applicants. Built from the store on demand and extended by addApplication().
+class JobApplicantIndex
 {
 private:
-    string password;
-    string role;
-    static int totalAdmins;
+    JobApplicants** buckets;
+    int bucketCount;
+    int jobCount;
 
+    int bucketFor(const string& jobID) const;
+    void rehash(int newBucketCount);
+
+    JobApplicantIndex(const JobApplicantIndex&);
+    JobApplicantIndex& operator=(const JobApplicantIndex&);
 
 public:
-    Admin() : Person(), password(""), role("Admin") { totalAdmins++; }
-    Admin(string id, string name, string email, string password)
-        : Person(id, name, email), password(password), role("Admin") { totalAdmins++; }
+    JobApplicantIndex();
+    ~JobApplicantIndex();
 
+    JobApplicants* add(ApplicationNode* node);
+    JobApplicants* find(const string& jobID) const;
+    void dropRankings();
+    void clear();
+    long memoryBytes() const;
 
-    ~Admin() { totalAdmins--; }
+    static void dropRanking(JobApplicants* entry)
+    {
+        delete entry->ranking;
+        entry->ranking = NULL;
+    }
+};
 
 
-    void displayInfo();
-    bool login();
+// Dimensions of the application cube. Applications carry no date of
+// their own, so the time dimension is the month of the job's deadline.
+enum CubeDimension { CUBE_DIPLOMA, CUBE_COMPANY, CUBE_STATUS, CUBE_MONTH, CUBE_DIMENSIONS };
+const int CUBE_CUBOIDS = 1 << CUBE_DIMENSIONS;  // One group-by per subset of dimensions
+const int CUBE_ANY = -1;                       // Slice value meaning "not restricted"
 
 
-    void manageStudents(InternshipSystem* system);
-    void manageInternships(InternshipSystem* system);
-    void viewAllApplications();
-    void generateReports();
-    void manageStaff(InternshipSystem* system);
+// Distinct values seen in one cube dimension, numbered from 0
+class CubeDictionary
+{
+private:
+    string* values;
+    int count;
+    int capacity;
+    int* slots;     // Open-addressing index into values, -1 when empty
+    int slotCount;
 
+    int slotFor(const string& value) const;
+    void grow();
 
-    static int getTotalAdmins() { return totalAdmins; }
+public:
+    CubeDictionary();
+    ~CubeDictionary();
+
+    int lookup(const string& value) const;   // CUBE_ANY when unknown
+    int intern(const string& value);
+    void clear();
+    int getCount() const { return count; }
+    const string& getValue(int id) const { return values[id]; }
+    long memoryBytes() const;
+};
 
 
-    friend void saveAdminToFile(Admin& admin, ostream& file);
-    friend class InternshipSystem;
+// One aggregated cell: value ids of the grouped dimensions (0 elsewhere)
+struct CubeCell
+{
+    int key[CUBE_DIMENSIONS];
+    long count;
 };
 
 
-// New Staff class
-class Staff : public Person
+// Application counts grouped by diploma, company, status and deadline month.
+// Every subset of the dimensions (16 cuboids) is kept pre-aggregated and
+// updated on each insert or status change, so a roll-up or slice reads one
+// cuboid instead of the application store.
+class ApplicationCube
 {
 private:
-    string department;
-    string position;
-    string password;
-    static int totalStaff;
-    
-    bool isDepartmentMatch(const string& company, const string& department);
+    struct Cuboid
+    {
+        CubeCell* cells;
+        int cellCount;
+        int cellCapacity;
+        int* slots;
+        int slotCount;
+    };
+
+    CubeDictionary dictionaries[CUBE_DIMENSIONS];
+    Cuboid cuboids[CUBE_CUBOIDS];
+
+    static unsigned int hashKey(const int* key);
+    static bool sameKey(const int* a, const int* b);
+    static void growCuboid(Cuboid& cuboid);
+    static CubeCell* findCell(const Cuboid& cuboid, const int* key);
+    static CubeCell* findOrAddCell(Cuboid& cuboid, const int* key);
+
+    void adjust(const int* coordinates, long delta);
+
+    ApplicationCube(const ApplicationCube&);
+    ApplicationCube& operator=(const ApplicationCube&);
 
 public:
-    Staff() : Person(), department(""), position(""), password("") { totalStaff++; }
-    Staff(string id, string name, string email, string dept, string pos, string pwd)
-        : Person(id, name, email), department(dept), position(pos), password(pwd) { totalStaff++; }
-    ~Staff() { totalStaff--; }
+    ApplicationCube();
+    ~ApplicationCube();
 
-    void displayInfo();
-    bool login();
+    // values[] holds the diploma, company, status and month of one application
+    void add(const string* values);
+    void changeStatus(const string* values, const string& newStatus);
+    void clear();
 
-    void processApplications(InternshipSystem* system); // Updated declaration
-    void generateDepartmentReport(InternshipSystem* system); // Updated declaration
-    void viewDepartmentInternships(InternshipSystem* system); // New declaration
+    // Count for a fully or partly fixed coordinate; CUBE_ANY rolls a dimension up
+    long count(const int* slice) const;
 
-    string getDepartment() const { return department; }
-    string getPosition() const { return position; }
+    // Cells of the group-by over groupMask (bit d = dimension d) inside the
+    // slice. Writes at most maxCells cells to out and returns how many matched.
+    int select(int groupMask, const int* slice, CubeCell* out, int maxCells) const;
 
-    void setDepartment(string dept) { department = dept; }
-    void setPosition(string pos) { position = pos; }
+    int getCellCount(int mask) const { return cuboids[mask].cellCount; }
+    const CubeDictionary& getDictionary(int dimension) const { return dictionaries[dimension]; }
+    long memoryBytes() const;
+};
 
-    static int getTotalStaff() { return totalStaff; }
 
-    friend void saveStaffToFile(Staff& staff, ostream& file);
+// A cross-tab request. rows and columns are CubeDimension values or
+// CUBE_ANY; slice holds a required value per dimension ("" for all).
+struct CubeQuery
+{
+    int rows;
+    int columns;
+    string slice[CUBE_DIMENSIONS];
+    bool approvalRate;
+
+    CubeQuery() : rows(CUBE_ANY), columns(CUBE_ANY), approvalRate(false) {}
 };
-bool Staff::isDepartmentMatch(const string& company, const string& department) {
-    string c = company;
-    string d = department;
 
-    // Convert both to lowercase
-    transform(c.begin(), c.end(), c.begin(), ::tolower);
-    transform(d.begin(), d.end(), d.begin(), ::tolower);
+const char* const CUBE_DIMENSION_NAMES[CUBE_DIMENSIONS] = { "diploma", "company", "status", "month" };
 
-    return c.find(d) != string::npos || d.find(c) != string::npos;
+// Accepts a dimension name; "department" is another name for company
+bool parseCubeDimension(const string& name, int& dimension)
+{
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (name == CUBE_DIMENSION_NAMES[d]) {
+            dimension = d;
+            return true;
+        }
+    }
+    if (name == "department") {
+        dimension = CUBE_COMPANY;
+        return true;
+    }
+    return false;
 }
 
 
-// InternshipJob class
-class InternshipJob
-{
-private:
+// Fields of an application joined to its student and job records
+enum JoinField { JOIN_STUDENT_ID, JOIN_NAME, JOIN_EMAIL, JOIN_CGPA, JOIN_DIPLOMA, JOIN_SKILLS,
+                 JOIN_JOB_ID, JOIN_TITLE, JOIN_COMPANY, JOIN_DEADLINE, JOIN_STATUS, JOIN_FIELDS };
+
+const ReportColumn JOIN_COLUMNS[JOIN_FIELDS] = {
+    { "student_id", "Student ID", COLUMN_TEXT, 13 },
+    { "name", "Name", COLUMN_TEXT, 25 },
+    { "email", "Email", COLUMN_TEXT, 30 },
+    { "cgpa", "CGPA", COLUMN_DECIMAL, 6 },
+    { "diploma", "Diploma", COLUMN_TEXT, 12 },
+    { "skills", "Skills", COLUMN_TEXT, 40 },
+    { "job_id", "Job ID", COLUMN_TEXT, 9 },
+    { "title", "Title", COLUMN_TEXT, 28 },
+    { "company", "Company", COLUMN_TEXT, 24 },
+    { "deadline", "Deadline", COLUMN_TEXT, 12 },
+    { "status", "Status", COLUMN_TEXT, 10 }
+};
+
+enum JoinOperator { JOIN_EQUAL, JOIN_NOT_EQUAL, JOIN_LESS, JOIN_LESS_EQUAL,
+                    JOIN_GREATER, JOIN_GREATER_EQUAL, JOIN_CONTAINS };
+
+const int MAX_JOIN_CONDITIONS = 16;
+
+// One filter such as "cgpa>3", "status=Pending" or "company~google"
+// (~ is a case-insensitive substring match)
+struct JoinCondition
+{
+    int field;
+    int op;
+    string value;
+    double number;
+};
+
+// Filters (all must hold), the projected fields in output order, and an
+// optional row limit
+struct ApplicantQuery
+{
+    JoinCondition conditions[MAX_JOIN_CONDITIONS];
+    int conditionCount;
+    int columns[JOIN_FIELDS];
+    int columnCount;
+    long limit;
+
+    ApplicantQuery() : conditionCount(0), columnCount(0), limit(0) {}
+};
+
+
+bool parseJoinField(const string& name, int& field)
+{
+    for (int f = 0; f < JOIN_FIELDS; f++) {
+        if (name == JOIN_COLUMNS[f].name) {
+            field = f;
+            return true;
+        }
+    }
+    if (name == "department") {
+        field = JOIN_COMPANY;
+        return true;
+    }
+    return false;
+}
+
+bool parseJoinCondition(const string& text, JoinCondition& condition)
+{
+    size_t at = text.find_first_of("=!<>~");
+    if (at == string::npos || at == 0) return false;
+
+    string name = text.substr(0, at);
+    while (!name.empty() && name[name.length() - 1] == ' ') name.erase(name.length() - 1);
+    if (!parseJoinField(name, condition.field)) return false;
+
+    char first = text[at];
+    bool orEqual = (at + 1 < text.length() && text[at + 1] == '=');
+    switch (first) {
+        case '=': condition.op = JOIN_EQUAL; break;
+        case '!': if (!orEqual) return false; condition.op = JOIN_NOT_EQUAL; break;
+        case '<': condition.op = orEqual ? JOIN_LESS_EQUAL : JOIN_LESS; break;
+        case '>': condition.op = orEqual ? JOIN_GREATER_EQUAL : JOIN_GREATER; break;
+        default: condition.op = JOIN_CONTAINS; break;
+    }
+    size_t operatorLength = (first != '=' && orEqual) ? 2 : 1;
+    condition.value = text.substr(at + operatorLength);
+    while (!condition.value.empty() && condition.value[0] == ' ') condition.value.erase(0, 1);
+
+    condition.number = 0.0;
+    if (JOIN_COLUMNS[condition.field].type == COLUMN_DECIMAL) {
+        char* end = NULL;
+        condition.number = strtod(condition.value.c_str(), &end);
+        if (condition.value.empty() || *end != '\0') return false;
+    }
+    return true;
+}
+
+// Comma-separated field names, e.g. "student_id,name,cgpa"
+bool parseJoinColumns(const string& list, ApplicantQuery& query)
+{
+    query.columnCount = 0;
+    stringstream ss(list);
+    string name;
+    while (getline(ss, name, ',')) {
+        if (name.empty()) continue;
+        if (query.columnCount == JOIN_FIELDS || !parseJoinField(name, query.columns[query.columnCount])) {
+            return false;
+        }
+        query.columnCount++;
+    }
+    return query.columnCount > 0;
+}
+
+
+// Open-addressing table from a record's ID to the record, built for one
+// query. Keys point into the records, which must outlive the table.
+template <class T>
+class JoinHashTable
+{
+private:
+    const string** keys;
+    T** records;
+    unsigned int mask;
+
+    JoinHashTable(const JoinHashTable&);
+    JoinHashTable& operator=(const JoinHashTable&);
+
+    static unsigned int hash(const string& key)
+    {
+        unsigned int h = 2166136261u;
+        for (size_t i = 0; i < key.length(); i++) {
+            h = (h ^ (unsigned char)key[i]) * 16777619u;
+        }
+        return h;
+    }
+
+public:
+    explicit JoinHashTable(int expected)
+    {
+        unsigned int size = 16;
+        while (size < (unsigned int)expected * 2) size <<= 1;
+        mask = size - 1;
+        keys = new const string*[size];
+        records = new T*[size];
+        for (unsigned int i = 0; i < size; i++) keys[i] = NULL;
+    }
+
+    ~JoinHashTable()
+    {
+        delete[] keys;
+        delete[] records;
+    }
+
+    // The first record inserted under a key wins
+    void insert(const string& key, T* record)
+    {
+        unsigned int slot = hash(key) & mask;
+        while (keys[slot] != NULL) {
+            if (*keys[slot] == key) return;
+            slot = (slot + 1) & mask;
+        }
+        keys[slot] = &key;
+        records[slot] = record;
+    }
+
+    T* find(const string& key) const
+    {
+        unsigned int slot = hash(key) & mask;
+        while (keys[slot] != NULL) {
+            if (*keys[slot] == key) return records[slot];
+            slot = (slot + 1) & mask;
+        }
+        return NULL;
+    }
+};
+
+
+// Base class - Person
+class Person 
+{
+protected:
+    string id;
+    string name;
+    string email;
+    
+public:
+    Person() : id(""), name(""), email("") {}
+    Person(string id, string name, string email) : id(id), name(name), email(email) {}
+    virtual ~Person() {}
+
+
+    virtual void displayInfo() = 0;
+    virtual bool login() = 0;
+    
+
+    // Overloaded functions
+    void setInfo(string id);
+    void setInfo(string id, string name);
+    void setInfo(string id, string name, string email);
+
+
+    string getID() const { return id; }
+    string getName() const { return name; }
+    string getEmail() const { return email; }
+
+    // Heap behind the record's strings, see memory_stats.hpp
+    virtual long stringBytes() const
+    {
+        return stringHeapBytes(id) + stringHeapBytes(name) + stringHeapBytes(email);
+    }
+
+
+    friend class InternshipSystem;
+};
+
+// Derived class - Student
+class Student : public Person 
+{
+private:
+    float cgpa;
+    string diploma;
+    string skills;
+    static int totalStudents;
+
+public:
+    Student() : Person(), cgpa(0.0), diploma(""), skills("") { totalStudents++; }
+    Student(string id, string name, string email, float cgpa, string diploma, string skills)
+        : Person(id, name, email), cgpa(cgpa), diploma(diploma), skills(skills) { totalStudents++; }
+
+
+    ~Student() { totalStudents--; }
+
+    void displayInfo();
+    bool login();
+
+    
+
+    // Overloaded functions
+    void updateProfile();
+    void updateProfile(string newEmail);
+    void updateProfile(string newEmail, float newCGPA);
+    void updateProfile(string newEmail, float newCGPA, string newSkills);
+
+
+    void viewInternships(InternshipSystem* system);
+    void applyForInternship(InternshipSystem* system);
+    void viewMyApplications();
+    void generateSummaryReport(ReportFormat format = REPORT_TEXT);
+
+
+    // Getters and Setters
+    float getCGPA() const { return cgpa; }
+    string getDiploma() const { return diploma; }
+    string getSkills() const { return skills; }
+    
+
+    void setCGPA(float cgpa) { this->cgpa = cgpa; }
+    void setDiploma(string diploma) { this->diploma = diploma; }
+    void setSkills(string skills) { this->skills = skills; }
+
+    
+    static int getTotalStudents() { return totalStudents; }
+    long stringBytes() const { return Person::stringBytes() + stringHeapBytes(diploma) + stringHeapBytes(skills); }
+
+
+    friend void saveStudentToFile(Student& student, OutputBuffer& file);
+    friend class Admin;
+    friend class InternshipSystem;
+};
+
+
+// Derived class - Admin
+class Admin : public Person 
+{
+private:
+    string password;
+    string role;
+    static int totalAdmins;
+
+
+public:
+    Admin() : Person(), password(""), role("Admin") { totalAdmins++; }
+    Admin(string id, string name, string email, string password)
+        : Person(id, name, email), password(password), role("Admin") { totalAdmins++; }
+
+
+    ~Admin() { totalAdmins--; }
+
+
+    void displayInfo();
+    bool login();
+
+
+    void manageStudents(InternshipSystem* system);
+    void manageInternships(InternshipSystem* system);
+    void viewAllApplications();
+    void generateReports();
+    void manageStaff(InternshipSystem* system);
+
+
+    static int getTotalAdmins() { return totalAdmins; }
+    long stringBytes() const { return Person::stringBytes() + stringHeapBytes(password) + stringHeapBytes(role); }
+
+
+    friend void saveAdminToFile(Admin& admin, OutputBuffer& file);
+    friend class InternshipSystem;
+};
+
+
+// New Staff class
+class Staff : public Person
+{
+private:
+    string department;
+    string position;
+    string password;
+    static int totalStaff;
+    
+    bool isDepartmentMatch(const string& company, const string& department);
+
+public:
+    Staff() : Person(), department(""), position(""), password("") { totalStaff++; }
+    Staff(string id, string name, string email, string dept, string pos, string pwd)
+        : Person(id, name, email), department(dept), position(pos), password(pwd) { totalStaff++; }
+    ~Staff() { totalStaff--; }
+
+    void displayInfo();
+    bool login();
+
+    void processApplications(InternshipSystem* system); // Updated declaration
+    void generateDepartmentReport(InternshipSystem* system, ReportFormat format = REPORT_TEXT);
+    void viewDepartmentInternships(InternshipSystem* system); // New declaration
+
+    string getDepartment() const { return department; }
+    string getPosition() const { return position; }
+
+    void setDepartment(string dept) { department = dept; }
+    void setPosition(string pos) { position = pos; }
+
+    static int getTotalStaff() { return totalStaff; }
+    long stringBytes() const
+    {
+        return Person::stringBytes() + stringHeapBytes(department) + stringHeapBytes(position) +
+               stringHeapBytes(password);
+    }
+
+    friend void saveStaffToFile(Staff& staff, OutputBuffer& file);
+    friend class InternshipSystem;
+};
+bool Staff::isDepartmentMatch(const string& company, const string& department) {
+    string c = company;
+    string d = department;
+
+    // Convert both to lowercase
+    transform(c.begin(), c.end(), c.begin(), ::tolower);
+    transform(d.begin(), d.end(), d.begin(), ::tolower);
+
+    return c.find(d) != string::npos || d.find(c) != string::npos;
+}
+
+
+// Day numbers (days since 1970-01-01) for deadline comparisons
+const long NO_DEADLINE_DAY = 2147483647L; // Unparseable deadlines sort last and never expire
+
+long daysFromCivil(int year, int month, int day)
+{
+    year -= (month <= 2) ? 1 : 0;
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long yearOfEra = year - era * 400;
+    long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Parses "YYYY-MM-DD", or returns NO_DEADLINE_DAY
+long parseDeadlineDay(const string& date)
+{
+    if (date.length() != 10 || date[4] != '-' || date[7] != '-') return NO_DEADLINE_DAY;
+    for (int i = 0; i < 10; i++) {
+        if (i != 4 && i != 7 && !isdigit(date[i])) return NO_DEADLINE_DAY;
+    }
+    int year = atoi(date.substr(0, 4).c_str());
+    int month = atoi(date.substr(5, 2).c_str());
+    int day = atoi(date.substr(8, 2).c_str());
+    if (month < 1 || month > 12 || day < 1 || day > 31) return NO_DEADLINE_DAY;
+    return daysFromCivil(year, month, day);
+}
+
+// Today's local date as a day number
+long currentDayNumber()
+{
+    time_t now = time(0);
+    tm* local = localtime(&now);
+    return daysFromCivil(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday);
+}
+
+
+// Asks which format a report or export should be written in
+ReportFormat promptReportFormat()
+{
+    cout << "Output format: 1. Text  2. CSV  3. JSON lines  4. Columnar\n";
+    cout << "Enter choice [1]: ";
+    string choice;
+    getline(cin, choice);
+    if (choice == "2") return REPORT_CSV;
+    if (choice == "3") return REPORT_JSONL;
+    if (choice == "4") return REPORT_COLUMNAR;
+    return REPORT_TEXT;
+}
+
+
+// InternshipJob class
+class InternshipJob
+{
+private:
     string jobID;
     string title;
     string company;
     string deadline;
     string requirements;
     bool isActive;
+    long deadlineDay; // deadline parsed once, see parseDeadlineDay()
 
 public:
     // Fix constructor to match member variables
     InternshipJob(string id, string t, string c, string d, string req = "") 
-        : jobID(id), title(t), company(c), deadline(d), requirements(req), isActive(true) {}
+        : jobID(id), title(t), company(c), deadline(d), requirements(req), isActive(true),
+          deadlineDay(parseDeadlineDay(d)) {}
     
     ~InternshipJob() {}
 
@@ -363,6 +1197,12 @@ public:
     string getTitle() const { return title; }
     string getCompany() const { return company; }
     string getDeadline() const { return deadline; }
+    long getDeadlineDay() const { return deadlineDay; }
+    long stringBytes() const
+    {
+        return stringHeapBytes(jobID) + stringHeapBytes(title) + stringHeapBytes(company) +
+               stringHeapBytes(deadline) + stringHeapBytes(requirements);
+    }
 
     void displayInfo() {
         cout << "\n=== Job Information ===" << endl;
@@ -388,17 +1228,21 @@ public:
         
         if (!newTitle.empty()) title = newTitle;
         if (!newCompany.empty()) company = newCompany;
-        if (!newDeadline.empty()) deadline = newDeadline;
+        if (!newDeadline.empty()) {
+            deadline = newDeadline;
+            deadlineDay = parseDeadlineDay(newDeadline);
+        }
         if (!newRequirements.empty()) requirements = newRequirements;
         cout << "Job updated.\n";
     }
 
-    void display() {
-        cout << "Job ID: " << jobID << " | Title: " << title 
-             << " | Company: " << company << " | Deadline: " << deadline << endl;
+    void display(OutputBuffer& out) {
+        out.put("Job ID: ").put(jobID).put(" | Title: ").put(title)
+           .put(" | Company: ").put(company).put(" | Deadline: ").put(deadline).put('\n');
     }
 
-    friend void saveJobToFile(InternshipJob& job, ostream& file);
+    friend void saveJobToFile(InternshipJob& job, OutputBuffer& file);
+    friend class InternshipSystem;
 };
 
 
@@ -410,6 +1254,7 @@ private:
     int size;
     int count;
     int hash(string key);
+    void grow();
 
 
 public:
@@ -419,22 +1264,479 @@ public:
     void insert(Student* student);
     Student* search(string studentID);
     void remove(string studentID);
+    void clear();
     void display();
     double getLoadFactor() const { return (double)count / size; }
+    long memoryBytes() const { return heapBlockBytes(sizeof(StudentHashTable)) + heapBlockBytes(size * sizeof(Student*)); }
 };
 
 
-// Main System class
-class InternshipSystem
+// Hash Table for job lookup by Job ID (indexes jobs owned by InternshipSystem)
+class JobHashTable
 {
 private:
-    InternshipJob* jobs[50];
+    InternshipJob** table;
+    int size;
+    int count;
+    int hash(const string& key) const;
+
+public:
+    JobHashTable(int size = MAX_JOBS * 2);
+    ~JobHashTable();
+
+    void insert(InternshipJob* job);
+    InternshipJob* search(const string& jobID) const;
+    void remove(const string& jobID);
+    void clear();
+    double getLoadFactor() const { return (double)count / size; }
+    long memoryBytes() const { return heapBlockBytes(sizeof(JobHashTable)) + heapBlockBytes(size * sizeof(InternshipJob*)); }
+};
+
+
+// Min-heap of active jobs keyed by deadline day. The earliest deadline is
+// at the root, so expired jobs are swept off the top and "closing within
+// N days" only visits the jobs it returns.
+class DeadlineIndex
+{
+private:
+    InternshipJob** heap;
+    int size;
+    int capacity;
+
+    void siftUp(int index);
+    void siftDown(int index);
+    void collectUpTo(int index, long lastDay, InternshipJob** out, int& count, int maxCount) const;
+
+public:
+    DeadlineIndex(int capacity = MAX_JOBS);
+    ~DeadlineIndex() { delete[] heap; }
+
+    void insert(InternshipJob* job);
+    void remove(InternshipJob* job);
+    void clear() { size = 0; }
+    int sweep(long today);
+    int closingBy(long lastDay, InternshipJob** out, int maxCount) const;
+    int getSize() const { return size; }
+    long memoryBytes() const { return heapBlockBytes(sizeof(DeadlineIndex)) + heapBlockBytes(capacity * sizeof(InternshipJob*)); }
+};
+
+
+// Immutable copy of one job as published to catalog readers
+struct JobListing
+{
+    string jobID;
+    string title;
+    string company;
+    string deadline;
+    string requirements;
+    long deadlineDay;
+    bool isActive;
+};
+
+
+// One published version of the job catalog. Never changed once published;
+// edits build a new snapshot, see JobCatalog.
+struct JobCatalogSnapshot
+{
+    long version;
+    JobListing* listings;     // every job, in catalog order
+    int count;
+    const JobListing** open;  // active jobs, earliest deadline first
+    int openCount;
+
+    JobCatalogSnapshot(int capacity);
+    ~JobCatalogSnapshot();
+
+    int openBetween(long firstDay, long lastDay, int& first) const;
+    long memoryBytes() const;
+
+private:
+    JobCatalogSnapshot(const JobCatalogSnapshot&);
+    JobCatalogSnapshot& operator=(const JobCatalogSnapshot&);
+};
+
+
+// Read-copy-update publication of job catalog snapshots.
+// A reader pins the current epoch in a free slot, reads the snapshot
+// pointer and clears the slot when done, so readers never take a lock.
+// Writers swap in a new snapshot and free an old one once every pinned
+// reader entered after it was replaced.
+class JobCatalog
+{
+private:
+    struct RetiredSnapshot
+    {
+        JobCatalogSnapshot* snapshot;
+        long epoch;
+    };
+
+    JobCatalogSnapshot* volatile current;
+    volatile long epoch;
+    volatile long readerEpochs[MAX_CATALOG_READERS]; // 0 = slot free
+    RetiredSnapshot retired[MAX_CATALOG_RETIRED];
+    int retiredCount;
+    long nextVersion;
+    Mutex writerMutex;
+
+    void reclaim();
+
+    JobCatalog(const JobCatalog&);
+    JobCatalog& operator=(const JobCatalog&);
+
+public:
+    JobCatalog();
+    ~JobCatalog();
+
+    int enter(const JobCatalogSnapshot*& snapshot);
+    void leave(int slot);
+    void publish(JobCatalogSnapshot* snapshot);
+};
+
+
+// Holds one catalog snapshot for the lifetime of the object
+class JobCatalogReader
+{
+private:
+    JobCatalog& catalog;
+    const JobCatalogSnapshot* snapshot;
+    int slot;
+
+    JobCatalogReader(const JobCatalogReader&);
+    JobCatalogReader& operator=(const JobCatalogReader&);
+
+public:
+    JobCatalogReader(JobCatalog& c) : catalog(c), snapshot(NULL) { slot = catalog.enter(snapshot); }
+    ~JobCatalogReader() { catalog.leave(slot); }
+
+    const JobCatalogSnapshot* operator->() const { return snapshot; }
+};
+
+
+// Summary returned by InternshipSystem::importApplications()
+struct ImportResult
+{
+    int totalRows;
+    int accepted;
+    int duplicates;
+    int rejected;
+    double seconds;
+    double rowsPerSecond;
+    string rejectFile;
+
+    ImportResult() : totalRows(0), accepted(0), duplicates(0), rejected(0),
+                     seconds(0.0), rowsPerSecond(0.0), rejectFile("") {}
+};
+
+
+// A newline-aligned byte range of a data file and what was parsed from it
+struct LoadedRecord
+{
+    string fields[MAX_RECORD_FIELDS];
+    int fieldCount;
+};
+
+struct DataChunk
+{
+    const char* begin;
+    const char* end;
+    LoadedRecord* records;    // students, staff, admins, jobs
+    ApplicationNode** nodes;  // applications
+    int count;
+
+    DataChunk() : begin(NULL), end(NULL), records(NULL), nodes(NULL), count(0) {}
+    ~DataChunk() { delete[] records; delete[] nodes; }
+};
+
+enum DataFileKind { STUDENTS_FILE, STAFF_FILE, ADMINS_FILE, JOBS_FILE, APPLICATIONS_FILE };
+
+// One data file read by InternshipSystem::loadSystemData()
+struct DataFile
+{
+    DataFileKind kind;
+    string filename;
+    TaskScheduler* scheduler;
+    bool found;
+    bool tableLayout;  // students.txt kept as an aligned table with a header row
+    char* data;
+    long size;
+    DataChunk* chunks;
+    int chunkCount;
+
+    DataFile() : kind(STUDENTS_FILE), scheduler(NULL), found(false), tableLayout(false),
+                 data(NULL), size(0), chunks(NULL), chunkCount(0) {}
+    ~DataFile() { delete[] chunks; delete[] data; }
+};
+
+
+const int DATA_FILE_KINDS = 5;
+const int SNAPSHOT_BATCH_RECORDS = 1024;     // Records an online backup renders per turn
+const int SNAPSHOT_STATUS_BUCKETS = 1024;     // Initial size; doubles as statuses are kept
+
+// Every store as it was at one moment, written out by a backup while the
+// live stores keep changing. Freezing only notes how far each store
+// reaches; the backup then renders records from there in batches. A writer
+// about to change a store first renders the part of it the backup has not
+// reached (copy-on-write), except for application status changes, which
+// just keep the old status here. Guarded by InternshipSystem::snapshotMutex.
+struct OnlineSnapshot
+{
+    struct KeptStatus
+    {
+        const ApplicationNode* node;
+        string status;
+        KeptStatus* next;
+    };
+
+    string snapshotID;
+    string createdAt;
+    int frozenCount[DATA_FILE_KINDS];   // Array stores: records at the freeze
+    int cursor[DATA_FILE_KINDS];        // Next record the backup renders
+    bool detached[DATA_FILE_KINDS];     // The live store is no longer read
+    string rest[DATA_FILE_KINDS];       // Rendered by writers, not yet taken by the backup
+    ApplicationNode* nextApplication;
+    ApplicationNode* lastApplication;
+    KeptStatus** keptStatus;
+    int bucketCount;
+    int keptCount;
+
+    OnlineSnapshot() : nextApplication(NULL), lastApplication(NULL), bucketCount(SNAPSHOT_STATUS_BUCKETS), keptCount(0)
+    {
+        for (int i = 0; i < DATA_FILE_KINDS; i++) {
+            frozenCount[i] = 0;
+            cursor[i] = 0;
+            detached[i] = true;
+        }
+        keptStatus = new KeptStatus*[bucketCount];
+        for (int i = 0; i < bucketCount; i++) keptStatus[i] = NULL;
+    }
+
+    ~OnlineSnapshot()
+    {
+        for (int i = 0; i < bucketCount; i++) {
+            while (keptStatus[i] != NULL) {
+                KeptStatus* next = keptStatus[i]->next;
+                delete keptStatus[i];
+                keptStatus[i] = next;
+            }
+        }
+        delete[] keptStatus;
+    }
+
+    // The status the node had at the freeze, or NULL if it has not changed
+    const string* findStatus(const ApplicationNode* node) const
+    {
+        for (KeptStatus* kept = keptStatus[node->sequence % bucketCount]; kept != NULL; kept = kept->next) {
+            if (kept->node == node) return &kept->status;
+        }
+        return NULL;
+    }
+
+    void keepStatus(const ApplicationNode* node, const string& status)
+    {
+        if (keptCount >= bucketCount * 2) {
+            int biggerCount = bucketCount * 4;
+            KeptStatus** bigger = new KeptStatus*[biggerCount];
+            for (int i = 0; i < biggerCount; i++) bigger[i] = NULL;
+            for (int i = 0; i < bucketCount; i++) {
+                while (keptStatus[i] != NULL) {
+                    KeptStatus* moving = keptStatus[i];
+                    keptStatus[i] = moving->next;
+                    moving->next = bigger[moving->node->sequence % biggerCount];
+                    bigger[moving->node->sequence % biggerCount] = moving;
+                }
+            }
+            delete[] keptStatus;
+            keptStatus = bigger;
+            bucketCount = biggerCount;
+        }
+        KeptStatus* kept = new KeptStatus;
+        kept->node = node;
+        kept->status = status;
+        kept->next = keptStatus[node->sequence % bucketCount];
+        keptStatus[node->sequence % bucketCount] = kept;
+        keptCount++;
+    }
+
+private:
+    OnlineSnapshot(const OnlineSnapshot&);
+    OnlineSnapshot& operator=(const OnlineSnapshot&);
+};
+
+
+// Per-connection login state in server mode
+struct ServerSession
+{
+    string role;       // "", "STUDENT", "STAFF" or "ADMIN"
+    string userID;
+    string department; // staff only
+    bool closing;
+
+    ServerSession() : role(""), userID(""), department(""), closing(false) {}
+};
+
+
+// One row of a batch decision, see InternshipSystem::applyDecisionBatch()
+struct ApplicationDecision
+{
+    string studentID;
+    string jobID;
+    string status;
+};
+
+
+// Heap held by one kind of record or index, see InternshipSystem::measureMemory()
+struct MemoryUsage
+{
+    const char* category;  // "record" or "index"
+    const char* name;
+    long count;
+    long objectBytes;      // Objects and arrays, as allocator blocks
+    long stringBytes;      // Text of their strings kept outside the objects
+};
+
+const int MAX_MEMORY_ROWS = 16;
+
+struct MemoryReport
+{
+    MemoryUsage rows[MAX_MEMORY_ROWS];
+    int rowCount;
+    AllocatorStats allocator;
+    ProcessMemory process;
+
+    MemoryReport() : rowCount(0) {}
+
+    MemoryUsage& add(const char* category, const char* name, long count)
+    {
+        MemoryUsage& row = rows[rowCount++];
+        row.category = category;
+        row.name = name;
+        row.count = count;
+        row.objectBytes = 0;
+        row.stringBytes = 0;
+        return row;
+    }
+
+    long totalBytes() const
+    {
+        long total = 0;
+        for (int i = 0; i < rowCount; i++) total += rows[i].objectBytes + rows[i].stringBytes;
+        return total;
+    }
+};
+
+
+// Health score with the reason for every deduction
+const int MAX_HEALTH_FINDINGS = 12;
+
+struct HealthCheck
+{
+    int score;
+    int findingCount;
+    int points[MAX_HEALTH_FINDINGS];
+    string findings[MAX_HEALTH_FINDINGS];
+
+    HealthCheck() : score(100), findingCount(0) {}
+
+    void deduct(int lost, const string& reason)
+    {
+        score -= lost;
+        if (findingCount < MAX_HEALTH_FINDINGS) {
+            points[findingCount] = lost;
+            findings[findingCount++] = reason;
+        }
+    }
+};
+
+
+// Timings of one benchmark: every run of the same operation
+struct BenchmarkResult
+{
+    const char* name;
+    const char* group;
+    long operations;                           // Operations per run
+    long found;                                // Records the last run found; uses every lookup's result
+    int runs;
+    long long nanoseconds[MAX_BENCHMARK_ROUNDS];
+
+    BenchmarkResult() : name(""), group(""), operations(1), found(0), runs(0) {}
+
+    long long fastest() const
+    {
+        long long best = runs > 0 ? nanoseconds[0] : 0;
+        for (int i = 1; i < runs; i++) if (nanoseconds[i] < best) best = nanoseconds[i];
+        return best;
+    }
+
+    long long slowest() const
+    {
+        long long worst = 0;
+        for (int i = 0; i < runs; i++) if (nanoseconds[i] > worst) worst = nanoseconds[i];
+        return worst;
+    }
+
+    double mean() const
+    {
+        long long total = 0;
+        for (int i = 0; i < runs; i++) total += nanoseconds[i];
+        return runs > 0 ? (double)total / runs : 0.0;
+    }
+
+    double median() const
+    {
+        if (runs == 0) return 0.0;
+        long long sorted[MAX_BENCHMARK_ROUNDS];
+        for (int i = 0; i < runs; i++) sorted[i] = nanoseconds[i];
+        sequentialStableSort(sorted, runs, lessNanoseconds);
+        return runs % 2 ? (double)sorted[runs / 2] : (sorted[runs / 2 - 1] + sorted[runs / 2]) / 2.0;
+    }
+
+    static bool lessNanoseconds(const long long& a, const long long& b) { return a < b; }
+};
+
+
+// Keys the lookup benchmarks search for and the record order every sort
+// starts from, taken once the data is loaded
+struct BenchmarkSample
+{
+    string* studentIDs;
+    string* jobIDs;
+    string* applicationStudents;
+    string* applicationJobs;
+    int keyCount;
+    int applicationKeyCount;
+    Student** studentOrder;
+    InternshipJob* jobOrder[MAX_JOBS];
+
+    BenchmarkSample() : studentIDs(NULL), jobIDs(NULL), applicationStudents(NULL), applicationJobs(NULL),
+                        keyCount(0), applicationKeyCount(0), studentOrder(NULL) {}
+
+    ~BenchmarkSample()
+    {
+        delete[] studentIDs;
+        delete[] jobIDs;
+        delete[] applicationStudents;
+        delete[] applicationJobs;
+        delete[] studentOrder;
+    }
+
+private:
+    BenchmarkSample(const BenchmarkSample&);
+    BenchmarkSample& operator=(const BenchmarkSample&);
+};
+
+
+// Main System class
+class InternshipSystem
+{
+private:
+    InternshipJob* jobs[50];
     int jobCount;
     Staff* currentStaff;
     Admin* currentAdmin;  // Add this member variable
 
     // Replace with raw arrays
-    Student* students[MAX_STUDENTS];
+    Student** students;     // grows with reserveStudents()
+    int studentCapacity;
     Admin* admins[MAX_STUDENTS];
     Staff* staffMembers[MAX_STAFF];
 
@@ -444,6 +1746,89 @@ private:
 
     ApplicationList* applications;
     StudentHashTable* studentHash;
+    JobHashTable* jobHash;
+    DeadlineIndex* deadlineIndex;
+    JobCatalog* jobCatalog;
+    TaskScheduler* scheduler;
+    bool applicationsLoaded;
+
+    // Pending applications per department, see getReviewQueue()
+    ReviewQueue* reviewQueues[MAX_STAFF];
+    int reviewQueueCount;
+
+    // Per-department application counters, see getDepartmentStats()
+    DepartmentStats* departmentStats[MAX_STAFF];
+    int departmentStatsCount;
+    int decisionLogRows;
+    bool decisionLogTorn;   // The log ends in a batch without its COMMIT line
+
+    // Crash-safe replacement of the data files, see DurableSaver
+    DurableSaver saver;
+
+    // Report names handed out in the current second, see reportFileBase()
+    Mutex reportNameMutex;
+    string reportNameStamp;
+    int reportNameUses;
+
+    // Cross-tab counts over applications, see getApplicationCube()
+    ApplicationCube* applicationCube;
+    bool applicationCubeStale;
+    void applicationCubeValues(const ApplicationNode* node, string* values);
+
+    // Applications per job with their best candidates, see getJobApplicants()
+    JobApplicantIndex* jobApplicants;
+    bool jobApplicantsStale;
+    RankedCandidate scoreCandidate(ApplicationNode* node, const CandidateRanking& ranking);
+
+    void reserveStudents(int needed);
+
+    // Server mode: request handlers that only read take it shared, handlers
+    // that change a store or index take it exclusive
+    ReadWriteLock systemLock;
+
+    // One data file of a backup, chunked into the store as a scheduler task
+    struct BackupPart
+    {
+        InternshipSystem* system;
+        OnlineSnapshot* snapshot;
+        ChunkStore* store;
+        DataFileKind kind;
+        string filename;
+        string manifest;
+        long long bytes;
+        long long newBytes;
+        int chunks;
+        int newChunks;
+        string error;
+    };
+    static void writeBackupPart(void* argument);
+
+    // Online backups: at most one frozen view at a time, written by the
+    // caller or by backupThread; see OnlineSnapshot
+    OnlineSnapshot* onlineSnapshot;
+    Mutex snapshotMutex;
+    WorkerThread backupThread;
+    static string newSnapshotID();
+    OnlineSnapshot* freezeSnapshot(const string& snapshotID);
+    string writeSnapshot(OnlineSnapshot* snapshot);
+    bool renderSnapshotBatch(OnlineSnapshot* snapshot, DataFileKind kind, string& text, int limit);
+    void beforeStoreChange(DataFileKind kind);
+    void beforeAllStoresChange();
+    void storeApplicationStatus(ApplicationNode* node, const string& status);
+    static void runBackgroundBackup(void* argument);
+
+    // One chunk of a restore, read and expanded as a scheduler task
+    struct RestoreChunk
+    {
+        ChunkStore* store;
+        string hash;
+        long long size;
+        string data;
+        bool ok;
+    };
+    static void readRestoreChunk(void* argument);
+    void writeRestoreBatch(RestoreChunk* batch, int count, bool parallel, FILE* output, Sha256& fileHash,
+                           long long& fileBytes);
 
 public:
     InternshipSystem(); // Single constructor declaration
@@ -457,30 +1842,100 @@ public:
 
     // File operations
     void loadStudentsFromFile();
-    void saveStudentsToFile();
+    bool saveStudentsToFile();
     void loadJobsFromFile();
-    void saveJobsToFile();
+    bool saveJobsToFile();
     void loadApplicationsFromFile();
-    void saveApplicationsToFile();
+    bool saveApplicationsToFile();
     void loadStaffFromFile();
-    void saveStaffToFile();
+    bool saveStaffToFile();
     void loadAdminsFromFile();
-    void saveAdminsToFile();
+    bool saveAdminsToFile();
+
+    // Startup loading: all five data files at once, see loadSystemData()
+    int loadSystemData();
+    int mergeLoadedStudents(DataFile& file);
+    int mergeLoadedStaff(DataFile& file);
+    int mergeLoadedAdmins(DataFile& file);
+    int mergeLoadedJobs(DataFile& file);
+    int mergeLoadedApplications(DataFile& file);
+    void ensureApplicationsLoaded();
+
+    // Application store
+    ApplicationNode* submitApplication(const string& studentID, const string& jobID);
+    ApplicationNode* addApplication(const string& studentID, const string& jobID, const string& jobTitle,
+                                    const string& company, const string& status);
+    void setApplicationStatus(ApplicationNode* node, const string& status);
+
+    // Staff review queues and the application decision log
+    ReviewQueue* getReviewQueue(const string& department);
+    DepartmentStats* getDepartmentStats(const string& department);
+    DepartmentStats* findDepartmentStats(const string& department) const;
+    void rebuildDepartmentIndexes();
+    void departmentDashboard(const string& department);
+
+    // Application cube: roll-ups and slices by diploma, company, status and month
+    ApplicationCube* getApplicationCube();
+    void invalidateApplicationCube() { applicationCubeStale = true; }
+    void showApplicationCube(const CubeQuery& query);
+    void applicationCubeMenu();
+
+    // Applications joined to their students and jobs, filtered and projected
+    long runApplicantQuery(const ApplicantQuery& query, ReportWriter& writer);
+    void applicantQueryMenu();
+    static const string& joinedText(int field, const ApplicationNode* node, const Student* student,
+                                    const InternshipJob* job);
+
+    // Best applicants of a job by CGPA and skills, kept current as applications arrive
+    JobApplicantIndex* getJobApplicants();
+    void invalidateCandidateRankings() { if (jobApplicants != NULL) jobApplicants->dropRankings(); }
+    int rankCandidates(const string& jobID, int k, RankedCandidate* out);
+    void showCandidateRanking(const string& jobID, int k);
+    void candidateRankingMenu();
+
+    void commitDecisions(ApplicationNode** nodes, const string* statuses, int count);
+    void replayDecisionLog();
+    void compactDecisionLog();
+
+    // Batch decisions - all rows or none, one durable commit
+    int applyDecisionBatch(const ApplicationDecision* decisions, int count);
+    int applyDecisionRule(const string& jobID, const string& newStatus, float minCGPA);
+    int applyDecisionFile(const string& filename);
+    void batchDecisionMenu();
+
+    // Command mode - menu operations run from the command line or a script
+    string runCommand(const string& line);
+    int runCommandScript(istream& script, bool quiet, bool stopOnError, ReportWriter* results);
+
+    // Server mode - line protocol over a Unix domain socket
+    string handleRequest(ServerSession& session, const string& line);
+    void runServer(const string& socketPath, int threadCount);
+
+    // Bulk import of partner application files (CSV or pipe separated)
+    ImportResult importApplications(const string& filename);
+    void bulkImportMenu();
 
     // System operations
-    void studentMenu();
+    void studentMenu(Student* student);
     void adminMenu();
 
     // Sorting algorithms
     void selectionSortStudentsByCGPA();
     void selectionSortStudentsByID();
     void bubbleSortJobsByDeadline();
-    void mergeSortJobsByCompany(int low, int high);
-    void mergeJobsByCompany(int low, int mid, int high);
+    void mergeSortJobsByCompany();
 
     // Searching algorithms
     int binarySearchStudentByID(string targetID);
     Student* hashSearchStudent(string studentID);
+    InternshipJob* hashSearchJob(const string& jobID);
+
+    // Deadline calendar
+    void rebuildDeadlineIndex();
+    void refreshJobDeadline(InternshipJob* job);
+    int sweepExpiredJobs();
+    void publishJobCatalog();
+    void displayJobsClosingWithin(int days);
     int linearSearchJobByTitle(string title);
     int fibonacciSearchStudentByID(string targetID);
     int interpolationSearchStudentByCGPA(float targetCGPA);
@@ -502,13 +1957,20 @@ public:
     bool validatePassword(string password);
 
     // Backup and restore functions
-    void backupSystemData();
-    void restoreSystemData(string backupTimestamp);
+    string backupSystemData();
+    string startBackgroundBackup(const string& snapshotID);
+    bool restoreSystemData(string snapshotID, bool parallel = true);
+    void listBackups();
+    void backupMenu();
     string getCurrentTimestamp();
+    string reportFileBase(const string& prefix);
 
     // Reporting functions
-    void generateDetailedReport();
-    void generateStudentPerformanceReport();
+    bool generateDetailedReport(ReportFormat format = REPORT_TEXT);
+    bool generateStudentPerformanceReport(ReportFormat format = REPORT_TEXT);
+    bool exportStudents(ReportFormat format);
+    bool exportApplications(ReportFormat format);
+    void reportsMenu(Admin* admin);
 
     // Search and filter functions
     void searchStudentsByDiploma(string diploma);
@@ -518,19 +1980,42 @@ public:
     // System optimization and maintenance
     void optimizeHashTable();
     void defragmentData();
+    void measureMemory(MemoryReport& report);
+    void checkSystemHealth(const MemoryReport& report, HealthCheck& health);
     int calculateSystemHealth();
-    void runSystemDiagnostics();
+    bool runSystemDiagnostics(ReportFormat format = REPORT_TEXT, const string& dumpBase = "");
+    void writeDiagnostics(ReportWriter& writer, const MemoryReport& report, const HealthCheck& health);
+
+    // Benchmark suite over the loaded data, see runBenchmarkSuite()
+    bool runBenchmarkSuite(const string& resultsFile, int rounds);
+    void takeBenchmarkSample(BenchmarkSample& sample);
+    void restoreBenchmarkOrder(const BenchmarkSample& sample);
+    long runBenchmarkStep(int step, const BenchmarkSample& sample, long& found);
 
     // Additional sorting functions
     void insertionSortStudentsByName();
     void bubbleSortJobsByTitle();
 
+    // Stable sorts of the student and job arrays, parallel for large sets
+    typedef bool (*StudentOrder)(Student* const& a, Student* const& b);
+    typedef bool (*JobOrder)(InternshipJob* const& a, InternshipJob* const& b);
+    void sortStudents(StudentOrder less);
+    void sortJobs(JobOrder less);
+
+    static bool studentHasHigherCGPA(Student* const& a, Student* const& b);
+    static bool studentHasLowerID(Student* const& a, Student* const& b);
+    static bool studentNameBefore(Student* const& a, Student* const& b);
+    static bool jobDeadlineBefore(InternshipJob* const& a, InternshipJob* const& b);
+    static bool jobTitleBefore(InternshipJob* const& a, InternshipJob* const& b);
+    static bool jobCompanyBefore(InternshipJob* const& a, InternshipJob* const& b);
+
+    friend class Student;
     friend class Admin;
     friend class Staff;
-    friend void saveStudentToFile(Student& student, ostream& file);
-    friend void saveAdminToFile(Admin& admin, ostream& file);
-    friend void saveStaffToFile(Staff& staff, ostream& file);
-    friend void saveJobToFile(InternshipJob& job, ostream& file);
+    friend void saveStudentToFile(Student& student, OutputBuffer& file);
+    friend void saveAdminToFile(Admin& admin, OutputBuffer& file);
+    friend void saveStaffToFile(Staff& staff, OutputBuffer& file);
+    friend void saveJobToFile(InternshipJob& job, OutputBuffer& file);
     friend void saveSystemData(InternshipSystem& system);
     friend void loadSystemData(InternshipSystem& system);
 
@@ -552,21 +2037,83 @@ int Staff::totalStaff = 0;
 
 
 // Implementation of ApplicationList methods
-void ApplicationList::insert(string studentID, string jobID, string jobTitle, string company, string status) 
+int ApplicationList::bucketFor(const string& studentID, const string& jobID) const
+{
+    unsigned int hash = 5381;
+    for (size_t i = 0; i < studentID.length(); i++) hash = hash * 33 + (unsigned char)studentID[i];
+    hash = hash * 33 + '|';
+    for (size_t i = 0; i < jobID.length(); i++) hash = hash * 33 + (unsigned char)jobID[i];
+    return (int)(hash % (unsigned int)bucketCount);
+}
+
+
+void ApplicationList::rehash(int newBucketCount)
+{
+    delete[] buckets;
+    bucketCount = newBucketCount;
+    buckets = new ApplicationNode*[bucketCount];
+    for (int i = 0; i < bucketCount; i++) buckets[i] = NULL;
+
+    for (ApplicationNode* current = head; current != NULL; current = current->next) {
+        int index = bucketFor(current->studentID, current->jobID);
+        current->nextInBucket = buckets[index];
+        buckets[index] = current;
+    }
+}
+
+
+// Most applications sharing one bucket; search() walks at most this many
+int ApplicationList::longestChain() const
+{
+    int longest = 0;
+    for (int i = 0; i < bucketCount; i++) {
+        int length = 0;
+        for (ApplicationNode* node = buckets[i]; node != NULL; node = node->nextInBucket) length++;
+        if (length > longest) longest = length;
+    }
+    return longest;
+}
+
+
+ApplicationNode* ApplicationList::insert(string studentID, string jobID, string jobTitle, string company, string status) 
+{
+    return append(new ApplicationNode(studentID, jobID, jobTitle, company, status));
+}
+
+
+// Adds a node built elsewhere (e.g. by the startup loader); the list takes ownership
+ApplicationNode* ApplicationList::append(ApplicationNode* newNode)
 {
-    ApplicationNode* newNode = new ApplicationNode(studentID, jobID, jobTitle, company, status);
+    newNode->sequence = nextSequence++;
+    newNode->next = NULL;
+
+    // Append through the tail pointer instead of walking the list
     if (head == NULL) 
 	{
         head = newNode;
     } else {
-        ApplicationNode* current = head;
-        while (current->next != NULL) 
-        {
-            current = current->next;
-        }
-        current->next = newNode;
+        tail->next = newNode;
     }
+    tail = newNode;
     count++;
+
+    if (count > bucketCount * 2) {
+        rehash(bucketCount * 4); // Also links the new node
+    } else {
+        int index = bucketFor(newNode->studentID, newNode->jobID);
+        newNode->nextInBucket = buckets[index];
+        buckets[index] = newNode;
+    }
+    return newNode;
+}
+
+
+// Sizes the hash index up front for a bulk load of expectedCount nodes
+void ApplicationList::reserve(int expectedCount)
+{
+    int wanted = bucketCount;
+    while (expectedCount > wanted * 2) wanted *= 4;
+    if (wanted != bucketCount) rehash(wanted);
 }
 
 
@@ -574,24 +2121,25 @@ void ApplicationList::insert(string studentID, string jobID, string jobTitle, st
 void ApplicationList::display() 
 {
 
-    cout << "\n=== All Applications ===" << endl;
-    cout << left << setw(12) << "Student ID" 
-         << setw(8) << "Job ID" 
-         << setw(25) << "Job Title" 
-         << setw(20) << "Company" 
-         << setw(12) << "Status" << endl;
-    cout << string(77, '-') << endl;
+    OutputBuffer out(cout);
+    out.put("\n=== All Applications ===\n");
+    out.padded("Student ID", 12)
+       .padded("Job ID", 8)
+       .padded("Job Title", 25)
+       .padded("Company", 20)
+       .padded("Status", 12).put('\n');
+    out.repeat('-', 77).put('\n');
 
     
 
     ApplicationNode* current = head;
     while (current != NULL) 
 	{
-        cout << left << setw(12) << current->studentID
-             << setw(8) << current->jobID
-             << setw(25) << current->jobTitle
-             << setw(20) << current->company
-             << setw(12) << current->status << endl;
+        out.padded(current->studentID, 12)
+           .padded(current->jobID, 8)
+           .padded(current->jobTitle, 25)
+           .padded(current->company, 20)
+           .padded(current->status, 12).put('\n');
         current = current->next;
     }
 }
@@ -606,53 +2154,63 @@ void ApplicationList::clear()
         head = head->next;
         delete temp;
     }
+    tail = NULL;
     count = 0;
+    nextSequence = 0;
+    for (int i = 0; i < bucketCount; i++) buckets[i] = NULL;
 }
 
 
 
 bool ApplicationList::search(string studentID, string jobID) 
 {
-    ApplicationNode* current = head;
+    return find(studentID, jobID) != NULL;
+}
+
+
+ApplicationNode* ApplicationList::find(const string& studentID, const string& jobID) const
+{
+    ApplicationNode* current = buckets[bucketFor(studentID, jobID)];
     while (current != NULL) 
 	{
         if (current->studentID == studentID && current->jobID == jobID) 
         {
-            return true;
+            return current;
         }
-        current = current->next;
+        current = current->nextInBucket;
     }
-    return false;
+    return NULL;
 }
 
 
-void ApplicationList::saveToFile(const string& filename) 
+// One line per application in the applications.txt format
+void ApplicationList::writeTo(OutputBuffer& out) const
 {
-    try {
-        ofstream file(filename.c_str());
-        if (!file.is_open()) 
-        {
-            throw FileException("Cannot open file for writing: " + filename);
-        }
-        
+    for (ApplicationNode* current = head; current != NULL; current = current->next) {
+        writeLine(out, current, current->status);
+    }
+}
 
-        ApplicationNode* current = head;
-        while (current != NULL) 
-        {
-            file << current->studentID << "|" << current->jobID << "|"
-                 << current->jobTitle << "|" << current->company << "|"
-                 << current->status << endl;
-            current = current->next;
-        }
 
-        file.close();
+void ApplicationList::writeLine(OutputBuffer& out, const ApplicationNode* node, const string& status)
+{
+    out.put(node->studentID).put('|').put(node->jobID).put('|')
+       .put(node->jobTitle).put('|').put(node->company).put('|')
+       .put(status).put('\n');
+}
 
-    } catch (const FileException& e) 
 
+// Builds the whole file in memory and hands it to the saver in one write
+void ApplicationList::saveToFile(const string& filename, DurableSaver& saver) 
+{
+    ostringstream file;
     {
-        cout << "Error: " << e.what() << endl;
+        OutputBuffer out(file);
+        writeTo(out);
+    }
+    if (!saver.save(filename, file.str())) {
+        throw FileException("Cannot write file: " + filename);
     }
-
 }
 
 
@@ -697,46 +2255,600 @@ void ApplicationList::loadFromFile(const string& filename)
 
 
 
-// Implementation of Person methods
-void Person::setInfo(string id) 
+// Implementation of ReviewQueue methods
+ReviewQueue::ReviewQueue(const string& department)
+    : department(department), size(0), capacity(16)
 {
-    this->id = id;
+    heap = new ApplicationNode*[capacity];
 }
 
 
-void Person::setInfo(string id, string name) 
+void ReviewQueue::siftUp(int index)
 {
-    this->id = id;
-    this->name = name;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap[parent]->sequence <= heap[index]->sequence) break;
+        ApplicationNode* temp = heap[parent];
+        heap[parent] = heap[index];
+        heap[index] = temp;
+        index = parent;
+    }
 }
 
-void Person::setInfo(string id, string name, string email) 
+
+void ReviewQueue::siftDown(int index)
 {
-    this->id = id;
-    this->name = name;
-    this->email = email;
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < size && heap[left]->sequence < heap[smallest]->sequence) smallest = left;
+        if (right < size && heap[right]->sequence < heap[smallest]->sequence) smallest = right;
+        if (smallest == index) break;
+        ApplicationNode* temp = heap[smallest];
+        heap[smallest] = heap[index];
+        heap[index] = temp;
+        index = smallest;
+    }
 }
 
 
-
-// Implementation of Student methods
-void Student::displayInfo() 
+void ReviewQueue::push(ApplicationNode* node)
 {
-    cout << "\n=== Student Information ===" << endl;
-    cout << "ID: " << id << endl;
-    cout << "Name: " << name << endl;
-    cout << "Email: " << email << endl;
-    cout << "CGPA: " << fixed << setprecision(2) << cgpa << endl;
-    cout << "Diploma: " << diploma << endl;
-    cout << "Skills: " << skills << endl;
+    if (size == capacity) {
+        ApplicationNode** bigger = new ApplicationNode*[capacity * 2];
+        for (int i = 0; i < size; i++) bigger[i] = heap[i];
+        delete[] heap;
+        heap = bigger;
+        capacity *= 2;
+    }
+    heap[size] = node;
+    siftUp(size);
+    size++;
 }
 
-bool Student::login() 
+
+// Removes and returns the oldest application that is still Pending, or NULL.
+// Sequences are unique, so a second entry for the same node is the next top.
+ApplicationNode* ReviewQueue::popPending()
+{
+    while (size > 0) {
+        ApplicationNode* top = heap[0];
+        do {
+            heap[0] = heap[--size];
+            siftDown(0);
+        } while (size > 0 && heap[0] == top);
+        if (top->status == "Pending") return top;
+    }
+    return NULL;
+}
+
+
+
+// Implementation of DepartmentStats methods
+DepartmentStats::DepartmentStats(const string& department)
+    : department(department), jobCount(0), jobCapacity(8)
+{
+    jobs = new JobStatusCounts[jobCapacity];
+    clear();
+}
+
+
+void DepartmentStats::clear()
+{
+    overall.jobID = "";
+    overall.jobTitle = "";
+    overall.total = overall.pending = overall.approved = overall.rejected = 0;
+    jobCount = 0;
+}
+
+
+long DepartmentStats::memoryBytes() const
+{
+    long bytes = heapBlockBytes(sizeof(DepartmentStats)) + stringHeapBytes(department) +
+                 heapBlockBytes(jobCapacity * sizeof(JobStatusCounts));
+    for (int i = 0; i < jobCount; i++) {
+        bytes += stringHeapBytes(jobs[i].jobID) + stringHeapBytes(jobs[i].jobTitle);
+    }
+    return bytes;
+}
+
+
+void DepartmentStats::adjust(JobStatusCounts& counts, const string& status, int delta)
+{
+    if (status == "Pending") counts.pending += delta;
+    else if (status == "Approved") counts.approved += delta;
+    else if (status == "Rejected") counts.rejected += delta;
+}
+
+
+// A department only has a handful of jobs, so a short scan is enough
+JobStatusCounts* DepartmentStats::findJob(const string& jobID, const string& jobTitle)
+{
+    for (int i = 0; i < jobCount; i++) {
+        if (jobs[i].jobID == jobID) return &jobs[i];
+    }
+    if (jobCount == jobCapacity) {
+        JobStatusCounts* bigger = new JobStatusCounts[jobCapacity * 2];
+        for (int i = 0; i < jobCount; i++) bigger[i] = jobs[i];
+        delete[] jobs;
+        jobs = bigger;
+        jobCapacity *= 2;
+    }
+    JobStatusCounts& counts = jobs[jobCount++];
+    counts.jobID = jobID;
+    counts.jobTitle = jobTitle;
+    counts.total = counts.pending = counts.approved = counts.rejected = 0;
+    return &counts;
+}
+
+
+void DepartmentStats::add(const ApplicationNode* node)
+{
+    JobStatusCounts* job = findJob(node->jobID, node->jobTitle);
+    overall.total++;
+    job->total++;
+    adjust(overall, node->status, 1);
+    adjust(*job, node->status, 1);
+}
+
+
+void DepartmentStats::changeStatus(const ApplicationNode* node, const string& oldStatus, const string& newStatus)
+{
+    JobStatusCounts* job = findJob(node->jobID, node->jobTitle);
+    adjust(overall, oldStatus, -1);
+    adjust(*job, oldStatus, -1);
+    adjust(overall, newStatus, 1);
+    adjust(*job, newStatus, 1);
+}
+
+
+
+// Implementation of JobApplicantIndex methods
+JobApplicantIndex::JobApplicantIndex() : bucketCount(APPLICATION_BUCKETS), jobCount(0)
+{
+    buckets = new JobApplicants*[bucketCount];
+    for (int i = 0; i < bucketCount; i++) buckets[i] = NULL;
+}
+
+
+JobApplicantIndex::~JobApplicantIndex()
+{
+    clear();
+    delete[] buckets;
+}
+
+
+int JobApplicantIndex::bucketFor(const string& jobID) const
+{
+    unsigned int hash = 5381;
+    for (size_t i = 0; i < jobID.length(); i++) hash = hash * 33 + (unsigned char)jobID[i];
+    return (int)(hash % (unsigned int)bucketCount);
+}
+
+
+void JobApplicantIndex::rehash(int newBucketCount)
+{
+    JobApplicants** old = buckets;
+    int oldCount = bucketCount;
+    buckets = new JobApplicants*[newBucketCount];
+    bucketCount = newBucketCount;
+    for (int i = 0; i < bucketCount; i++) buckets[i] = NULL;
+    for (int i = 0; i < oldCount; i++) {
+        JobApplicants* entry = old[i];
+        while (entry != NULL) {
+            JobApplicants* next = entry->next;
+            int bucket = bucketFor(entry->jobID);
+            entry->next = buckets[bucket];
+            buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+    delete[] old;
+}
+
+
+// Files the application under its job and returns the job's entry
+JobApplicants* JobApplicantIndex::add(ApplicationNode* node)
+{
+    JobApplicants* entry = find(node->jobID);
+    if (entry == NULL) {
+        if (jobCount >= bucketCount * 2) rehash(bucketCount * 2);
+        int bucket = bucketFor(node->jobID);
+        entry = new JobApplicants();
+        entry->jobID = node->jobID;
+        entry->capacity = 16;
+        entry->nodes = new ApplicationNode*[entry->capacity];
+        entry->count = 0;
+        entry->ranking = NULL;
+        entry->next = buckets[bucket];
+        buckets[bucket] = entry;
+        jobCount++;
+    }
+    if (entry->count == entry->capacity) {
+        ApplicationNode** bigger = new ApplicationNode*[entry->capacity * 2];
+        for (int i = 0; i < entry->count; i++) bigger[i] = entry->nodes[i];
+        delete[] entry->nodes;
+        entry->nodes = bigger;
+        entry->capacity *= 2;
+    }
+    entry->nodes[entry->count++] = node;
+    return entry;
+}
+
+
+JobApplicants* JobApplicantIndex::find(const string& jobID) const
+{
+    for (JobApplicants* entry = buckets[bucketFor(jobID)]; entry != NULL; entry = entry->next) {
+        if (entry->jobID == jobID) return entry;
+    }
+    return NULL;
+}
+
+
+// Forgets every ranking; used when student or job details change
+void JobApplicantIndex::dropRankings()
+{
+    for (int i = 0; i < bucketCount; i++) {
+        for (JobApplicants* entry = buckets[i]; entry != NULL; entry = entry->next) {
+            dropRanking(entry);
+        }
+    }
+}
+
+
+void JobApplicantIndex::clear()
+{
+    for (int i = 0; i < bucketCount; i++) {
+        JobApplicants* entry = buckets[i];
+        while (entry != NULL) {
+            JobApplicants* next = entry->next;
+            dropRanking(entry);
+            delete[] entry->nodes;
+            delete entry;
+            entry = next;
+        }
+        buckets[i] = NULL;
+    }
+    jobCount = 0;
+}
+
+
+long JobApplicantIndex::memoryBytes() const
+{
+    long bytes = heapBlockBytes(sizeof(JobApplicantIndex)) + heapBlockBytes(bucketCount * sizeof(JobApplicants*));
+    for (int i = 0; i < bucketCount; i++) {
+        for (JobApplicants* entry = buckets[i]; entry != NULL; entry = entry->next) {
+            bytes += heapBlockBytes(sizeof(JobApplicants)) + stringHeapBytes(entry->jobID) +
+                     heapBlockBytes(entry->capacity * sizeof(ApplicationNode*));
+            if (entry->ranking != NULL) {
+                bytes += heapBlockBytes(sizeof(CandidateRanking));
+                for (int r = 0; r < entry->ranking->requirementCount; r++) {
+                    bytes += stringHeapBytes(entry->ranking->requirements[r]);
+                }
+            }
+        }
+    }
+    return bytes;
+}
+
+
+
+// Implementation of CubeDictionary methods
+CubeDictionary::CubeDictionary() : count(0), capacity(8), slotCount(16)
+{
+    values = new string[capacity];
+    slots = new int[slotCount];
+    for (int i = 0; i < slotCount; i++) slots[i] = -1;
+}
+
+
+CubeDictionary::~CubeDictionary()
+{
+    delete[] values;
+    delete[] slots;
+}
+
+
+// Heap of the arrays and values only; the dictionary lives inside its cube
+long CubeDictionary::memoryBytes() const
+{
+    long bytes = heapBlockBytes(capacity * sizeof(string)) + heapBlockBytes(slotCount * sizeof(int));
+    for (int i = 0; i < count; i++) bytes += stringHeapBytes(values[i]);
+    return bytes;
+}
+
+
+int CubeDictionary::slotFor(const string& value) const
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < value.length(); i++) {
+        hash = (hash ^ (unsigned char)value[i]) * 16777619u;
+    }
+    int slot = (int)(hash % (unsigned int)slotCount);
+    while (slots[slot] != -1 && values[slots[slot]] != value) {
+        slot = (slot + 1) % slotCount;
+    }
+    return slot;
+}
+
+
+void CubeDictionary::grow()
+{
+    string* bigger = new string[capacity * 2];
+    for (int i = 0; i < count; i++) bigger[i] = values[i];
+    delete[] values;
+    values = bigger;
+    capacity *= 2;
+
+    delete[] slots;
+    slotCount = capacity * 2;
+    slots = new int[slotCount];
+    for (int i = 0; i < slotCount; i++) slots[i] = -1;
+    for (int i = 0; i < count; i++) slots[slotFor(values[i])] = i;
+}
+
+
+int CubeDictionary::lookup(const string& value) const
+{
+    int id = slots[slotFor(value)];
+    return id == -1 ? CUBE_ANY : id;
+}
+
+
+int CubeDictionary::intern(const string& value)
+{
+    int slot = slotFor(value);
+    if (slots[slot] != -1) return slots[slot];
+    if (count == capacity) {
+        grow();
+        slot = slotFor(value);
+    }
+    values[count] = value;
+    slots[slot] = count;
+    return count++;
+}
+
+
+void CubeDictionary::clear()
+{
+    count = 0;
+    for (int i = 0; i < slotCount; i++) slots[i] = -1;
+}
+
+
+
+// Implementation of ApplicationCube methods
+ApplicationCube::ApplicationCube()
+{
+    for (int mask = 0; mask < CUBE_CUBOIDS; mask++) {
+        Cuboid& cuboid = cuboids[mask];
+        cuboid.cellCount = 0;
+        cuboid.cellCapacity = 8;
+        cuboid.cells = new CubeCell[cuboid.cellCapacity];
+        cuboid.slotCount = 16;
+        cuboid.slots = new int[cuboid.slotCount];
+        for (int i = 0; i < cuboid.slotCount; i++) cuboid.slots[i] = -1;
+    }
+}
+
+
+ApplicationCube::~ApplicationCube()
+{
+    for (int mask = 0; mask < CUBE_CUBOIDS; mask++) {
+        delete[] cuboids[mask].cells;
+        delete[] cuboids[mask].slots;
+    }
+}
+
+
+long ApplicationCube::memoryBytes() const
+{
+    long bytes = heapBlockBytes(sizeof(ApplicationCube));
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) bytes += dictionaries[d].memoryBytes();
+    for (int mask = 0; mask < CUBE_CUBOIDS; mask++) {
+        bytes += heapBlockBytes(cuboids[mask].cellCapacity * sizeof(CubeCell)) +
+                 heapBlockBytes(cuboids[mask].slotCount * sizeof(int));
+    }
+    return bytes;
+}
+
+
+unsigned int ApplicationCube::hashKey(const int* key)
+{
+    unsigned int hash = 17;
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        hash = hash * 31 + (unsigned int)key[d];
+    }
+    return hash ^ (hash >> 15);
+}
+
+
+bool ApplicationCube::sameKey(const int* a, const int* b)
+{
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (a[d] != b[d]) return false;
+    }
+    return true;
+}
+
+
+void ApplicationCube::growCuboid(Cuboid& cuboid)
+{
+    CubeCell* bigger = new CubeCell[cuboid.cellCapacity * 2];
+    for (int i = 0; i < cuboid.cellCount; i++) bigger[i] = cuboid.cells[i];
+    delete[] cuboid.cells;
+    cuboid.cells = bigger;
+    cuboid.cellCapacity *= 2;
+
+    delete[] cuboid.slots;
+    cuboid.slotCount = cuboid.cellCapacity * 2;
+    cuboid.slots = new int[cuboid.slotCount];
+    for (int i = 0; i < cuboid.slotCount; i++) cuboid.slots[i] = -1;
+    for (int i = 0; i < cuboid.cellCount; i++) {
+        int slot = (int)(hashKey(cuboid.cells[i].key) % (unsigned int)cuboid.slotCount);
+        while (cuboid.slots[slot] != -1) slot = (slot + 1) % cuboid.slotCount;
+        cuboid.slots[slot] = i;
+    }
+}
+
+
+CubeCell* ApplicationCube::findCell(const Cuboid& cuboid, const int* key)
+{
+    int slot = (int)(hashKey(key) % (unsigned int)cuboid.slotCount);
+    while (cuboid.slots[slot] != -1) {
+        CubeCell* cell = &cuboid.cells[cuboid.slots[slot]];
+        if (sameKey(cell->key, key)) return cell;
+        slot = (slot + 1) % cuboid.slotCount;
+    }
+    return NULL;
+}
+
+
+CubeCell* ApplicationCube::findOrAddCell(Cuboid& cuboid, const int* key)
+{
+    CubeCell* cell = findCell(cuboid, key);
+    if (cell != NULL) return cell;
+
+    if (cuboid.cellCount == cuboid.cellCapacity) growCuboid(cuboid);
+    int slot = (int)(hashKey(key) % (unsigned int)cuboid.slotCount);
+    while (cuboid.slots[slot] != -1) slot = (slot + 1) % cuboid.slotCount;
+    cuboid.slots[slot] = cuboid.cellCount;
+
+    cell = &cuboid.cells[cuboid.cellCount++];
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) cell->key[d] = key[d];
+    cell->count = 0;
+    return cell;
+}
+
+
+// Adds delta to the matching cell of every cuboid
+void ApplicationCube::adjust(const int* coordinates, long delta)
+{
+    for (int mask = 0; mask < CUBE_CUBOIDS; mask++) {
+        int key[CUBE_DIMENSIONS];
+        for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+            key[d] = (mask & (1 << d)) ? coordinates[d] : 0;
+        }
+        findOrAddCell(cuboids[mask], key)->count += delta;
+    }
+}
+
+
+void ApplicationCube::add(const string* values)
+{
+    int coordinates[CUBE_DIMENSIONS];
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        coordinates[d] = dictionaries[d].intern(values[d]);
+    }
+    adjust(coordinates, 1);
+}
+
+
+void ApplicationCube::changeStatus(const string* values, const string& newStatus)
+{
+    int coordinates[CUBE_DIMENSIONS];
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        coordinates[d] = dictionaries[d].intern(values[d]);
+    }
+    adjust(coordinates, -1);
+    coordinates[CUBE_STATUS] = dictionaries[CUBE_STATUS].intern(newStatus);
+    adjust(coordinates, 1);
+}
+
+
+void ApplicationCube::clear()
+{
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) dictionaries[d].clear();
+    for (int mask = 0; mask < CUBE_CUBOIDS; mask++) {
+        Cuboid& cuboid = cuboids[mask];
+        cuboid.cellCount = 0;
+        for (int i = 0; i < cuboid.slotCount; i++) cuboid.slots[i] = -1;
+    }
+}
+
+
+long ApplicationCube::count(const int* slice) const
+{
+    int mask = 0;
+    int key[CUBE_DIMENSIONS];
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        key[d] = (slice[d] == CUBE_ANY) ? 0 : slice[d];
+        if (slice[d] != CUBE_ANY) mask |= 1 << d;
+    }
+    const CubeCell* cell = findCell(cuboids[mask], key);
+    return cell != NULL ? cell->count : 0;
+}
+
+
+// Scans the cuboid of the grouped and sliced dimensions; each cell that
+// matches the slice is one group, so no further aggregation is needed
+int ApplicationCube::select(int groupMask, const int* slice, CubeCell* out, int maxCells) const
+{
+    int mask = groupMask;
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (slice[d] != CUBE_ANY) mask |= 1 << d;
+    }
+
+    const Cuboid& cuboid = cuboids[mask];
+    int found = 0;
+    for (int i = 0; i < cuboid.cellCount; i++) {
+        const CubeCell& cell = cuboid.cells[i];
+        if (cell.count == 0) continue;
+        bool inSlice = true;
+        for (int d = 0; d < CUBE_DIMENSIONS && inSlice; d++) {
+            inSlice = (slice[d] == CUBE_ANY || cell.key[d] == slice[d]);
+        }
+        if (!inSlice) continue;
+        if (found < maxCells) out[found] = cell;
+        found++;
+    }
+    return found;
+}
+
+
+// Implementation of Person methods
+void Person::setInfo(string id) 
+{
+    this->id = id;
+}
+
+
+void Person::setInfo(string id, string name) 
+{
+    this->id = id;
+    this->name = name;
+}
+
+void Person::setInfo(string id, string name, string email) 
+{
+    this->id = id;
+    this->name = name;
+    this->email = email;
+}
+
+
+
+// Implementation of Student methods
+void Student::displayInfo() 
+{
+    cout << "\n=== Student Information ===" << endl;
+    cout << "ID: " << id << endl;
+    cout << "Name: " << name << endl;
+    cout << "Email: " << email << endl;
+    cout << "CGPA: " << fixed << setprecision(2) << cgpa << endl;
+    cout << "Diploma: " << diploma << endl;
+    cout << "Skills: " << skills << endl;
+}
+
+bool Student::login() 
 {
     try {
         string inputID;
         cout << "Enter Student ID: ";
         cin >> inputID;
+        MetricTimer timer(metrics, METRIC_LOGIN);
+        TRACE_SCOPE("login", "Student::login");
         
         ifstream file("students.txt");
         if (!file.is_open()) {
@@ -759,6 +2871,8 @@ bool Student::login()
 
                 file.close();
 
+                id = inputID;
+
                 return true;
 
             }
@@ -773,6 +2887,8 @@ bool Student::login()
 
         cout << "Login Error: " << e.what() << endl;
 
+        metrics.increment(METRIC_LOGIN_FAILURES);
+
         return false;
 
     }
@@ -840,151 +2956,47 @@ void Student::updateProfile(string newEmail, float newCGPA, string newSkills)
 }
 
 
-void Student::viewInternships() 
+// Lists open jobs from the published catalog snapshot, earliest deadline first
+void Student::viewInternships(InternshipSystem* system) 
 {
-    try {
-        ifstream file("job_listings.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open job_listings.txt");
-        }
+    JobCatalogReader catalog(*system->jobCatalog);
+    int first;
+    int end = catalog->openBetween(currentDayNumber(), NO_DEADLINE_DAY, first);
+
+    OutputBuffer out(cout);
+    out.put("\n=== Available Internships ===\n");
+    out.padded("Job ID", 8)
+       .padded("Title", 25)
+       .padded("Company", 20)
+       .padded("Deadline", 12).put('\n');
+    out.repeat('-', 65).put('\n');
+
+    for (int i = first; i < end; i++) {
+        out.padded(catalog->open[i]->jobID, 8)
+           .padded(catalog->open[i]->title, 25)
+           .padded(catalog->open[i]->company, 20)
+           .padded(catalog->open[i]->deadline, 12).put('\n');
+    }
+    out.flush();
+    if (first == end) {
+        cout << "No internships are open right now." << endl;
+    }
+}
 
 
-        cout << "\n=== Available Internships ===" << endl;
-        cout << left << setw(8) << "Job ID" 
-             << setw(25) << "Title" 
-             << setw(20) << "Company" 
-             << setw(12) << "Deadline" << endl;
-        cout << string(65, '-') << endl;
 
-
-        string line;
-
-        while (getline(file, line)) 
-
-        {
-
-            stringstream ss(line);
-            string jobID, title, company, deadline;
-
-            getline(ss, jobID, '|');
-            getline(ss, title, '|');
-            getline(ss, company, '|');
-            getline(ss, deadline, '|');
-
-
-            cout << left << setw(8) << jobID
-                 << setw(25) << title
-                 << setw(20) << company
-                 << setw(12) << deadline << endl;
-        }
-        file.close();
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-    }
-}
-
-
-
-void Student::applyForInternship() 
-
-{
-
-    string jobID;
-
-    cout << "Enter Job ID to apply: ";
-
-    cin >> jobID;
-
-    
+void Student::applyForInternship(InternshipSystem* system) 
+{
+    string jobID;
+    cout << "Enter Job ID to apply: ";
+    cin >> jobID;
 
     try {
-
-        // Check if job exists
-
-        ifstream jobFile("job_listings.txt");
-
-        if (!jobFile.is_open()) {
-
-            throw FileException("Cannot open job_listings.txt");
-
-        }
-
-        
-
-        bool jobFound = false;
-
-        string jobTitle, company;
-
-        string line;
-
-        
-
-        while (getline(jobFile, line)) 
-
-        {
-
-            if (line.find(jobID) == 0) {
-
-                stringstream ss(line);
-
-                string tempID;
-
-                getline(ss, tempID, '|');
-
-                getline(ss, jobTitle, '|');
-
-                getline(ss, company, '|');
-
-                jobFound = true;
-
-                break;
-
-            }
-
-        }
-
-        jobFile.close();
-
-        
-
-        if (!jobFound) {
-
-            throw DataException("Job ID not found");
-
-        }
-
-        
-
-        // Add application
-
-        ofstream appFile("applications.txt", ios::app);
-
-        if (!appFile.is_open()) {
-
-            throw FileException("Cannot open applications.txt for writing");
-
-        }
-
-        
-
-        appFile << id << "|" << jobID << "|" << jobTitle << "|" 
-
-                << company << "|Pending" << endl;
-
-        appFile.close();
-
-        
-
+        system->submitApplication(id, jobID);
         cout << "Application submitted successfully!" << endl;
-
-        
-
     } catch (const exception& e) {
-
         cout << "Error: " << e.what() << endl;
-
     }
-
 }
 
 
@@ -1005,17 +3017,19 @@ void Student::viewMyApplications()
 
         
 
-        cout << "\n=== My Applications ===" << endl;
+        OutputBuffer out(cout);
 
-        cout << left << setw(8) << "Job ID" 
+        out.put("\n=== My Applications ===\n");
 
-             << setw(25) << "Job Title" 
+        out.padded("Job ID", 8)
 
-             << setw(20) << "Company" 
+           .padded("Job Title", 25)
 
-             << setw(12) << "Status" << endl;
+           .padded("Company", 20)
 
-        cout << string(65, '-') << endl;
+           .padded("Status", 12).put('\n');
+
+        out.repeat('-', 65).put('\n');
 
         
 
@@ -1045,13 +3059,13 @@ void Student::viewMyApplications()
 
                 
 
-                cout << left << setw(8) << jobID
+                out.padded(jobID, 8)
 
-                     << setw(25) << jobTitle
+                   .padded(jobTitle, 25)
 
-                     << setw(20) << company
+                   .padded(company, 20)
 
-                     << setw(12) << status << endl;
+                   .padded(status, 12).put('\n');
 
                 hasApplications = true;
 
@@ -1059,7 +3073,7 @@ void Student::viewMyApplications()
 
         }
 
-        
+        out.flush();
 
         if (!hasApplications) {
 
@@ -1081,9 +3095,22 @@ void Student::viewMyApplications()
 
 
 
-void Student::generateSummaryReport() 
+// Columns of student_summary_<id>
+const ReportColumn SUMMARY_COLUMNS[] = {
+    { "student_id", "Student ID", COLUMN_TEXT, 0 },
+    { "total", "Total Applications", COLUMN_INTEGER, 0 },
+    { "approved", "Approved", COLUMN_INTEGER, 0 },
+    { "rejected", "Rejected", COLUMN_INTEGER, 0 },
+    { "pending", "Pending", COLUMN_INTEGER, 0 }
+};
+const ReportTable SUMMARY_TABLE = { "application_summary", "APPLICATION SUMMARY", SUMMARY_COLUMNS, 5, TABLE_RECORD };
+
+
+void Student::generateSummaryReport(ReportFormat format) 
 
 {
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "Student::generateSummaryReport");
 
     try {
 
@@ -1139,25 +3166,35 @@ void Student::generateSummaryReport()
 
         // Save to file
 
-        string filename = "student_summary_" + id + ".txt";
+        ReportOutput summary(format, "student_summary_" + id);
+
+        summary->heading("Application Summary for Student ID: " + id);
+
+        summary->beginTable(SUMMARY_TABLE);
+
+        summary->text(id);
 
-        ofstream summaryFile(filename.c_str());
+        summary->integer(total);
 
-        summaryFile << "Application Summary for Student ID: " << id << "\n";
+        summary->integer(approved);
 
-        summaryFile << "Total Applications: " << total << "\n";
+        summary->integer(rejected);
 
-        summaryFile << "Approved: " << approved << "\n";
+        summary->integer(pending);
 
-        summaryFile << "Rejected: " << rejected << "\n";
+        summary->endRow();
 
-        summaryFile << "Pending: " << pending << "\n";
+        summary->endTable();
 
-        summaryFile.close();
+        if (!summary->finish()) {
+
+            throw FileException("Cannot write student_summary_" + id);
+
+        }
 
         
 
-        cout << "Summary saved to student_summary_" << id << ".txt" << endl;
+        cout << "Summary saved to " << summary->getFiles() << endl;
 
         
 
@@ -1193,6 +3230,8 @@ bool Admin::login()
         cin >> inputID;
         cout << "Enter Password: ";
         cin >> inputPassword;
+        MetricTimer timer(metrics, METRIC_LOGIN);
+        TRACE_SCOPE("login", "Admin::login");
 
         ifstream file("login_admin.txt"); // 
         if (!file.is_open()) 
@@ -1226,6 +3265,7 @@ bool Admin::login()
 
     } catch (const exception& e) {
         cout << "Login Error: " << e.what() << endl;
+        metrics.increment(METRIC_LOGIN_FAILURES);
         return false;
     }
 
@@ -1265,7 +3305,9 @@ void Admin::manageStudents(InternshipSystem* system)
         for (int i = 0; i < system->studentCount; i++) {
             if (system->students[i]->getID() == editID) {
                 cout << "Editing student: " << system->students[i]->getName() << endl;
+                system->beforeStoreChange(STUDENTS_FILE);
                 system->students[i]->updateProfile();
+                system->invalidateCandidateRankings();
                 found = true;
                 break;
             }
@@ -1281,12 +3323,16 @@ void Admin::manageStudents(InternshipSystem* system)
         bool found = false;
         for (int i = 0; i < system->studentCount; i++) {
             if (system->students[i]->getID() == deleteID) {
+                system->beforeStoreChange(STUDENTS_FILE);
+                system->studentHash->remove(deleteID);
                 delete system->students[i];
                 // Shift remaining elements
                 for (int j = i; j < system->studentCount - 1; j++) {
                     system->students[j] = system->students[j + 1];
                 }
                 system->studentCount--;
+                system->invalidateApplicationCube();
+                system->invalidateCandidateRankings();
                 found = true;
                 cout << "Student deleted.\n";
                 break;
@@ -1331,7 +3377,10 @@ void Admin::manageInternships(InternshipSystem* system)
         for (int i = 0; i < system->jobCount; i++) {
             if (system->jobs[i] && system->jobs[i]->getJobID() == editID) {
                 cout << "Editing job: " << system->jobs[i]->getTitle() << endl;
+                system->beforeStoreChange(JOBS_FILE);
                 system->jobs[i]->updateProfile();
+                system->refreshJobDeadline(system->jobs[i]);
+                system->invalidateCandidateRankings();   // Requirements may have changed
                 break;
             }
         }
@@ -1341,11 +3390,17 @@ void Admin::manageInternships(InternshipSystem* system)
         getline(cin, deleteID);
         for (int i = 0; i < system->jobCount; i++) {
             if (system->jobs[i] && system->jobs[i]->getJobID() == deleteID) {
+                system->beforeStoreChange(JOBS_FILE);
+                system->jobHash->remove(deleteID);
+                system->deadlineIndex->remove(system->jobs[i]);
                 delete system->jobs[i];
                 for (int j = i; j < system->jobCount - 1; j++) {
                     system->jobs[j] = system->jobs[j + 1];
                 }
                 system->jobCount--;
+                system->publishJobCatalog();
+                system->invalidateApplicationCube();
+                system->invalidateCandidateRankings();
                 cout << "Job deleted.\n";
                 break;
             }
@@ -1395,6 +3450,7 @@ void Admin::manageStaff(InternshipSystem* system)
         getline(cin, deleteID);
         for (int i = 0; i < system->staffCount; i++) {
             if (system->staffMembers[i] && system->staffMembers[i]->getID() == deleteID) {
+                system->beforeStoreChange(STAFF_FILE);
                 delete system->staffMembers[i];
                 for (int j = i; j < system->staffCount - 1; j++) {
                     system->staffMembers[j] = system->staffMembers[j + 1];
@@ -1420,13 +3476,14 @@ void Admin::viewAllApplications()
         }
 
 
-        cout << "\n=== All Applications ===" << endl;
-        cout << left << setw(12) << "Student ID" 
-             << setw(8) << "Job ID" 
-             << setw(25) << "Job Title" 
-             << setw(20) << "Company" 
-             << setw(12) << "Status" << endl;
-        cout << string(77, '-') << endl;
+        OutputBuffer out(cout);
+        out.put("\n=== All Applications ===\n");
+        out.padded("Student ID", 12)
+           .padded("Job ID", 8)
+           .padded("Job Title", 25)
+           .padded("Company", 20)
+           .padded("Status", 12).put('\n');
+        out.repeat('-', 77).put('\n');
         
 
         string line;
@@ -1442,12 +3499,13 @@ void Admin::viewAllApplications()
             getline(ss, status, '|');
             
 
-            cout << left << setw(12) << studentID
-                 << setw(8) << jobID
-                 << setw(25) << jobTitle
-                 << setw(20) << company
-                 << setw(12) << status << endl;
+            out.padded(studentID, 12)
+               .padded(jobID, 8)
+               .padded(jobTitle, 25)
+               .padded(company, 20)
+               .padded(status, 12).put('\n');
         }
+        out.flush();
         file.close();
     } catch (const FileException& e) 
 
@@ -1489,6 +3547,8 @@ bool Staff::login()
         cin >> inputID;
         cout << "Enter Password: ";
         cin >> inputPassword;
+        MetricTimer timer(metrics, METRIC_LOGIN);
+        TRACE_SCOPE("login", "Staff::login");
 
         ifstream file("staff.txt");
         if (!file.is_open()) 
@@ -1530,138 +3590,232 @@ bool Staff::login()
     } catch (const exception& e) 
 	{
         cout << "Login Error: " << e.what() << endl;
+        metrics.increment(METRIC_LOGIN_FAILURES);
         return false;
     }
 
 }
 
 
+// Pages through the department's review queue. Each page is taken from the
+// queue's heap, so the work per page does not depend on how many
+// applications exist. Decisions are committed per page through
+// InternshipSystem::commitDecisions(); skipped rows go back in the queue.
 void Staff::processApplications(InternshipSystem* system)
 {
-    try {
-        ifstream file("applications.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open applications.txt");
-        }
+    ApplicationNode** skipped = NULL;
+    int skippedCount = 0, skippedCapacity = 0;
+    ReviewQueue* queue = NULL;
 
-        cout << "\n=== Applications to Process ===\n";
-        cout << left << setw(12) << "Student ID"
-             << setw(8) << "Job ID"
-             << setw(25) << "Job Title"
-             << setw(20) << "Company"
-             << setw(12) << "Status" << endl;
-        cout << string(77, '-') << endl;
-
-        //vector<string> linesToUpdate;
-        // Use raw array instead
-        string linesToUpdate[200]; // Max applications
-        int updateCount = 0;
-        
-        string line;
-        while (getline(file, line)) {
-            stringstream ss(line);
-            string studentID, jobID, jobTitle, company, status;
-            getline(ss, studentID, '|');
-            getline(ss, jobID, '|');
-            getline(ss, jobTitle, '|');
-            getline(ss, company, '|');
-            getline(ss, status, '|');
+    try {
+        system->ensureApplicationsLoaded();
+        queue = system->getReviewQueue(department);
+
+        cout << "\n=== Review Queue: " << department << " (" << queue->getSize() << " pending) ===\n";
+
+        bool done = false;
+        while (!done) {
+            ApplicationNode* page[REVIEW_PAGE_SIZE];
+            string decision[REVIEW_PAGE_SIZE];
+            int pageCount = 0;
+            while (pageCount < REVIEW_PAGE_SIZE) {
+                ApplicationNode* node = queue->popPending();
+                if (node == NULL) break;
+                page[pageCount++] = node;
+            }
+            if (pageCount == 0) {
+                cout << "No pending applications to process.\n";
+                break;
+            }
 
-            if (company.find(department) != string::npos && status == "Pending") {
-                cout << left << setw(12) << studentID
-                     << setw(8) << jobID
-                     << setw(25) << jobTitle
-                     << setw(20) << company
-                     << setw(12) << status << endl;
+            bool pageDone = false;
+            while (!pageDone) {
+                {
+                    OutputBuffer out(cout);
+                    out.put('\n').padded("#", 4)
+                       .padded("Student ID", 12)
+                       .padded("Job ID", 8)
+                       .padded("Job Title", 25)
+                       .padded("Company", 20)
+                       .padded("Decision", 12).put('\n');
+                    out.repeat('-', 81).put('\n');
+                    for (int i = 0; i < pageCount; i++) {
+                        out.paddedInt(i + 1, 4)
+                           .padded(page[i]->studentID, 12)
+                           .padded(page[i]->jobID, 8)
+                           .padded(page[i]->jobTitle, 25)
+                           .padded(page[i]->company, 20)
+                           .padded(decision[i].empty() ? "-" : decision[i], 12).put('\n');
+                    }
+                }
 
+                cout << "\n1. Approve selected rows\n";
+                cout << "2. Reject selected rows\n";
+                cout << "3. Approve all on this page\n";
+                cout << "4. Reject all on this page\n";
+                cout << "5. Commit and show next page\n";
+                cout << "6. Commit and finish\n";
+                cout << "Enter choice: ";
                 int choice;
-                cout << "Set status for " << jobID << " (1: Approved, 2: Rejected, 3: Skip): ";
                 cin >> choice;
-                if (choice == 1) status = "Approved";
-                else if (choice == 2) status = "Rejected";
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
                 if (choice == 1 || choice == 2) {
-                    // linesToUpdate.push_back(...)
-                    // se array indexing
-                    linesToUpdate[updateCount++] = studentID + "|" + jobID + "|" + jobTitle + "|" + company + "|" + status;
+                    cout << "Enter row numbers separated by spaces: ";
+                    string rowsLine;
+                    getline(cin, rowsLine);
+                    stringstream rowStream(rowsLine);
+                    int row;
+                    while (rowStream >> row) {
+                        if (row >= 1 && row <= pageCount) {
+                            decision[row - 1] = (choice == 1) ? "Approved" : "Rejected";
+                        }
+                    }
+                } else if (choice == 3 || choice == 4) {
+                    for (int i = 0; i < pageCount; i++) {
+                        if (decision[i].empty()) decision[i] = (choice == 3) ? "Approved" : "Rejected";
+                    }
+                } else if (choice == 5 || choice == 6) {
+                    pageDone = true;
+                    done = (choice == 6);
+                } else {
+                    cout << "Invalid choice.\n";
                 }
             }
-        }
-        file.close();
 
-        if (updateCount > 0) {
-            // Update file logic using array instead of vector
-            ofstream outFile("applications.txt");
-            if (!outFile.is_open()) {
-                throw FileException("Cannot open applications.txt for writing");
+            // Commit the decided rows, keep the rest for re-queueing
+            ApplicationNode* decided[REVIEW_PAGE_SIZE];
+            string statuses[REVIEW_PAGE_SIZE];
+            int decidedCount = 0;
+            for (int i = 0; i < pageCount; i++) {
+                if (!decision[i].empty()) {
+                    decided[decidedCount] = page[i];
+                    statuses[decidedCount] = decision[i];
+                    decidedCount++;
+                    continue;
+                }
+                if (skippedCount == skippedCapacity) {
+                    int newCapacity = skippedCapacity == 0 ? REVIEW_PAGE_SIZE : skippedCapacity * 2;
+                    ApplicationNode** bigger = new ApplicationNode*[newCapacity];
+                    for (int j = 0; j < skippedCount; j++) bigger[j] = skipped[j];
+                    delete[] skipped;
+                    skipped = bigger;
+                    skippedCapacity = newCapacity;
+                }
+                skipped[skippedCount++] = page[i];
             }
-            
-            for (int i = 0; i < updateCount; i++) {
-                outFile << linesToUpdate[i] << endl;
+            try {
+                system->commitDecisions(decided, statuses, decidedCount);
+                if (decidedCount > 0) cout << decidedCount << " decision(s) committed.\n";
+            } catch (const FileException& e) {
+                cout << "Error: " << e.what() << " - decisions on this page were not saved.\n";
+                for (int i = 0; i < decidedCount; i++) queue->push(decided[i]);
             }
-            outFile.close();
-            cout << "Application statuses updated!\n";
-        } else {
-            cout << "No pending applications to process.\n";
         }
-    } catch (const FileException& e) {
+    } catch (const exception& e) {
         cout << "Error: " << e.what() << endl;
     }
+
+    // Skipped applications stay pending for the next review session
+    for (int i = 0; i < skippedCount; i++) {
+        queue->push(skipped[i]);
+    }
+    delete[] skipped;
 }
 
-void Staff::generateDepartmentReport(InternshipSystem* system)
+// Tables of department_report_<department>_<timestamp>
+const ReportColumn DEPARTMENT_TOTAL_COLUMNS[] = {
+    { "department", "Department", COLUMN_TEXT, 0 },
+    { "staff", "Total Staff", COLUMN_INTEGER, 0 },
+    { "total", "Total Applications", COLUMN_INTEGER, 0 },
+    { "pending", "Pending", COLUMN_INTEGER, 0 },
+    { "approved", "Approved", COLUMN_INTEGER, 0 },
+    { "rejected", "Rejected", COLUMN_INTEGER, 0 }
+};
+const ReportTable DEPARTMENT_TOTAL_TABLE = { "department_totals", "TOTALS", DEPARTMENT_TOTAL_COLUMNS, 6, TABLE_RECORD };
+
+const ReportColumn DEPARTMENT_JOB_COLUMNS[] = {
+    { "job_id", "Job ID", COLUMN_TEXT, 8 },
+    { "title", "Title", COLUMN_TEXT, 28 },
+    { "total", "Total", COLUMN_INTEGER, 8 },
+    { "pending", "Pending", COLUMN_INTEGER, 9 },
+    { "approved", "Approved", COLUMN_INTEGER, 10 },
+    { "rejected", "Rejected", COLUMN_INTEGER, 0 }
+};
+const ReportTable DEPARTMENT_JOB_TABLE = { "department_jobs", "BY JOB", DEPARTMENT_JOB_COLUMNS, 6, TABLE_ROWS };
+
+
+void Staff::generateDepartmentReport(InternshipSystem* system, ReportFormat format)
 {
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "Staff::generateDepartmentReport");
     try {
-        ofstream report(("department_report_" + department + "_" + system->getCurrentTimestamp() + ".txt").c_str());
-        if (!report.is_open()) {
+        system->ensureApplicationsLoaded();
+        const DepartmentStats* stats = system->getDepartmentStats(department);
+        const JobStatusCounts& totals = stats->getTotals();
+
+        ReportOutput report(format, system->reportFileBase("department_report_" + department + "_"));
+        if (!report->good()) {
             throw FileException("Cannot create department report file");
         }
 
-        report << "=== " << department << " Department Report ===\n";
-        report << "Generated on: " << system->getCurrentTimestamp() << "\n";
-        report << "Total Staff: " << Staff::getTotalStaff() << "\n";
+        report->heading("=== " + department + " Department Report ===");
+        report->heading("Generated on: " + system->getCurrentTimestamp());
+
+        report->beginTable(DEPARTMENT_TOTAL_TABLE);
+        report->text(department);
+        report->integer(Staff::getTotalStaff());
+        report->integer(totals.total);
+        report->integer(totals.pending);
+        report->integer(totals.approved);
+        report->integer(totals.rejected);
+        report->endRow();
+        report->endTable();
+
+        report->beginTable(DEPARTMENT_JOB_TABLE);
+        for (int i = 0; i < stats->getJobCount(); i++) {
+            const JobStatusCounts& job = stats->getJobCounts(i);
+            report->text(job.jobID);
+            report->text(job.jobTitle);
+            report->integer(job.total);
+            report->integer(job.pending);
+            report->integer(job.approved);
+            report->integer(job.rejected);
+            report->endRow();
+        }
+        report->endTable();
 
-        int deptApps = 0;
-        ifstream appFile("applications.txt");
-        if (appFile.is_open()) {
-            string line;
-            while (getline(appFile, line)) {
-                stringstream ss(line);
-                string company;
-                getline(ss, company, '|'); // Adjusted to skip fields correctly
-                getline(ss, company, '|'); // Move to company field
-                getline(ss, company, '|'); // Get company
-                if (company.find(department) != string::npos) deptApps++;
-            }
-            appFile.close();
+        if (!report->finish()) {
+            throw FileException("Cannot write department report file");
         }
-        report << "Total Applications: " << deptApps << "\n";
-        report.close();
-        cout << "Department report generated: department_report_" << department << "_" << system->getCurrentTimestamp() << ".txt\n";
-    } catch (const FileException& e) {
+        cout << "Department report generated: " << report->getFiles() << "\n";
+    } catch (const exception& e) {
         cout << "Error: " << e.what() << endl;
     }
 }
 
 void Staff::viewDepartmentInternships(InternshipSystem* system)
 {
-    cout << "\n=== Internships for " << department << " Department ===\n";
-    cout << left << setw(8) << "Job ID"
-         << setw(30) << "Title"
-         << setw(20) << "Company"
-         << setw(12) << "Deadline" << endl;
-    cout << string(70, '-') << endl;
+    OutputBuffer out(cout);
+    out.put("\n=== Internships for ").put(department).put(" Department ===\n");
+    out.padded("Job ID", 8)
+       .padded("Title", 30)
+       .padded("Company", 20)
+       .padded("Deadline", 12).put('\n');
+    out.repeat('-', 70).put('\n');
 
     int count = 0;
     for (int i = 0; i < system->getJobCount(); i++) {
         InternshipJob* job = system->getJob(i);
         if (job && isDepartmentMatch(job->getCompany(), department)) {
-            cout << left << setw(8) << job->getJobID()
-                 << setw(30) << job->getTitle()
-                 << setw(20) << job->getCompany()
-                 << setw(12) << job->getDeadline() << endl;
+            out.padded(job->getJobID(), 8)
+               .padded(job->getTitle(), 30)
+               .padded(job->getCompany(), 20)
+               .padded(job->getDeadline(), 12).put('\n');
             count++;
         }
     }
+    out.flush();
     if (count == 0) {
         cout << "No internships found for " << department << " department.\n";
     } else {
@@ -1682,11 +3836,7 @@ StudentHashTable::StudentHashTable(int size) : size(size), count(0)
 
 StudentHashTable::~StudentHashTable() 
 {
-    for (int i = 0; i < size; i++) {
-        if (table[i] != NULL) {
-            delete table[i];
-        }
-    }
+    // Students are owned by InternshipSystem::students, the table only indexes them
     delete[] table;
 }
 
@@ -1702,8 +3852,29 @@ int StudentHashTable::hash(string key)
 }
 
 
+// Doubles the table and re-inserts every student
+void StudentHashTable::grow()
+{
+    Student** oldTable = table;
+    int oldSize = size;
+
+    size = size * 2 + 1;
+    table = new Student*[size];
+    for (int i = 0; i < size; i++) table[i] = NULL;
+    count = 0;
+
+    for (int i = 0; i < oldSize; i++) {
+        if (oldTable[i] != NULL) insert(oldTable[i]);
+    }
+    delete[] oldTable;
+}
+
+
 void StudentHashTable::insert(Student* student) 
 {
+    // Keep the load factor at or below one half so probe runs stay short
+    if ((count + 1) * 2 > size) grow();
+
     int index = hash(student->getID());
 
     // Simple linear probing for collision resolution
@@ -1759,9 +3930,18 @@ void StudentHashTable::remove(string studentID)
     {
         if (table[index]->getID() == studentID) 
         {
-            delete table[index];
             table[index] = NULL;
             count--;
+
+            // Re-insert the rest of the probe cluster so later searches still find it
+            int next = (index + 1) % size;
+            while (table[next] != NULL) {
+                Student* moved = table[next];
+                table[next] = NULL;
+                count--;
+                insert(moved);
+                next = (next + 1) % size;
+            }
             return;
         }
         index = (index + 1) % size;
@@ -1771,767 +3951,3710 @@ void StudentHashTable::remove(string studentID)
 }
 
 
+void StudentHashTable::clear()
+{
+    for (int i = 0; i < size; i++) 
+    {
+        table[i] = NULL;
+    }
+    count = 0;
+}
+
+
 
 void StudentHashTable::display() 
 
 {
 
-    cout << "\n=== Hash Table Contents ===" << endl;
+    OutputBuffer out(cout);
+
+    out.put("\n=== Hash Table Contents ===\n");
+
+    for (int i = 0; i < size; i++) 
+
+    {
+
+        out.put("Index ").putInt(i).put(": ");
+
+        if (table[i] != NULL) {
+
+            out.put(table[i]->getID()).put(" - ").put(table[i]->getName());
+
+        } else {
+
+            out.put("Empty");
+
+        }
+
+        out.put('\n');
+
+    }
+
+}
+
+
 
+// Implementation of JobHashTable methods
+JobHashTable::JobHashTable(int size) : size(size), count(0)
+{
+    table = new InternshipJob*[size];
     for (int i = 0; i < size; i++) 
+    {
+        table[i] = NULL;
+    }
+}
+
+
+JobHashTable::~JobHashTable()
+{
+    // Jobs are owned by InternshipSystem::jobs
+    delete[] table;
+}
+
+
+int JobHashTable::hash(const string& key) const
+{
+    int hash = 0;
+    for (size_t i = 0; i < key.length(); i++) 
+    {
+        hash = (hash * 31 + key[i]) % size;
+    }
+    return hash % size;
+}
+
+
+void JobHashTable::insert(InternshipJob* job)
+{
+    int index = hash(job->getJobID());
+    int originalIndex = index;
+
+    while (table[index] != NULL) {
+        if (table[index]->getJobID() == job->getJobID()) {
+            table[index] = job; // Same ID - replace the entry
+            return;
+        }
+        index = (index + 1) % size;
+        if (index == originalIndex) {
+            throw runtime_error("Job hash table is full");
+        }
+    }
+    table[index] = job;
+    count++;
+}
+
+
+InternshipJob* JobHashTable::search(const string& jobID) const
+{
+    int index = hash(jobID);
+    int originalIndex = index;
+
+    while (table[index] != NULL) 
+    {
+        if (table[index]->getJobID() == jobID) 
+        {
+            return table[index];
+        }
+        index = (index + 1) % size;
+        if (index == originalIndex) break;
+    }
+    return NULL;
+}
+
+
+void JobHashTable::remove(const string& jobID)
+{
+    int index = hash(jobID);
+    int originalIndex = index;
 
+    while (table[index] != NULL) 
     {
+        if (table[index]->getJobID() == jobID) 
+        {
+            table[index] = NULL;
+            count--;
 
-        cout << "Index " << i << ": ";
+            int next = (index + 1) % size;
+            while (table[next] != NULL) {
+                InternshipJob* moved = table[next];
+                table[next] = NULL;
+                count--;
+                insert(moved);
+                next = (next + 1) % size;
+            }
+            return;
+        }
+        index = (index + 1) % size;
+        if (index == originalIndex) break;
+    }
+}
+
+
+void JobHashTable::clear()
+{
+    for (int i = 0; i < size; i++) 
+    {
+        table[i] = NULL;
+    }
+    count = 0;
+}
+
+
+
+// Implementation of DeadlineIndex methods
+DeadlineIndex::DeadlineIndex(int capacity) : size(0), capacity(capacity > 0 ? capacity : 1)
+{
+    heap = new InternshipJob*[this->capacity];
+}
+
+
+void DeadlineIndex::siftUp(int index)
+{
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap[parent]->getDeadlineDay() <= heap[index]->getDeadlineDay()) break;
+        InternshipJob* temp = heap[parent];
+        heap[parent] = heap[index];
+        heap[index] = temp;
+        index = parent;
+    }
+}
+
+
+void DeadlineIndex::siftDown(int index)
+{
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < size && heap[left]->getDeadlineDay() < heap[smallest]->getDeadlineDay()) smallest = left;
+        if (right < size && heap[right]->getDeadlineDay() < heap[smallest]->getDeadlineDay()) smallest = right;
+        if (smallest == index) break;
+        InternshipJob* temp = heap[smallest];
+        heap[smallest] = heap[index];
+        heap[index] = temp;
+        index = smallest;
+    }
+}
+
+
+void DeadlineIndex::insert(InternshipJob* job)
+{
+    if (size == capacity) {
+        InternshipJob** bigger = new InternshipJob*[capacity * 2];
+        for (int i = 0; i < size; i++) bigger[i] = heap[i];
+        delete[] heap;
+        heap = bigger;
+        capacity *= 2;
+    }
+    heap[size] = job;
+    siftUp(size);
+    size++;
+}
+
+
+void DeadlineIndex::remove(InternshipJob* job)
+{
+    for (int i = 0; i < size; i++) {
+        if (heap[i] == job) {
+            heap[i] = heap[--size];
+            if (i < size) {
+                siftDown(i);
+                siftUp(i);
+            }
+            return;
+        }
+    }
+}
+
+
+// Deactivates and drops every job whose deadline is before today.
+// Returns how many jobs were closed.
+int DeadlineIndex::sweep(long today)
+{
+    int closed = 0;
+    while (size > 0 && heap[0]->getDeadlineDay() < today) {
+        heap[0]->setIsActive(false);
+        heap[0] = heap[--size];
+        siftDown(0);
+        closed++;
+    }
+    return closed;
+}
+
+
+// Children never have an earlier deadline than their parent, so whole
+// subtrees past lastDay are skipped
+void DeadlineIndex::collectUpTo(int index, long lastDay, InternshipJob** out, int& count, int maxCount) const
+{
+    if (index >= size || count >= maxCount || heap[index]->getDeadlineDay() > lastDay) return;
+    out[count++] = heap[index];
+    collectUpTo(2 * index + 1, lastDay, out, count, maxCount);
+    collectUpTo(2 * index + 2, lastDay, out, count, maxCount);
+}
+
+
+// Fills out with the active jobs due on or before lastDay, earliest first
+int DeadlineIndex::closingBy(long lastDay, InternshipJob** out, int maxCount) const
+{
+    int count = 0;
+    collectUpTo(0, lastDay, out, count, maxCount);
+
+    // Insertion sort of the k results
+    for (int i = 1; i < count; i++) {
+        InternshipJob* key = out[i];
+        int j = i - 1;
+        while (j >= 0 && out[j]->getDeadlineDay() > key->getDeadlineDay()) {
+            out[j + 1] = out[j];
+            j--;
+        }
+        out[j + 1] = key;
+    }
+    return count;
+}
+
+
+JobCatalogSnapshot::JobCatalogSnapshot(int capacity) : version(0), count(0), openCount(0)
+{
+    if (capacity < 1) capacity = 1;
+    listings = new JobListing[capacity];
+    open = new const JobListing*[capacity];
+}
+
+JobCatalogSnapshot::~JobCatalogSnapshot()
+{
+    delete[] listings;
+    delete[] open;
+}
+
+// Snapshots are built with room for exactly their jobs, see publishJobCatalog()
+long JobCatalogSnapshot::memoryBytes() const
+{
+    int capacity = count > 0 ? count : 1;
+    long bytes = heapBlockBytes(sizeof(JobCatalogSnapshot)) + heapBlockBytes(capacity * sizeof(JobListing)) +
+                 heapBlockBytes(capacity * sizeof(const JobListing*));
+    for (int i = 0; i < count; i++) {
+        const JobListing& listing = listings[i];
+        bytes += stringHeapBytes(listing.jobID) + stringHeapBytes(listing.title) + stringHeapBytes(listing.company) +
+                 stringHeapBytes(listing.deadline) + stringHeapBytes(listing.requirements);
+    }
+    return bytes;
+}
+
+// Sets first to the first open job due on or after firstDay and returns
+// the end of the run due on or before lastDay
+int JobCatalogSnapshot::openBetween(long firstDay, long lastDay, int& first) const
+{
+    int low = 0, high = openCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (open[mid]->deadlineDay < firstDay) low = mid + 1; else high = mid;
+    }
+    first = low;
+
+    high = openCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (open[mid]->deadlineDay <= lastDay) low = mid + 1; else high = mid;
+    }
+    return low;
+}
+
+
+JobCatalog::JobCatalog() : current(new JobCatalogSnapshot(1)), epoch(1), retiredCount(0), nextVersion(0)
+{
+    for (int i = 0; i < MAX_CATALOG_READERS; i++) {
+        readerEpochs[i] = 0;
+    }
+}
+
+JobCatalog::~JobCatalog()
+{
+    delete current;
+    for (int i = 0; i < retiredCount; i++) {
+        delete retired[i].snapshot;
+    }
+}
+
+// Pins the current snapshot and returns the reader slot to pass to leave()
+int JobCatalog::enter(const JobCatalogSnapshot*& snapshot)
+{
+    while (true) {
+        long seen = atomicLoad(&epoch);
+        for (int i = 0; i < MAX_CATALOG_READERS; i++) {
+            if (readerEpochs[i] == 0 && atomicCompareAndSwap(&readerEpochs[i], 0, seen)) {
+                snapshot = atomicLoadPointer(&current);
+                return i;
+            }
+        }
+        yieldThread(); // every slot busy
+    }
+}
+
+void JobCatalog::leave(int slot)
+{
+    atomicStore(&readerEpochs[slot], 0);
+}
+
+// Frees retired snapshots that no pinned reader can still hold
+void JobCatalog::reclaim()
+{
+    long oldestReader = 0;
+    for (int i = 0; i < MAX_CATALOG_READERS; i++) {
+        long pinned = atomicLoad(&readerEpochs[i]);
+        if (pinned != 0 && (oldestReader == 0 || pinned < oldestReader)) oldestReader = pinned;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < retiredCount; i++) {
+        if (oldestReader == 0 || oldestReader >= retired[i].epoch) {
+            delete retired[i].snapshot;
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    retiredCount = kept;
+}
+
+// Makes snapshot the current catalog; the catalog takes ownership
+void JobCatalog::publish(JobCatalogSnapshot* snapshot)
+{
+    ScopedLock guard(writerMutex);
+    snapshot->version = ++nextVersion;
+
+    JobCatalogSnapshot* previous = atomicExchangePointer(&current, snapshot);
+    long replacedAt = atomicIncrement(&epoch);
+
+    reclaim();
+    while (retiredCount == MAX_CATALOG_RETIRED) {
+        yieldThread(); // readers are still on every old version
+        reclaim();
+    }
+    retired[retiredCount].snapshot = previous;
+    retired[retiredCount].epoch = replacedAt;
+    retiredCount++;
+    reclaim();
+}
+
+
+
+// Friend functions implementations
+
+void saveStudentToFile(Student& student, OutputBuffer& file) 
+
+{
+
+    file.put(student.id).put('|').put(student.name).put('|').put(student.email).put('|')
+
+        .putFixed(student.cgpa, 2).put('|')
+
+        .put(student.diploma).put('|').put(student.skills).put("|\n");
+
+}
+
+
+
+void saveAdminToFile(Admin& admin, OutputBuffer& file) 
+
+{
+
+    file.put(admin.id).put('|').put(admin.name).put('|').put(admin.email).put('|')
+
+        .put(admin.password).put("|\n");
+
+}
+
+
+
+void saveStaffToFile(Staff& staff, OutputBuffer& file) 
+
+{
+
+    file.put(staff.id).put('|').put(staff.name).put('|').put(staff.email).put('|')
+
+        .put(staff.department).put('|').put(staff.position).put('|')
+
+        .put(staff.password).put("|\n");
+
+}
+
+
+
+void saveJobToFile(InternshipJob& job, OutputBuffer& file) 
+
+{
+
+    file.put(job.jobID).put('|').put(job.title).put('|').put(job.company).put('|')
+
+        .put(job.deadline).put('|').put(job.requirements).put("|\n");
+
+}
+
+
+
+// Implementation of InternshipSystem methods
+
+InternshipSystem::InternshipSystem() 
+
+{
+
+    // Initialize counters
+
+    studentCount = 0;
+
+    adminCount = 0;
+
+    staffCount = 0;
+
+    jobCount = 0;
+
+    
+
+    // Initialize arrays to NULL
+
+    studentCapacity = MAX_STUDENTS;
+
+    students = new Student*[studentCapacity];
+
+    for (int i = 0; i < MAX_STUDENTS; i++) {
+
+        students[i] = NULL;
+
+        admins[i] = NULL;
+
+    }
+
+    for (int i = 0; i < MAX_STAFF; i++) {
+
+        staffMembers[i] = NULL;
+
+    }
+
+    for (int i = 0; i < MAX_JOBS; i++) {
+
+        jobs[i] = NULL;
+
+    }
+
+    
+
+    // Initialize pointers
+
+    currentStaff = NULL;
+
+    currentAdmin = NULL;  // Initialize this
+
+    
+
+    applications = new ApplicationList();
+
+    studentHash = new StudentHashTable(MAX_STUDENTS * 2);
+
+    jobHash = new JobHashTable();
+
+    deadlineIndex = new DeadlineIndex();
+
+    jobCatalog = new JobCatalog();
+
+    // The calling thread also runs tasks, so one worker fewer than the cores
+    scheduler = new TaskScheduler(getHardwareThreadCount() - 1);
+
+    applicationsLoaded = false;
+
+    reviewQueueCount = 0;
+
+    departmentStatsCount = 0;
+
+    decisionLogRows = 0;
+    decisionLogTorn = false;
+
+    reportNameUses = 0;
+
+    applicationCube = NULL;
+
+    applicationCubeStale = true;
+
+    jobApplicants = NULL;
+
+    jobApplicantsStale = true;
+
+    onlineSnapshot = NULL;
+
+    
+
+    // Load the data files; start from the sample data when there are none
+
+    loadSystemData();
+
+    if (studentCount == 0 && staffCount == 0 && adminCount == 0 && jobCount == 0) {
+        initializeSampleData();
+    }
+
+}
+
+
+
+InternshipSystem::~InternshipSystem() 
+
+{
+
+    backupThread.join();   // A background backup still reads the stores
+
+    // Clean up dynamic memory
+
+    for (int i = 0; i < studentCount; i++) {
+
+        delete students[i];
+
+    }
+
+    delete[] students;
+
+    for (int i = 0; i < adminCount; i++) {
+
+        delete admins[i];
+
+    }
+
+    for (int i = 0; i < staffCount; i++) {
+
+        delete staffMembers[i];
+
+    }
+
+    for (int i = 0; i < jobCount; i++) {
+
+        delete jobs[i];
+
+    }
+
+    delete applications;
+
+    delete studentHash;
+
+    delete jobHash;
+
+    delete deadlineIndex;
+
+    delete jobCatalog;
+
+    delete scheduler;
+
+    for (int i = 0; i < reviewQueueCount; i++) {
+        delete reviewQueues[i];
+    }
+
+    for (int i = 0; i < departmentStatsCount; i++) {
+        delete departmentStats[i];
+    }
+
+    delete applicationCube;
+
+    delete jobApplicants;
+
+}
+
+
+
+// Fix sample job creation in initializeSampleData()
+void InternshipSystem::initializeSampleData() 
+{
+    // Sample students - using array indexing instead of push_back
+    students[studentCount++] = new Student("1231203277", "Aisyah Binti Rahman", "aisyah.rahman@mmu.edu.my", 3.70, "IT", "Java, HTML, Communication");
+    students[studentCount++] = new Student("1231203278", "Kevin Lim", "kevin.lim@mmu.edu.my", 2.85, "Business", "Marketing, Sales, Data Analysis");
+    students[studentCount++] = new Student("1231203279", "Nurul Izzati", "nurul.izzati@mmu.edu.my", 3.80, "IT", "Graphic Design, Adobe Illustrator, HTML");
+    students[studentCount++] = new Student("1231203280", "Arvind Raj", "arvind.raj@mmu.edu.my", 2.50, "Accounting", "Financial Reporting, Excel, Auditing");
+    students[studentCount++] = new Student("1231203281", "Sarah Wong", "sarah.wong@mmu.edu.my", 3.40, "Business", "Public Speaking, SEO, Business Management");
+    students[studentCount++] = new Student("1231203282", "Faizal Mohd", "faizal.mohd@mmu.edu.my", 3.05, "IT", "C++, MySQL, Network Security");
+    students[studentCount++] = new Student("1231203283", "Michelle Tan", "michelle.tan@mmu.edu.my", 3.75, "IT", "UI/UX Design, Figma, HTML");
+    students[studentCount++] = new Student("1231203284", "Daniel Lee", "daniel.lee@mmu.edu.my", 2.90, "Accounting", "Bookkeeping, Tax Preparation, Excel");
+    students[studentCount++] = new Student("1231203285", "Hema Letchumy", "hema.letchumy@mmu.edu.my", 3.20, "Business", "Project Management, Python, Agile");
+    students[studentCount++] = new Student("1231203286", "Amirul Hakim", "amirul.hakim@mmu.edu.my", 2.10, "IT", "Linux, Troubleshooting, Python");
+    students[studentCount++] = new Student("1231203287", "Lim Kai Jie", "lim.kj@mmu.edu.my", 3.00, "Accounting", "Payroll Management, QuickBooks, Financial Analysis");
+    students[studentCount++] = new Student("1231203288", "Rani Devi", "rani.devi@mmu.edu.my", 3.50, "Business", "Excel, Business Analysis, Communication");
+    students[studentCount++] = new Student("1231203289", "John Goh", "john.goh@mmu.edu.my", 2.75, "IT", "Ruby on Rails, Web Development, GitHub");
+    students[studentCount++] = new Student("1231203290", "Siti Noraini", "siti.noraini@mmu.edu.my", 3.60, "Business", "Content Writing, Canva, Social Media Marketing");
+    students[studentCount++] = new Student("1231203291", "Thinesh Kumar", "thinesh.kumar@mmu.edu.my", 2.40, "IT", "Android Development, Java, SQLite");
+    students[studentCount++] = new Student("1231203292", "Leong Wei Ming", "leong.wei.ming@mmu.edu.my", 3.35, "Accounting", "C#, .NET, SQL");
+    students[studentCount++] = new Student("1231203293", "Maya Shanti", "maya.shanti@mmu.edu.my", 3.55, "Business", "Marketing, Social Media, SEO");
+    students[studentCount++] = new Student("1231203190", "edwin ceo", "mone@gmail.com", 3.98, "IT", "Java");
+    students[studentCount++] = new Student("1231201130", "Riashini a/p Manoj Kumar", "riawee25@gmail.com", 3.7, "IT", "Java, HTML, PHP, C++, Python");
+    
+    // ? Add sample admins to the system
+    admins[adminCount++] = new Admin("admin1", "Admin One", "admin1@mmu.edu.my", "password123");
+    admins[adminCount++] = new Admin("admin2", "Admin Two", "admin2@mmu.edu.my", "admin456");
+    admins[adminCount++] = new Admin("test", "Test Admin", "test@mmu.edu.my", "123456");
+    
+    // Sample staff
+    staffMembers[staffCount++] = new Staff("STF1001", "Dr. Lim Wei Chen", "lim.wc@mmu.edu.my", "Career Services", "Manager", "pass123");
+    staffMembers[staffCount++] = new Staff("STF1002", "Ms. Nor Azlina", "nor.azlina@mmu.edu.my", "IT Department", "Coordinator", "pwd456");
+    staffMembers[staffCount++] = new Staff("STF1003", "Mr. Rajesh Kumar", "rajesh.k@mmu.edu.my", "Business Faculty", "Advisor", "secure789");
+    
+    // Sample jobs - Add requirements parameter
+    jobs[jobCount++] = new InternshipJob("JOB1001", "Software Developer Intern", "Tech Solutions Sdn Bhd", "2023-12-15", "C++, Python, Problem Solving");
+    jobs[jobCount++] = new InternshipJob("JOB1002", "Marketing Intern", "Global Marketing Group", "2023-11-30", "Communication, Creativity, Social Media");
+    jobs[jobCount++] = new InternshipJob("JOB1003", "Finance Intern", "Capital Investments Berhad", "2024-01-10", "Accounting, Excel, Analytical Skills");
+    
+    // Index the sample records for hash lookups
+    for (int i = 0; i < studentCount; i++) {
+        studentHash->insert(students[i]);
+    }
+    for (int i = 0; i < jobCount; i++) {
+        jobHash->insert(jobs[i]);
+    }
+    rebuildDeadlineIndex();
+    
+    logEvent("SYSTEM", "Sample data initialized");
+}
+
+
+
+// Utility functions
+
+string InternshipSystem::trim(const string& str) 
+
+{
+
+    size_t first = str.find_first_not_of(" \t\n\r");
+
+    if (first == string::npos) return "";
+
+    size_t last = str.find_last_not_of(" \t\n\r");
+
+    return str.substr(first, (last - first + 1));
+
+}
+
+
+
+long long InternshipSystem::stringToLongLong(const string& str) 
+
+{
+
+    try {
+
+        return atoll(str.c_str());
+
+    } catch (...) {
+
+        return 0;
+
+    }
+
+}
+
+
+
+float InternshipSystem::stringToFloat(const string& str) 
+
+{
+
+    try {
+
+        return (float)atof(str.c_str());
+
+    } catch (...) {
+
+        return 0.0;
+
+    }
+
+}
+
+
+
+string InternshipSystem::encryptPassword(const string& password) 
+
+{
+
+    string encrypted = password;
+
+    for (size_t i = 0; i < encrypted.length(); i++) {
+
+        char c = encrypted[i];
+
+        if (isalpha(c)) {
+
+            char base = isupper(c) ? 'A' : 'a';
+
+            c = ((c - base + 3) % 26) + base;
+
+        } else if (isdigit(c)) {
+
+            c = ((c - '0' + 5) % 10) + '0';
+
+        }
+
+    }
+
+    return encrypted;
+
+}
+
+
+
+string InternshipSystem::decryptPassword(const string& encrypted) 
+
+{
+
+    string decrypted = encrypted;
+
+    for (size_t i = 0; i < decrypted.length(); i++) {
+
+        char c = decrypted[i];
+
+        if (isalpha(c)) {
+
+            char base = isupper(c) ? 'A' : 'a';
+
+            c = ((c - base - 3 + 26) % 26) + base;
+
+        } else if (isdigit(c)) {
+
+            c = ((c - '0' - 5 + 10) % 10) + '0';
+
+        }
+
+    }
+
+    return decrypted;
+
+}
+
+
+
+// Serialises log appends from server worker threads
+Mutex logMutex;
+
+void InternshipSystem::logEvent(const string& eventType, const string& details) 
+
+{
+
+    ScopedLock guard(logMutex);
+
+    try {
+
+        ofstream logFile(LOG_FILE.c_str(), ios::app);
+
+        if (!logFile.is_open()) {
+
+            throw FileException("Cannot open log file: " + LOG_FILE);
+
+        }
+
+        
+
+        LogEntry entry(eventType, details);
+
+        logFile << entry.toString() << endl;
+
+        logFile.close();
+
+    } catch (const FileException& e) {
+
+        cerr << "Logging Error: " << e.what() << endl;
+
+    }
+
+}
+
+
+
+// File operations
+
+void InternshipSystem::loadStudentsFromFile() 
+
+{
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadStudentsFromFile");
+
+    beforeStoreChange(STUDENTS_FILE);
+    try {
+
+        ifstream file("students.txt");
+
+        if (!file.is_open()) {
+
+            throw FileException("Cannot open students.txt for reading");
+
+        }
+
+        // Clear existing data
+        studentHash->clear();
+        for (int i = 0; i < studentCount; i++) {
+            delete students[i];
+            students[i] = NULL;
+        }
+        studentCount = 0;
+        
+        string line;
+        while (getline(file, line)) {
+
+            if (line.empty()) continue;
+
+            stringstream ss(line);
+            string id, name, email, cgpaStr, diploma, skills;
+            getline(ss, id, '|');
+            getline(ss, name, '|');
+            getline(ss, email, '|');
+            getline(ss, cgpaStr, '|');
+            getline(ss, diploma, '|');
+            getline(ss, skills, '|');
+
+            float cgpa = stringToFloat(cgpaStr);
+            Student* student = new Student(id, name, email, cgpa, diploma, skills);
+            reserveStudents(studentCount + 1);
+            students[studentCount++] = student;
+            studentHash->insert(student);
+        }
+        file.close();
+        cout << "Loaded " << studentCount << " students from file.\n";
+        logEvent("SYSTEM", "Students loaded from file");
+    } catch (const FileException& e) {
+
+        cout << "Error: " << e.what() << endl;
+
+        logEvent("ERROR", e.what());
+
+    }
+
+}
+
+
+
+bool InternshipSystem::saveStudentsToFile() 
+{
+    MetricTimer timer(metrics, METRIC_SAVE);
+    TRACE_SCOPE("save", "InternshipSystem::saveStudentsToFile");
+    try {
+        ostringstream file;
+        {
+            OutputBuffer out(file);
+            for (int i = 0; i < studentCount; i++) {
+                saveStudentToFile(*students[i], out);
+            }
+        }
+        if (!saver.save("students.txt", file.str())) {
+            throw FileException("Cannot write students.txt");
+        }
+        cout << "Saved " << studentCount << " students to file (" << saver.describeLast() << ").\n";
+        logEvent("SYSTEM", "Students saved to file");
+        return true;
+    } catch (const FileException& e) {  // ? Fix: Add proper catch block
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+        return false;
+    }
+}
+
+
+void InternshipSystem::loadStaffFromFile() 
+{
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadStaffFromFile");
+    beforeStoreChange(STAFF_FILE);
+    try {
+
+        ifstream file("staff.txt");
+
+        if (!file.is_open()) {
+
+            throw FileException("Cannot open staff.txt for reading");
+
+        }
+
+        
+
+        //  staffMembers.clear();  // This is vector method!
+        //  Clear array manually instead
+        for (int i = 0; i < staffCount; i++) {
+            delete staffMembers[i];
+            staffMembers[i] = NULL;
+        }
+        staffCount = 0;
+
+        string line;
+
+        while (getline(file, line) && staffCount < MAX_STAFF) {
+
+            if (line.empty()) continue;
+
+
+
+            stringstream ss(line);
+
+            string id, name, email, department, position, password;
+
+            getline(ss, id, '|');
+
+            getline(ss, name, '|');
+
+            getline(ss, email, '|');
+
+            getline(ss, department, '|');
+
+            getline(ss, position, '|');
+
+            getline(ss, password, '|');
+
+
+
+            //  staffMembers.push_back(staff);  // Vector method!
+            //  Use array indexing instead
+            staffMembers[staffCount++] = new Staff(id, name, email, department, position, password);
+
+        }
+
+        file.close();
+
+        cout << "Loaded " << staffCount << " staff members from file.\n";
+
+        logEvent("SYSTEM", "Staff loaded from file");
+
+    } catch (const FileException& e) {
+
+        cout << "Error: " << e.what() << endl;
+
+        logEvent("ERROR", e.what());
+
+    }
+
+}
+
+
+
+bool InternshipSystem::saveStaffToFile() 
+
+{
+    MetricTimer timer(metrics, METRIC_SAVE);
+    TRACE_SCOPE("save", "InternshipSystem::saveStaffToFile");
+
+    try {
+
+        ostringstream file;
+
+        {
+            OutputBuffer out(file);
+            //  for (size_t i = 0; i < staffMembers.size(); i++) 
+            //  Use staffCount instead
+            for (int i = 0; i < staffCount; i++) {
+
+                ::saveStaffToFile(*staffMembers[i], out);
+
+            }
+        }
+
+        if (!saver.save("staff.txt", file.str())) {
+
+            throw FileException("Cannot write staff.txt");
+
+        }
+
+        cout << "Saved " << staffCount << " staff members to file (" << saver.describeLast() << ").\n";
+
+        logEvent("SYSTEM", "Staff saved to file");
+
+        return true;
+
+    } catch (const FileException& e) {
+
+        cout << "Error: " << e.what() << endl;
+
+        logEvent("ERROR", e.what());
+
+        return false;
+
+    }
+
+}
+
+
+
+void InternshipSystem::loadAdminsFromFile() 
+
+{
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadAdminsFromFile");
+
+    beforeStoreChange(ADMINS_FILE);
+    try {
+        ifstream file("login_admin.txt");
+        if (!file.is_open()) {
+            throw FileException("Cannot open login_admin.txt for reading");
+        }
+
+        // Clear array manually
+        for (int i = 0; i < adminCount; i++) {
+            delete admins[i];
+            admins[i] = NULL;
+        }
+        adminCount = 0;
+
+        string line;
+        while (getline(file, line) && adminCount < MAX_STUDENTS) {
+            if (line.empty()) continue;
+
+            stringstream ss(line);
+            string id, name, email, password;
+            getline(ss, id, '|');
+            getline(ss, name, '|');
+            getline(ss, email, '|');
+            getline(ss, password, '|');
+
+            admins[adminCount++] = new Admin(id, name, email, password);
+        }
+        file.close();
+        cout << "Loaded " << adminCount << " admins from file.\n";
+        logEvent("SYSTEM", "Admins loaded from file");
+    } catch (const FileException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+    }
+}
 
-        if (table[i] != NULL) {
 
-            cout << table[i]->getID() << " - " << table[i]->getName();
 
-        } else {
+bool InternshipSystem::saveAdminsToFile() 
 
-            cout << "Empty";
+{
+    MetricTimer timer(metrics, METRIC_SAVE);
+    TRACE_SCOPE("save", "InternshipSystem::saveAdminsToFile");
 
+    try {
+        ostringstream file;
+        {
+            OutputBuffer out(file);
+            for (int i = 0; i < adminCount; i++) {
+                saveAdminToFile(*admins[i], out);
+            }
         }
-
-        cout << endl;
-
+        if (!saver.save("login_admin.txt", file.str())) {
+            throw FileException("Cannot write login_admin.txt");
+        }
+        cout << "Saved " << adminCount << " admins to file (" << saver.describeLast() << ").\n";
+        logEvent("SYSTEM", "Admins saved to file");
+        return true;
+    } catch (const FileException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+        return false;
     }
-
 }
 
 
 
-// Friend functions implementations
-
-void saveStudentToFile(Student& student, ostream& file) 
+void InternshipSystem::loadJobsFromFile() 
 
 {
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadJobsFromFile");
 
-    file << student.id << "|" << student.name << "|" << student.email << "|"
+    beforeStoreChange(JOBS_FILE);
+    try {
 
-         << fixed << setprecision(2) << student.cgpa << "|" 
+        ifstream file("job_listings.txt");
 
-         << student.diploma << "|" << student.skills << "|\n";
+        if (!file.is_open()) {
 
-}
+            throw FileException("Cannot open job_listings.txt for reading");
 
+        }
 
+        //  jobs.clear();
+        //  Clear array manually
+        jobHash->clear();
+        deadlineIndex->clear();
+        for (int i = 0; i < jobCount; i++) {
+            delete jobs[i];
+            jobs[i] = NULL;
+        }
+        jobCount = 0;
 
-void saveAdminToFile(Admin& admin, ostream& file) 
+        string line;
 
-{
+        while (getline(file, line) && jobCount < MAX_JOBS) {
 
-    file << admin.id << "|" << admin.name << "|" << admin.email << "|"
+            if (line.empty()) continue;
 
-         << admin.password << "|\n";
+            stringstream ss(line);
 
-}
+            string jobID, title, company, deadline, requirements;
 
+            getline(ss, jobID, '|');
 
+            getline(ss, title, '|');
 
-void saveStaffToFile(Staff& staff, ostream& file) 
+            getline(ss, company, '|');
 
-{
+            getline(ss, deadline, '|');
 
-    file << staff.id << "|" << staff.name << "|" << staff.email << "|"
+            getline(ss, requirements, '|');
 
-         << staff.department << "|" << staff.position << "|"
 
-         << staff.password << "|\n";
 
+            // if (jobs.size() < MAX_JOBS) { jobs.push_back(job); }
+            //  Use array indexing instead
+            jobs[jobCount++] = new InternshipJob(jobID, title, company, deadline, requirements);
+            jobHash->insert(jobs[jobCount - 1]);
+        }
+        file.close();
+        rebuildDeadlineIndex();
+        //  cout << "Loaded " << jobs.size() << " jobs from file.\n";
+        //  Fix to use jobCount
+        cout << "Loaded " << jobCount << " jobs from file.\n";
+        logEvent("SYSTEM", "Jobs loaded from file");
+    } catch (const FileException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+    }
 }
 
 
 
-void saveJobToFile(InternshipJob& job, ostream& file) 
+bool InternshipSystem::saveJobsToFile() 
 
 {
+    MetricTimer timer(metrics, METRIC_SAVE);
+    TRACE_SCOPE("save", "InternshipSystem::saveJobsToFile");
 
-    file << job.jobID << "|" << job.title << "|" << job.company << "|"
-
-         << job.deadline << "|" << job.requirements << "|\n";
-
+    try {
+        ostringstream file;
+        {
+            OutputBuffer out(file);
+            // for (size_t i = 0; i < jobs.size(); i++) 
+            //  Use jobCount instead
+            for (int i = 0; i < jobCount; i++) {
+                saveJobToFile(*jobs[i], out);
+            }
+        }
+        if (!saver.save("job_listings.txt", file.str())) {
+            throw FileException("Cannot write job_listings.txt");
+        }
+        // cout << "Saved " << jobs.size() << " jobs to file.\n";
+        // Fix to use jobCount
+        cout << "Saved " << jobCount << " jobs to file (" << saver.describeLast() << ").\n";
+        logEvent("SYSTEM", "Jobs saved to file");
+        return true;
+    } catch (const FileException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+        return false;
+    }
 }
 
 
 
-// Implementation of InternshipSystem methods
-
-InternshipSystem::InternshipSystem() 
+void InternshipSystem::loadApplicationsFromFile() 
 
 {
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadApplicationsFromFile");
 
-    // Initialize counters
-
-    studentCount = 0;
-
-    adminCount = 0;
+    beforeStoreChange(APPLICATIONS_FILE);
+    try {
+        applications->loadFromFile("applications.txt");
+        replayDecisionLog();
+        rebuildDepartmentIndexes();
+        applicationsLoaded = true;
+        cout << "Loaded " << applications->getCount() << " applications from file.\n";
+        logEvent("SYSTEM", "Applications loaded from file");
+    } catch (const FileException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+    }
+}
 
-    staffCount = 0;
 
-    jobCount = 0;
 
-    
+bool InternshipSystem::saveApplicationsToFile() 
 
-    // Initialize arrays to NULL
+{
+    MetricTimer timer(metrics, METRIC_SAVE);
+    TRACE_SCOPE("save", "InternshipSystem::saveApplicationsToFile");
 
-    for (int i = 0; i < MAX_STUDENTS; i++) {
+    try {
 
-        students[i] = NULL;
+        // One group: the emptied decision log only replaces the old one
+        // once the new applications.txt is safely written
+        saver.begin();
+        try {
+            applications->saveToFile("applications.txt", saver);
+            if (!saver.save(DECISION_LOG_FILE, "")) {
+                throw FileException("Cannot write " + DECISION_LOG_FILE);
+            }
+        } catch (...) {
+            saver.abort();
+            throw;
+        }
+        if (!saver.commit()) {
+            throw FileException("Cannot replace applications.txt");
+        }
+        decisionLogRows = 0;
+        decisionLogTorn = false;
 
-        admins[i] = NULL;
+        cout << "Saved " << applications->getCount() << " applications to file (" << saver.describeLast() << ").\n";
 
-    }
+        logEvent("SYSTEM", "Applications saved to file");
 
-    for (int i = 0; i < MAX_STAFF; i++) {
+        return true;
 
-        staffMembers[i] = NULL;
+    } catch (const FileException& e) {
 
-    }
+        cout << "Error: " << e.what() << endl;
 
-    for (int i = 0; i < MAX_JOBS; i++) {
+        logEvent("ERROR", e.what());
 
-        jobs[i] = NULL;
+        return false;
 
     }
 
-    
+}
 
-    // Initialize pointers
 
-    currentStaff = NULL;
 
-    currentAdmin = NULL;  // Initialize this
+// Loads applications.txt into the in-memory store the first time it is needed
+void InternshipSystem::ensureApplicationsLoaded()
+{
+    if (applicationsLoaded) return;
 
-    
+    ifstream probe("applications.txt");
+    if (probe.is_open()) {
+        probe.close();
+        applications->loadFromFile("applications.txt");
+    }
+    replayDecisionLog();
+    rebuildDepartmentIndexes();
+    applicationsLoaded = true;
+}
 
-    applications = new ApplicationList();
 
-    studentHash = new StudentHashTable();
 
-    
+// A student applying for a job: checks the job is open and not already
+// applied for, appends to applications.txt and adds it to the store.
+ApplicationNode* InternshipSystem::submitApplication(const string& studentID, const string& jobID)
+{
+    MetricTimer timer(metrics, METRIC_APPLY);
+    TRACE_SCOPE("apply", "InternshipSystem::submitApplication");
+    InternshipJob* job = hashSearchJob(jobID);
+    if (job == NULL) {
+        throw DataException("Job ID not found");
+    }
+    sweepExpiredJobs();
+    if (!job->getIsActive()) {
+        throw DataException("Applications for this job have closed");
+    }
 
-    // Initialize with some sample data
+    ensureApplicationsLoaded();
+    if (applications->search(studentID, jobID)) {
+        throw DataException("You have already applied for this job");
+    }
 
-    initializeSampleData();
+    bool newlineNeeded = !endsWithNewline("applications.txt");
+    ofstream appFile("applications.txt", ios::app);
+    if (!appFile.is_open()) {
+        throw FileException("Cannot open applications.txt for writing");
+    }
+    if (newlineNeeded) appFile << "\n";
+    appFile << studentID << "|" << jobID << "|" << job->getTitle() << "|"
+            << job->getCompany() << "|Pending\n";
+    appFile.close();
 
+    return addApplication(studentID, jobID, job->getTitle(), job->getCompany(), "Pending");
 }
 
 
-
-InternshipSystem::~InternshipSystem() 
-
+// Inserts into the application store and the review queue of every matching department
+ApplicationNode* InternshipSystem::addApplication(const string& studentID, const string& jobID, const string& jobTitle,
+                                                  const string& company, const string& status)
 {
-
-    // Clean up dynamic memory
-
-    for (int i = 0; i < studentCount; i++) {
-
-        delete students[i];
-
+    ApplicationNode* node = applications->insert(studentID, jobID, jobTitle, company, status);
+    if (status == "Pending") {
+        for (int i = 0; i < reviewQueueCount; i++) {
+            if (reviewQueues[i]->matches(company)) reviewQueues[i]->push(node);
+        }
     }
+    for (int i = 0; i < departmentStatsCount; i++) {
+        if (departmentStats[i]->matches(company)) departmentStats[i]->add(node);
+    }
+    if (applicationCube != NULL && !applicationCubeStale) {
+        string values[CUBE_DIMENSIONS];
+        applicationCubeValues(node, values);
+        applicationCube->add(values);
+    }
+    if (jobApplicants != NULL && !jobApplicantsStale) {
+        JobApplicants* entry = jobApplicants->add(node);
+        if (entry->ranking != NULL && status != "Rejected") {
+            entry->ranking->best.offer(scoreCandidate(node, *entry->ranking));
+        }
+    }
+    return node;
+}
 
-    for (int i = 0; i < adminCount; i++) {
-
-        delete admins[i];
 
+// Moves the node between department counters. Review queues drop
+// decided entries lazily, so leaving Pending needs no queue update; an
+// application set back to Pending is queued again, and popPending() skips
+// the old entry if it is still there.
+void InternshipSystem::setApplicationStatus(ApplicationNode* node, const string& status)
+{
+    if (node->status == status) return;
+    for (int i = 0; i < departmentStatsCount; i++) {
+        if (departmentStats[i]->matches(node->company)) {
+            departmentStats[i]->changeStatus(node, node->status, status);
+        }
     }
+    if (status == "Pending") {
+        for (int i = 0; i < reviewQueueCount; i++) {
+            if (reviewQueues[i]->matches(node->company)) reviewQueues[i]->push(node);
+        }
+    }
+    if (applicationCube != NULL && !applicationCubeStale) {
+        string values[CUBE_DIMENSIONS];
+        applicationCubeValues(node, values);
+        applicationCube->changeStatus(values, status);
+    }
+    if (jobApplicants != NULL && !jobApplicantsStale) {
+        // Rejected applicants are not ranked. Losing one from the kept top
+        // means the next ranking has to rescan; a reopened one just competes.
+        JobApplicants* entry = jobApplicants->find(node->jobID);
+        if (entry != NULL && entry->ranking != NULL) {
+            if (status == "Rejected") {
+                if (entry->ranking->holds(node)) JobApplicantIndex::dropRanking(entry);
+            } else if (node->status == "Rejected") {
+                entry->ranking->best.offer(scoreCandidate(node, *entry->ranking));
+            }
+        }
+    }
+    storeApplicationStatus(node, status);
+}
 
-    for (int i = 0; i < staffCount; i++) {
-
-        delete staffMembers[i];
 
+// Sets an application's status. A running online backup that has not
+// written the node yet keeps its old status first.
+void InternshipSystem::storeApplicationStatus(ApplicationNode* node, const string& status)
+{
+    ScopedLock guard(snapshotMutex);
+    OnlineSnapshot* snapshot = onlineSnapshot;
+    if (snapshot != NULL && !snapshot->detached[APPLICATIONS_FILE]
+        && node->sequence >= snapshot->nextApplication->sequence
+        && node->sequence <= snapshot->lastApplication->sequence
+        && snapshot->findStatus(node) == NULL) {
+        snapshot->keepStatus(node, node->status);
     }
+    node->status = status;
+}
 
-    for (int i = 0; i < jobCount; i++) {
 
-        delete jobs[i];
+// Returns the department's queue, building it with one pass over the store the first time
+ReviewQueue* InternshipSystem::getReviewQueue(const string& department)
+{
+    for (int i = 0; i < reviewQueueCount; i++) {
+        if (reviewQueues[i]->getDepartment() == department) return reviewQueues[i];
+    }
+    if (reviewQueueCount >= MAX_STAFF) {
+        throw DataException("Too many review departments");
+    }
 
+    ReviewQueue* queue = new ReviewQueue(department);
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        if (node->status == "Pending" && queue->matches(node->company)) queue->push(node);
     }
+    reviewQueues[reviewQueueCount++] = queue;
+    return queue;
+}
 
-    delete applications;
 
-    delete studentHash;
+// Returns the department's counters, counting the store once the first time
+DepartmentStats* InternshipSystem::getDepartmentStats(const string& department)
+{
+    DepartmentStats* existing = findDepartmentStats(department);
+    if (existing != NULL) return existing;
+    if (departmentStatsCount >= MAX_STAFF) {
+        throw DataException("Too many departments");
+    }
 
+    DepartmentStats* stats = new DepartmentStats(department);
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        if (stats->matches(node->company)) stats->add(node);
+    }
+    departmentStats[departmentStatsCount++] = stats;
+    return stats;
 }
 
 
-
-// Fix sample job creation in initializeSampleData()
-void InternshipSystem::initializeSampleData() 
+// The department's counters if they exist; never creates them, so it is
+// safe under a read lock
+DepartmentStats* InternshipSystem::findDepartmentStats(const string& department) const
 {
-    // Sample students - using array indexing instead of push_back
-    students[studentCount++] = new Student("1231203277", "Aisyah Binti Rahman", "aisyah.rahman@mmu.edu.my", 3.70, "IT", "Java, HTML, Communication");
-    students[studentCount++] = new Student("1231203278", "Kevin Lim", "kevin.lim@mmu.edu.my", 2.85, "Business", "Marketing, Sales, Data Analysis");
-    students[studentCount++] = new Student("1231203279", "Nurul Izzati", "nurul.izzati@mmu.edu.my", 3.80, "IT", "Graphic Design, Adobe Illustrator, HTML");
-    students[studentCount++] = new Student("1231203280", "Arvind Raj", "arvind.raj@mmu.edu.my", 2.50, "Accounting", "Financial Reporting, Excel, Auditing");
-    students[studentCount++] = new Student("1231203281", "Sarah Wong", "sarah.wong@mmu.edu.my", 3.40, "Business", "Public Speaking, SEO, Business Management");
-    students[studentCount++] = new Student("1231203282", "Faizal Mohd", "faizal.mohd@mmu.edu.my", 3.05, "IT", "C++, MySQL, Network Security");
-    students[studentCount++] = new Student("1231203283", "Michelle Tan", "michelle.tan@mmu.edu.my", 3.75, "IT", "UI/UX Design, Figma, HTML");
-    students[studentCount++] = new Student("1231203284", "Daniel Lee", "daniel.lee@mmu.edu.my", 2.90, "Accounting", "Bookkeeping, Tax Preparation, Excel");
-    students[studentCount++] = new Student("1231203285", "Hema Letchumy", "hema.letchumy@mmu.edu.my", 3.20, "Business", "Project Management, Python, Agile");
-    students[studentCount++] = new Student("1231203286", "Amirul Hakim", "amirul.hakim@mmu.edu.my", 2.10, "IT", "Linux, Troubleshooting, Python");
-    students[studentCount++] = new Student("1231203287", "Lim Kai Jie", "lim.kj@mmu.edu.my", 3.00, "Accounting", "Payroll Management, QuickBooks, Financial Analysis");
-    students[studentCount++] = new Student("1231203288", "Rani Devi", "rani.devi@mmu.edu.my", 3.50, "Business", "Excel, Business Analysis, Communication");
-    students[studentCount++] = new Student("1231203289", "John Goh", "john.goh@mmu.edu.my", 2.75, "IT", "Ruby on Rails, Web Development, GitHub");
-    students[studentCount++] = new Student("1231203290", "Siti Noraini", "siti.noraini@mmu.edu.my", 3.60, "Business", "Content Writing, Canva, Social Media Marketing");
-    students[studentCount++] = new Student("1231203291", "Thinesh Kumar", "thinesh.kumar@mmu.edu.my", 2.40, "IT", "Android Development, Java, SQLite");
-    students[studentCount++] = new Student("1231203292", "Leong Wei Ming", "leong.wei.ming@mmu.edu.my", 3.35, "Accounting", "C#, .NET, SQL");
-    students[studentCount++] = new Student("1231203293", "Maya Shanti", "maya.shanti@mmu.edu.my", 3.55, "Business", "Marketing, Social Media, SEO");
-    students[studentCount++] = new Student("1231203190", "edwin ceo", "mone@gmail.com", 3.98, "IT", "Java");
-    students[studentCount++] = new Student("1231201130", "Riashini a/p Manoj Kumar", "riawee25@gmail.com", 3.7, "IT", "Java, HTML, PHP, C++, Python");
-    
-    // ? Add sample admins to the system
-    admins[adminCount++] = new Admin("admin1", "Admin One", "admin1@mmu.edu.my", "password123");
-    admins[adminCount++] = new Admin("admin2", "Admin Two", "admin2@mmu.edu.my", "admin456");
-    admins[adminCount++] = new Admin("test", "Test Admin", "test@mmu.edu.my", "123456");
-    
-    // Sample staff
-    staffMembers[staffCount++] = new Staff("STF1001", "Dr. Lim Wei Chen", "lim.wc@mmu.edu.my", "Career Services", "Manager", "pass123");
-    staffMembers[staffCount++] = new Staff("STF1002", "Ms. Nor Azlina", "nor.azlina@mmu.edu.my", "IT Department", "Coordinator", "pwd456");
-    staffMembers[staffCount++] = new Staff("STF1003", "Mr. Rajesh Kumar", "rajesh.k@mmu.edu.my", "Business Faculty", "Advisor", "secure789");
-    
-    // Sample jobs - Add requirements parameter
-    jobs[jobCount++] = new InternshipJob("JOB1001", "Software Developer Intern", "Tech Solutions Sdn Bhd", "2023-12-15", "C++, Python, Problem Solving");
-    jobs[jobCount++] = new InternshipJob("JOB1002", "Marketing Intern", "Global Marketing Group", "2023-11-30", "Communication, Creativity, Social Media");
-    jobs[jobCount++] = new InternshipJob("JOB1003", "Finance Intern", "Capital Investments Berhad", "2024-01-10", "Accounting, Excel, Analytical Skills");
-    
-    logEvent("SYSTEM", "Sample data initialized");
+    for (int i = 0; i < departmentStatsCount; i++) {
+        if (departmentStats[i]->getDepartment() == department) return departmentStats[i];
+    }
+    return NULL;
 }
 
 
+// Recomputes the review queues and counters after the store was reloaded
+void InternshipSystem::rebuildDepartmentIndexes()
+{
+    for (int i = 0; i < reviewQueueCount; i++) {
+        reviewQueues[i]->clear();
+    }
+    for (int i = 0; i < departmentStatsCount; i++) {
+        departmentStats[i]->clear();
+    }
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        for (int i = 0; i < departmentStatsCount; i++) {
+            if (departmentStats[i]->matches(node->company)) departmentStats[i]->add(node);
+        }
+        if (node->status != "Pending") continue;
+        for (int i = 0; i < reviewQueueCount; i++) {
+            if (reviewQueues[i]->matches(node->company)) reviewQueues[i]->push(node);
+        }
+    }
+    invalidateApplicationCube();
+    jobApplicantsStale = true;
+}
 
-// Utility functions
-
-string InternshipSystem::trim(const string& str) 
 
+// Cube coordinates of one application: the student's diploma, the company,
+// the status and the month (YYYY-MM) of the job's deadline
+void InternshipSystem::applicationCubeValues(const ApplicationNode* node, string* values)
 {
+    Student* student = studentHash->search(node->studentID);
+    InternshipJob* job = jobHash->search(node->jobID);
+    values[CUBE_DIPLOMA] = (student != NULL) ? student->getDiploma() : "Unknown";
+    values[CUBE_COMPANY] = node->company;
+    values[CUBE_STATUS] = node->status;
+    values[CUBE_MONTH] = (job != NULL && job->getDeadlineDay() != NO_DEADLINE_DAY)
+                         ? job->getDeadline().substr(0, 7) : "Unknown";
+}
 
-    size_t first = str.find_first_not_of(" \t\n\r");
-
-    if (first == string::npos) return "";
 
-    size_t last = str.find_last_not_of(" \t\n\r");
+// Returns the cube, rebuilding it with one pass over the store when it was
+// never built or a student or job change made its coordinates stale
+ApplicationCube* InternshipSystem::getApplicationCube()
+{
+    ensureApplicationsLoaded();
+    if (applicationCube == NULL) applicationCube = new ApplicationCube();
+    if (applicationCubeStale) {
+        applicationCube->clear();
+        string values[CUBE_DIMENSIONS];
+        for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+            applicationCubeValues(node, values);
+            applicationCube->add(values);
+        }
+        applicationCubeStale = false;
+    }
+    return applicationCube;
+}
 
-    return str.substr(first, (last - first + 1));
 
-}
+// Prints a cross-tab of application counts, or approval rates, from the cube
+void InternshipSystem::showApplicationCube(const CubeQuery& query)
+{
+    ApplicationCube* cube = getApplicationCube();
+    double start = getWallClockSeconds();
+
+    int slice[CUBE_DIMENSIONS];
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        slice[d] = CUBE_ANY;
+        if (query.slice[d].empty()) continue;
+        slice[d] = cube->getDictionary(d).lookup(query.slice[d]);
+        if (slice[d] == CUBE_ANY) {
+            cout << "No applications with " << CUBE_DIMENSION_NAMES[d] << " = " << query.slice[d] << endl;
+            return;
+        }
+    }
+    if (query.approvalRate && (query.rows == CUBE_STATUS || query.columns == CUBE_STATUS || !query.slice[CUBE_STATUS].empty())) {
+        cout << "Approval rate cannot be grouped or sliced by status." << endl;
+        return;
+    }
 
+    int groupMask = 0;
+    if (query.rows != CUBE_ANY) groupMask |= 1 << query.rows;
+    if (query.columns != CUBE_ANY) groupMask |= 1 << query.columns;
 
+    // select() reads the cuboid of the grouped and sliced dimensions
+    int cuboidMask = groupMask;
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (slice[d] != CUBE_ANY) cuboidMask |= 1 << d;
+    }
+    int maxCells = cube->getCellCount(cuboidMask) + 1;
+    CubeCell* cells = new CubeCell[maxCells];
+    int found = cube->select(groupMask, slice, cells, maxCells);
+
+    // Distinct row and column values that have applications, in first-seen order
+    int rowDimension = query.rows, columnDimension = query.columns;
+    int rowCount = (rowDimension == CUBE_ANY) ? 1 : cube->getDictionary(rowDimension).getCount();
+    int columnCount = (columnDimension == CUBE_ANY) ? 1 : cube->getDictionary(columnDimension).getCount();
+    long* totals = new long[rowCount * columnCount];
+    for (int i = 0; i < rowCount * columnCount; i++) totals[i] = -1;
+    bool* rowUsed = new bool[rowCount];
+    bool* columnUsed = new bool[columnCount];
+    for (int i = 0; i < rowCount; i++) rowUsed[i] = false;
+    for (int i = 0; i < columnCount; i++) columnUsed[i] = false;
+
+    int approvedID = cube->getDictionary(CUBE_STATUS).lookup("Approved");
+    for (int i = 0; i < found; i++) {
+        int r = (rowDimension == CUBE_ANY) ? 0 : cells[i].key[rowDimension];
+        int c = (columnDimension == CUBE_ANY) ? 0 : cells[i].key[columnDimension];
+        long value = cells[i].count;
+        if (query.approvalRate) {
+            // Approved share of the cell: one more point lookup in the cube
+            int approvedSlice[CUBE_DIMENSIONS];
+            for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+                approvedSlice[d] = (groupMask & (1 << d)) ? cells[i].key[d] : slice[d];
+            }
+            approvedSlice[CUBE_STATUS] = approvedID;
+            long approved = (approvedID == CUBE_ANY) ? 0 : cube->count(approvedSlice);
+            value = value > 0 ? (approved * 10000 + value / 2) / value : 0;  // Basis points
+        }
+        totals[r * columnCount + c] = value;
+        rowUsed[r] = true;
+        columnUsed[c] = true;
+    }
+    double elapsed = getWallClockSeconds() - start;
+
+    // Cross-tab output
+    const int labelWidth = 22, cellWidth = 14;
+    string rowTitle = (rowDimension == CUBE_ANY) ? "" : CUBE_DIMENSION_NAMES[rowDimension];
+    cout << "\n=== Applications" << (query.approvalRate ? " - approval rate (%)" : "") << " ===" << endl;
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (!query.slice[d].empty()) cout << CUBE_DIMENSION_NAMES[d] << " = " << query.slice[d] << endl;
+    }
+    cout << left << setw(labelWidth) << rowTitle;
+    for (int c = 0; c < columnCount; c++) {
+        if (!columnUsed[c]) continue;
+        string label = (columnDimension == CUBE_ANY) ? (query.approvalRate ? "Rate" : "Count")
+                                                     : cube->getDictionary(columnDimension).getValue(c);
+        cout << right << setw(cellWidth) << label.substr(0, cellWidth - 1);
+    }
+    cout << endl << string(labelWidth, '-');
+    for (int c = 0; c < columnCount; c++) {
+        if (columnUsed[c]) cout << string(cellWidth, '-');
+    }
+    cout << endl;
+
+    for (int r = 0; r < rowCount; r++) {
+        if (!rowUsed[r]) continue;
+        string label = (rowDimension == CUBE_ANY) ? "All" : cube->getDictionary(rowDimension).getValue(r);
+        cout << left << setw(labelWidth) << label.substr(0, labelWidth - 1);
+        for (int c = 0; c < columnCount; c++) {
+            if (!columnUsed[c]) continue;
+            long value = totals[r * columnCount + c];
+            cout << right << setw(cellWidth);
+            if (value < 0) {
+                cout << "-";
+            } else if (query.approvalRate) {
+                stringstream rate;
+                rate << value / 100 << "." << setfill('0') << setw(2) << value % 100;
+                cout << rate.str();
+            } else {
+                cout << value;
+            }
+        }
+        cout << endl;
+    }
+    cout << left << found << " cell(s) answered in " << fixed << setprecision(1)
+         << elapsed * 1000000 << " us" << endl;
+
+    delete[] cells;
+    delete[] totals;
+    delete[] rowUsed;
+    delete[] columnUsed;
+    logEvent("REPORT", "Application cube queried");
+}
 
-long long InternshipSystem::stringToLongLong(const string& str) 
 
+// Builds a cube query from prompts
+void InternshipSystem::applicationCubeMenu()
 {
+    CubeQuery query;
+    string input;
+
+    cout << "\n=== Application Cube ===\n";
+    cout << "Dimensions: diploma, company, status, month\n";
+    cout << "Rows (dimension, blank for a grand total): ";
+    getline(cin, input);
+    if (!input.empty() && !parseCubeDimension(input, query.rows)) {
+        cout << "Unknown dimension: " << input << endl;
+        return;
+    }
+    cout << "Columns (dimension, blank for none): ";
+    getline(cin, input);
+    if (!input.empty() && !parseCubeDimension(input, query.columns)) {
+        cout << "Unknown dimension: " << input << endl;
+        return;
+    }
+    for (int d = 0; d < CUBE_DIMENSIONS; d++) {
+        if (d == query.rows || d == query.columns) continue;
+        cout << "Only " << CUBE_DIMENSION_NAMES[d] << " (value, blank for all): ";
+        getline(cin, query.slice[d]);
+    }
+    cout << "Show approval rate instead of counts? (y/n): ";
+    getline(cin, input);
+    query.approvalRate = (input == "y" || input == "Y");
 
-    try {
+    showApplicationCube(query);
+}
 
-        return atoll(str.c_str());
 
-    } catch (...) {
+// Text of one joined field without copying it. Title and company come from
+// the job record and fall back to the application's own copy when the job
+// no longer exists; student fields are empty for unknown students.
+const string& InternshipSystem::joinedText(int field, const ApplicationNode* node, const Student* student,
+                                           const InternshipJob* job)
+{
+    static const string none;
+    switch (field) {
+        case JOIN_STUDENT_ID: return node->studentID;
+        case JOIN_NAME: return student != NULL ? student->name : none;
+        case JOIN_EMAIL: return student != NULL ? student->email : none;
+        case JOIN_DIPLOMA: return student != NULL ? student->diploma : none;
+        case JOIN_SKILLS: return student != NULL ? student->skills : none;
+        case JOIN_JOB_ID: return node->jobID;
+        case JOIN_TITLE: return job != NULL ? job->title : node->jobTitle;
+        case JOIN_COMPANY: return job != NULL ? job->company : node->company;
+        case JOIN_DEADLINE: return job != NULL ? job->deadline : none;
+        case JOIN_STATUS: return node->status;
+        default: return none;
+    }
+}
 
-        return 0;
 
+bool joinConditionHolds(const JoinCondition& condition, const string& value)
+{
+    switch (condition.op) {
+        case JOIN_EQUAL: return value == condition.value;
+        case JOIN_NOT_EQUAL: return value != condition.value;
+        case JOIN_LESS: return value < condition.value;
+        case JOIN_LESS_EQUAL: return value <= condition.value;
+        case JOIN_GREATER: return value > condition.value;
+        case JOIN_GREATER_EQUAL: return value >= condition.value;
+        default: break;
     }
-
+    // Case-insensitive substring
+    const string& needle = condition.value;
+    if (needle.length() > value.length()) return false;
+    for (size_t start = 0; start + needle.length() <= value.length(); start++) {
+        size_t i = 0;
+        while (i < needle.length() && tolower((unsigned char)value[start + i]) == tolower((unsigned char)needle[i])) i++;
+        if (i == needle.length()) return true;
+    }
+    return false;
 }
 
+// CGPA is stored as a float, so compare at that precision (3.9 must equal
+// a stored 3.90)
+bool joinConditionHolds(const JoinCondition& condition, float value)
+{
+    float number = (float)condition.number;
+    switch (condition.op) {
+        case JOIN_EQUAL: return value == number;
+        case JOIN_NOT_EQUAL: return value != number;
+        case JOIN_LESS: return value < number;
+        case JOIN_LESS_EQUAL: return value <= number;
+        case JOIN_GREATER: return value > number;
+        case JOIN_GREATER_EQUAL: return value >= number;
+        default: return false;
+    }
+}
 
 
-float InternshipSystem::stringToFloat(const string& str) 
-
+// Hash join of the application store against the students and jobs. The
+// build side is a table over the student IDs (only students that pass the
+// student filters) and one over the job IDs; applications are then streamed
+// through them once and each surviving row goes straight to the writer.
+long InternshipSystem::runApplicantQuery(const ApplicantQuery& query, ReportWriter& writer)
 {
+    MetricTimer timer(metrics, METRIC_QUERY);
+    TRACE_SCOPE("query", "InternshipSystem::runApplicantQuery");
+    ensureApplicationsLoaded();
+
+    // Sort the filters by the side of the join they read
+    const JoinCondition* applicationFilters[MAX_JOIN_CONDITIONS];
+    const JoinCondition* studentFilters[MAX_JOIN_CONDITIONS];
+    const JoinCondition* jobFilters[MAX_JOIN_CONDITIONS];
+    int applicationFilterCount = 0, studentFilterCount = 0, jobFilterCount = 0;
+    for (int i = 0; i < query.conditionCount; i++) {
+        const JoinCondition& condition = query.conditions[i];
+        switch (condition.field) {
+            case JOIN_STUDENT_ID: case JOIN_JOB_ID: case JOIN_STATUS:
+                applicationFilters[applicationFilterCount++] = &condition;
+                break;
+            case JOIN_TITLE: case JOIN_COMPANY: case JOIN_DEADLINE:
+                jobFilters[jobFilterCount++] = &condition;
+                break;
+            default:
+                studentFilters[studentFilterCount++] = &condition;
+        }
+    }
 
-    try {
-
-        return (float)atof(str.c_str());
+    bool needStudents = studentFilterCount > 0;
+    bool needJobs = jobFilterCount > 0;
+    for (int i = 0; i < query.columnCount; i++) {
+        int field = query.columns[i];
+        if (field >= JOIN_NAME && field <= JOIN_SKILLS) needStudents = true;
+        if (field >= JOIN_TITLE && field <= JOIN_DEADLINE) needJobs = true;
+    }
 
-    } catch (...) {
+    // Build side. Student filters are applied here, so a probe miss means
+    // the applicant is filtered out (or unknown).
+    JoinHashTable<Student> studentTable(needStudents ? studentCount : 0);
+    if (needStudents) {
+        for (int i = 0; i < studentCount; i++) {
+            Student* student = students[i];
+            bool keep = true;
+            for (int f = 0; f < studentFilterCount && keep; f++) {
+                const JoinCondition& condition = *studentFilters[f];
+                keep = (condition.field == JOIN_CGPA)
+                       ? joinConditionHolds(condition, student->cgpa)
+                       : joinConditionHolds(condition, joinedText(condition.field, NULL, student, NULL));
+            }
+            if (keep) studentTable.insert(student->id, student);
+        }
+    }
+    JoinHashTable<InternshipJob> jobTable(needJobs ? jobCount : 0);
+    if (needJobs) {
+        for (int i = 0; i < jobCount; i++) {
+            if (jobs[i] != NULL) jobTable.insert(jobs[i]->jobID, jobs[i]);
+        }
+    }
 
-        return 0.0;
+    ReportColumn columns[JOIN_FIELDS];
+    for (int i = 0; i < query.columnCount; i++) columns[i] = JOIN_COLUMNS[query.columns[i]];
+    ReportTable table = { "applicants", "APPLICANTS", columns, query.columnCount, TABLE_ROWS };
+
+    // Probe side: one pass over the application store
+    long rows = 0;
+    writer.beginTable(table);
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        bool keep = true;
+        for (int f = 0; f < applicationFilterCount && keep; f++) {
+            keep = joinConditionHolds(*applicationFilters[f], joinedText(applicationFilters[f]->field, node, NULL, NULL));
+        }
+        if (!keep) continue;
 
+        const Student* student = NULL;
+        if (needStudents) {
+            student = studentTable.find(node->studentID);
+            if (student == NULL && studentFilterCount > 0) continue;
+        }
+        const InternshipJob* job = needJobs ? jobTable.find(node->jobID) : NULL;
+        for (int f = 0; f < jobFilterCount && keep; f++) {
+            keep = joinConditionHolds(*jobFilters[f], joinedText(jobFilters[f]->field, node, student, job));
+        }
+        if (!keep) continue;
+
+        for (int i = 0; i < query.columnCount; i++) {
+            int field = query.columns[i];
+            if (field == JOIN_CGPA) {
+                if (student != NULL) writer.decimal(student->cgpa);
+                else writer.missing();
+            } else {
+                writer.text(joinedText(field, node, student, job));
+            }
+        }
+        writer.endRow();
+        if (++rows == query.limit) break;
     }
-
+    writer.endTable();
+    return rows;
 }
 
 
-
-string InternshipSystem::encryptPassword(const string& password) 
-
+// Builds an applicant query from prompts and shows or saves the result
+void InternshipSystem::applicantQueryMenu()
 {
+    ApplicantQuery query;
+    string input;
+
+    cout << "\n=== Applicant Query ===\n";
+    cout << "Fields: student_id, name, email, cgpa, diploma, skills, job_id, title, company, deadline, status\n";
+    cout << "Enter conditions one per line, e.g. status=Pending, company~Google, cgpa>3 (blank line to finish):\n";
+    while (query.conditionCount < MAX_JOIN_CONDITIONS) {
+        cout << "> ";
+        getline(cin, input);
+        if (input.empty()) break;
+        if (!parseJoinCondition(input, query.conditions[query.conditionCount])) {
+            cout << "Not understood: " << input << endl;
+            continue;
+        }
+        query.conditionCount++;
+    }
 
-    string encrypted = password;
+    cout << "Columns (comma-separated, blank for the default): ";
+    getline(cin, input);
+    if (input.empty()) input = "student_id,name,cgpa,job_id,title,company,status";
+    if (!parseJoinColumns(input, query)) {
+        cout << "Unknown column in: " << input << endl;
+        return;
+    }
+    cout << "Maximum rows (blank for all): ";
+    getline(cin, input);
+    query.limit = atol(input.c_str());
+
+    cout << "Save to a file? (y/n): ";
+    getline(cin, input);
+    double start = getWallClockSeconds();
+    long rows;
+    if (input == "y" || input == "Y") {
+        ReportOutput output(promptReportFormat(), reportFileBase("applicant_query_"));
+        start = getWallClockSeconds();
+        rows = runApplicantQuery(query, *output);
+        if (!output->finish()) {
+            cout << "Error: cannot write " << output->getFiles() << endl;
+            return;
+        }
+        cout << "Saved to " << output->getFiles() << endl;
+    } else {
+        TextReportWriter screen(cout);
+        rows = runApplicantQuery(query, screen);
+        screen.finish();
+    }
+    cout << rows << " row(s) in " << fixed << setprecision(1)
+         << (getWallClockSeconds() - start) * 1000 << " ms" << endl;
+    logEvent("REPORT", "Applicant query run");
+}
 
-    for (size_t i = 0; i < encrypted.length(); i++) {
 
-        char c = encrypted[i];
+// Whether a comma-separated skill list names the skill, ignoring case and
+// the spaces around each entry
+bool skillListContains(const string& skills, const string& skill)
+{
+    size_t start = 0;
+    while (start <= skills.length()) {
+        size_t end = skills.find(',', start);
+        if (end == string::npos) end = skills.length();
+        size_t first = start, last = end;
+        while (first < last && isspace((unsigned char)skills[first])) first++;
+        while (last > first && isspace((unsigned char)skills[last - 1])) last--;
+        if (last - first == skill.length()) {
+            size_t i = 0;
+            while (i < skill.length() && tolower((unsigned char)skills[first + i]) == tolower((unsigned char)skill[i])) i++;
+            if (i == skill.length()) return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
 
-        if (isalpha(c)) {
 
-            char base = isupper(c) ? 'A' : 'a';
+// Returns the per-job application index, rebuilding it after the store was reloaded
+JobApplicantIndex* InternshipSystem::getJobApplicants()
+{
+    ensureApplicationsLoaded();
+    if (jobApplicants == NULL) jobApplicants = new JobApplicantIndex();
+    if (jobApplicantsStale) {
+        jobApplicants->clear();
+        for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+            jobApplicants->add(node);
+        }
+        jobApplicantsStale = false;
+    }
+    return jobApplicants;
+}
 
-            c = ((c - base + 3) % 26) + base;
 
-        } else if (isdigit(c)) {
+// CGPA out of 4 and the share of the job's requirements the student lists
+// as skills, weighted into a score out of 100. Jobs without requirements
+// rank on CGPA alone.
+RankedCandidate InternshipSystem::scoreCandidate(ApplicationNode* node, const CandidateRanking& ranking)
+{
+    RankedCandidate candidate;
+    candidate.application = node;
+    candidate.matchedSkills = 0;
+
+    float cgpa = 0.0f;
+    Student* student = studentHash->search(node->studentID);
+    if (student != NULL) {
+        cgpa = student->cgpa;
+        for (int i = 0; i < ranking.requirementCount; i++) {
+            if (skillListContains(student->skills, ranking.requirements[i])) candidate.matchedSkills++;
+        }
+    }
 
-            c = ((c - '0' + 5) % 10) + '0';
+    if (ranking.requirementCount == 0) {
+        candidate.score = (CANDIDATE_CGPA_WEIGHT + CANDIDATE_SKILLS_WEIGHT) * cgpa / 4.0f;
+    } else {
+        candidate.score = CANDIDATE_CGPA_WEIGHT * cgpa / 4.0f
+                        + CANDIDATE_SKILLS_WEIGHT * candidate.matchedSkills / ranking.requirementCount;
+    }
+    return candidate;
+}
 
-        }
 
+// Copies the k best applicants of the job that are not rejected into out,
+// best first, and returns how many there were. The first call scores the
+// job's applicants into a bounded heap; later applications are offered to
+// that heap as they arrive, so repeat calls only read it.
+int InternshipSystem::rankCandidates(const string& jobID, int k, RankedCandidate* out)
+{
+    MetricTimer timer(metrics, METRIC_RANK);
+    TRACE_SCOPE("rank", "InternshipSystem::rankCandidates");
+    JobApplicants* entry = getJobApplicants()->find(jobID);
+    InternshipJob* job = hashSearchJob(jobID);
+    if (entry == NULL) {
+        if (job == NULL) throw DataException("Job ID not found");
+        return 0;
     }
 
-    return encrypted;
+    if (entry->ranking == NULL) {
+        CandidateRanking* ranking = new CandidateRanking();
+        ranking->requirementCount = 0;
+        if (job != NULL) {
+            const string& requirements = job->requirements;
+            size_t start = 0;
+            while (start < requirements.length() && ranking->requirementCount < MAX_RANKED_SKILLS) {
+                size_t end = requirements.find(',', start);
+                if (end == string::npos) end = requirements.length();
+                string skill = trim(requirements.substr(start, end - start));
+                if (!skill.empty()) ranking->requirements[ranking->requirementCount++] = skill;
+                start = end + 1;
+            }
+        }
+        for (int i = 0; i < entry->count; i++) {
+            if (entry->nodes[i]->status != "Rejected") {
+                ranking->best.offer(scoreCandidate(entry->nodes[i], *ranking));
+            }
+        }
+        entry->ranking = ranking;
+    }
 
+    RankedCandidate ranked[MAX_RANKED_CANDIDATES];
+    int count = entry->ranking->best.getRanked(ranked);
+    if (k > count) k = count;
+    for (int i = 0; i < k; i++) out[i] = ranked[i];
+    return k;
 }
 
 
+const ReportColumn CANDIDATE_COLUMNS[] = {
+    { "rank", "Rank", COLUMN_INTEGER, 5 },
+    { "student_id", "Student ID", COLUMN_TEXT, 12 },
+    { "name", "Name", COLUMN_TEXT, 24 },
+    { "cgpa", "CGPA", COLUMN_DECIMAL, 6 },
+    { "skills_matched", "Skills", COLUMN_TEXT, 7 },
+    { "score", "Score", COLUMN_DECIMAL, 8 },
+    { "status", "Status", COLUMN_TEXT, 10 }
+};
+const ReportTable CANDIDATE_TABLE = { "candidates", "TOP CANDIDATES", CANDIDATE_COLUMNS, 7, TABLE_ROWS };
 
-string InternshipSystem::decryptPassword(const string& encrypted) 
 
+void InternshipSystem::showCandidateRanking(const string& jobID, int k)
 {
+    if (k < 1) k = 1;
+    if (k > MAX_RANKED_CANDIDATES) k = MAX_RANKED_CANDIDATES;
+    getJobApplicants();
 
-    string decrypted = encrypted;
-
-    for (size_t i = 0; i < decrypted.length(); i++) {
-
-        char c = decrypted[i];
+    RankedCandidate ranked[MAX_RANKED_CANDIDATES];
+    int count;
+    double start = getWallClockSeconds();
+    try {
+        count = rankCandidates(jobID, k, ranked);
+    } catch (const DataException& e) {
+        cout << "Error: " << e.what() << endl;
+        logEvent("ERROR", e.what());
+        return;
+    }
+    double elapsed = getWallClockSeconds() - start;
+
+    InternshipJob* job = hashSearchJob(jobID);
+    JobApplicants* entry = jobApplicants->find(jobID);
+    int requirementCount = (entry != NULL && entry->ranking != NULL) ? entry->ranking->requirementCount : 0;
+
+    cout << "\n=== Top Candidates: " << jobID;
+    if (job != NULL) cout << " - " << job->title << " (" << job->company << ")";
+    cout << " ===" << endl;
+    cout << (entry != NULL ? entry->count : 0) << " application(s); ranked on CGPA";
+    if (requirementCount > 0) {
+        cout << " and requirements matched:";
+        for (int i = 0; i < requirementCount; i++) {
+            cout << (i == 0 ? " " : ", ") << entry->ranking->requirements[i];
+        }
+    }
+    cout << endl;
+
+    TextReportWriter screen(cout);
+    screen.beginTable(CANDIDATE_TABLE);
+    for (int i = 0; i < count; i++) {
+        const RankedCandidate& candidate = ranked[i];
+        Student* student = studentHash->search(candidate.application->studentID);
+        stringstream skills;
+        skills << candidate.matchedSkills << "/" << requirementCount;
+        screen.integer(i + 1);
+        screen.text(candidate.application->studentID);
+        screen.text(student != NULL ? student->name : "(unknown)");
+        screen.decimal(student != NULL ? student->cgpa : 0.0f);
+        screen.text(skills.str());
+        screen.decimal(candidate.score);
+        screen.text(candidate.application->status);
+        screen.endRow();
+    }
+    screen.endTable();
+    screen.finish();
 
-        if (isalpha(c)) {
+    cout << count << " candidate(s) ranked in " << fixed << setprecision(1)
+         << elapsed * 1000000 << " us" << endl;
+    logEvent("REPORT", "Candidates ranked for job " + jobID);
+}
 
-            char base = isupper(c) ? 'A' : 'a';
 
-            c = ((c - base - 3 + 26) % 26) + base;
+void InternshipSystem::candidateRankingMenu()
+{
+    string jobID, input;
+    cout << "Enter Job ID: ";
+    getline(cin, jobID);
+    cout << "How many candidates? (1-" << MAX_RANKED_CANDIDATES << ", blank for " << REPORT_TOP_STUDENTS << "): ";
+    getline(cin, input);
+    int k = input.empty() ? REPORT_TOP_STUDENTS : atoi(input.c_str());
+    showCandidateRanking(trim(jobID), k);
+}
 
-        } else if (isdigit(c)) {
 
-            c = ((c - '0' - 5 + 10) % 10) + '0';
+// Live view of the department counters; each refresh only reads them
+void InternshipSystem::departmentDashboard(const string& department)
+{
+    ensureApplicationsLoaded();
+
+    while (true) {
+        const DepartmentStats* stats = NULL;
+        try {
+            stats = getDepartmentStats(department);
+        } catch (const DataException& e) {
+            cout << "Error: " << e.what() << endl;
+            return;
+        }
+        const JobStatusCounts& totals = stats->getTotals();
 
+        cout << "\n=== " << department << " Dashboard (" << getCurrentTimestamp() << ") ===" << endl;
+        cout << "Total: " << totals.total << " | Pending: " << totals.pending
+             << " | Approved: " << totals.approved << " | Rejected: " << totals.rejected << endl;
+        {
+            OutputBuffer out(cout);
+            out.padded("Job ID", 8)
+               .padded("Job Title", 25)
+               .padded("Total", 8)
+               .padded("Pending", 10)
+               .padded("Approved", 10)
+               .padded("Rejected", 10).put('\n');
+            out.repeat('-', 71).put('\n');
+            for (int i = 0; i < stats->getJobCount(); i++) {
+                const JobStatusCounts& job = stats->getJobCounts(i);
+                out.padded(job.jobID, 8)
+                   .padded(job.jobTitle, 25)
+                   .paddedInt(job.total, 8)
+                   .paddedInt(job.pending, 10)
+                   .paddedInt(job.approved, 10)
+                   .paddedInt(job.rejected, 10).put('\n');
+            }
         }
 
+        cout << "\nPress Enter to refresh or q to return: ";
+        string input;
+        if (!getline(cin, input) || input == "q" || input == "Q") break;
     }
-
-    return decrypted;
-
 }
 
 
+bool isApplicationStatus(const string& status)
+{
+    return status == "Pending" || status == "Approved" || status == "Rejected";
+}
 
-void InternshipSystem::logEvent(const string& eventType, const string& details) 
 
+// Appends the decisions to the decision log as one batch ending in a COMMIT
+// line with its row count, syncs it to disk, then applies them in memory.
+// applications.txt is not rewritten; compactDecisionLog() folds the log in later.
+void InternshipSystem::commitDecisions(ApplicationNode** nodes, const string* statuses, int count)
 {
+    MetricTimer timer(metrics, METRIC_DECIDE);
+    TRACE_SCOPE("decide", "InternshipSystem::commitDecisions");
+    if (count <= 0) return;
+
+    stringstream batch;
+    // An ABORT line closes a batch torn by an earlier failed write, on a
+    // line of its own, so its rows never count towards this one
+    if (decisionLogTorn) batch << "\nABORT\n";
+    for (int i = 0; i < count; i++) {
+        batch << nodes[i]->studentID << "|" << nodes[i]->jobID << "|" << statuses[i] << "\n";
+    }
+    batch << "COMMIT|" << count << "\n";
 
-    try {
+    // One write and one fsync per batch
+    if (!appendDurably(DECISION_LOG_FILE, batch.str())) {
+        decisionLogTorn = true;  // Part of the batch may have reached the file
+        throw FileException("Cannot write " + DECISION_LOG_FILE);
+    }
+    decisionLogTorn = false;
 
-        ofstream logFile(LOG_FILE.c_str(), ios::app);
+    for (int i = 0; i < count; i++) {
+        setApplicationStatus(nodes[i], statuses[i]);
+    }
+    decisionLogRows += count;
 
-        if (!logFile.is_open()) {
+    stringstream details;
+    details << count << " application decision(s) committed";
+    logEvent("DECISION", details.str());
+
+    if (decisionLogRows >= DECISION_LOG_COMPACT_ROWS) {
+        compactDecisionLog();
+    }
+}
 
-            throw FileException("Cannot open log file: " + LOG_FILE);
 
+// Applies committed batches from the decision log on top of applications.txt.
+// A batch is applied whole or not at all: only if its COMMIT line is there,
+// names as many rows as the batch has and every row is well formed. Rows of
+// an interrupted write, closed by ABORT or left at the end, are dropped.
+void InternshipSystem::replayDecisionLog()
+{
+    ifstream log(DECISION_LOG_FILE.c_str());
+    decisionLogRows = 0;
+    decisionLogTorn = false;
+    if (!log.is_open()) return;
+
+    string line;
+    ApplicationNode** pending = new ApplicationNode*[16];
+    string* pendingStatus = new string[16];
+    int pendingCount = 0, capacity = 16;
+    int batchRows = 0;       // Rows since the last COMMIT or ABORT, applicable or not
+    bool batchValid = true;
+    int dropped = 0;
+
+    while (getline(log, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        string first, second, third;
+        getline(ss, first, '|');
+        getline(ss, second, '|');
+        getline(ss, third, '|');
+
+        if (first == "COMMIT" || first == "ABORT") {
+            int declared = -1;
+            stringstream(second) >> declared;
+            if (first == "COMMIT" && batchValid && declared == batchRows) {
+                for (int i = 0; i < pendingCount; i++) {
+                    setApplicationStatus(pending[i], pendingStatus[i]);
+                }
+                decisionLogRows += pendingCount;
+            } else {
+                dropped += batchRows;
+            }
+            pendingCount = 0;
+            batchRows = 0;
+            batchValid = true;
+            continue;
         }
 
-        
+        batchRows++;
+        if (second.empty() || !isApplicationStatus(third)) {
+            batchValid = false;
+            continue;
+        }
+        ApplicationNode* node = applications->find(first, second);
+        if (node == NULL) continue;
+        if (pendingCount == capacity) {
+            ApplicationNode** biggerNodes = new ApplicationNode*[capacity * 2];
+            string* biggerStatus = new string[capacity * 2];
+            for (int i = 0; i < pendingCount; i++) {
+                biggerNodes[i] = pending[i];
+                biggerStatus[i] = pendingStatus[i];
+            }
+            delete[] pending;
+            delete[] pendingStatus;
+            pending = biggerNodes;
+            pendingStatus = biggerStatus;
+            capacity *= 2;
+        }
+        pending[pendingCount] = node;
+        pendingStatus[pendingCount] = third;
+        pendingCount++;
+    }
+    log.close();
+
+    delete[] pending;
+    delete[] pendingStatus;
+
+    // A batch still open at the end, or a last line cut short, would run
+    // into the next append; commitDecisions() closes it first
+    decisionLogTorn = batchRows > 0 || !endsWithNewline(DECISION_LOG_FILE);
+    dropped += batchRows;
+    if (dropped > 0) {
+        stringstream details;
+        details << "Dropped " << dropped << " row(s) of incomplete decision batches";
+        logEvent("ERROR", details.str());
+    }
+}
 
-        LogEntry entry(eventType, details);
 
-        logFile << entry.toString() << endl;
+// Rewrites applications.txt once with every logged decision and empties the log
+void InternshipSystem::compactDecisionLog()
+{
+    if (decisionLogRows == 0) return;
+    saveApplicationsToFile();
+}
 
-        logFile.close();
 
-    } catch (const FileException& e) {
 
-        cerr << "Logging Error: " << e.what() << endl;
+// Startup loading
+//
+// loadSystemData() reads the five data files at the same time, one task
+// per file. Each file is read in one go and split into newline-aligned
+// chunks that are parsed in parallel; the records are then merged into
+// the stores and hash indexes in file order on the calling thread.
 
+// Splits one '|' separated line into trimmed fields; returns the field count
+int splitDataLine(const char* begin, const char* end, string fields[], int maxFields)
+{
+    int count = 0;
+    const char* fieldStart = begin;
+    for (const char* p = begin; ; p++) {
+        if (p == end || *p == '|') {
+            if (count < maxFields) {
+                const char* first = fieldStart;
+                const char* last = p;
+                while (first < last && isspace((unsigned char)*first)) first++;
+                while (last > first && isspace((unsigned char)last[-1])) last--;
+                fields[count].assign(first, last - first);
+            }
+            count++;
+            if (p == end) break;
+            fieldStart = p + 1;
+        }
     }
-
+    for (int i = count; i < maxFields; i++) {
+        fields[i].clear();
+    }
+    return count < maxFields ? count : maxFields;
 }
 
 
+// Parallel loop body: parses chunks [first, last) of a DataFile
+void parseDataChunks(void* context, int first, int last)
+{
+    TRACE_SCOPE("load", "parseDataChunks");
+    DataFile* file = (DataFile*)context;
 
-// File operations
+    for (int c = first; c < last; c++) {
+        DataChunk& chunk = file->chunks[c];
 
-void InternshipSystem::loadStudentsFromFile() 
+        int lines = 1;
+        for (const char* p = chunk.begin; p < chunk.end; p++) {
+            if (*p == '\n') lines++;
+        }
+        if (file->kind == APPLICATIONS_FILE) {
+            chunk.nodes = new ApplicationNode*[lines];
+        } else {
+            chunk.records = new LoadedRecord[lines];
+        }
 
-{
+        const char* lineStart = chunk.begin;
+        while (lineStart < chunk.end) {
+            const char* lineEnd = (const char*)memchr(lineStart, '\n', chunk.end - lineStart);
+            if (lineEnd == NULL) lineEnd = chunk.end;
+            const char* next = (lineEnd < chunk.end) ? lineEnd + 1 : chunk.end;
+            if (lineEnd > lineStart && lineEnd[-1] == '\r') lineEnd--;
+
+            const char* text = lineStart;
+            while (text < lineEnd && isspace((unsigned char)*text)) text++;
+            lineStart = next;
+
+            // Blank lines, comments and the table layout's ruler line
+            if (text == lineEnd || *text == '#' || (file->tableLayout && *text == '-')) continue;
+
+            if (file->kind == APPLICATIONS_FILE) {
+                string fields[5];
+                if (splitDataLine(text, lineEnd, fields, 5) < 2 || fields[0].empty() || fields[1].empty()) continue;
+                chunk.nodes[chunk.count++] = new ApplicationNode(fields[0], fields[1], fields[2], fields[3], fields[4]);
+            } else {
+                LoadedRecord& record = chunk.records[chunk.count];
+                record.fieldCount = splitDataLine(text, lineEnd, record.fields, MAX_RECORD_FIELDS);
+                if (file->tableLayout && record.fields[0] == "Name") continue; // header row
+                chunk.count++;
+            }
+        }
+    }
+}
 
-    try {
 
-        ifstream file("students.txt");
+// Task: reads one data file into memory and parses it
+void readDataFile(void* argument)
+{
+    TRACE_SCOPE("load", "readDataFile");
+    DataFile* file = (DataFile*)argument;
+
+    FILE* in = fopen(file->filename.c_str(), "rb");
+    if (in == NULL) return;
+
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    if (size < 0) size = 0;
+    file->data = new char[size + 1];
+    file->size = (long)fread(file->data, 1, size, in);
+    file->data[file->size] = '\0';
+    fclose(in);
+    file->found = true;
+
+    const char* text = file->data;
+    while (*text == ' ') text++;
+    file->tableLayout = (file->kind == STUDENTS_FILE && strncmp(text, "Name", 4) == 0 &&
+                         strstr(text, "Student ID") != NULL);
+
+    // Newline-aligned chunks, a few per thread for large files
+    long wanted = file->size / LOAD_CHUNK_BYTES + 1;
+    long most = file->scheduler->getConcurrency() * 4;
+    file->chunkCount = (int)(wanted < most ? wanted : most);
+    file->chunks = new DataChunk[file->chunkCount];
+
+    const char* dataEnd = file->data + file->size;
+    const char* cursor = file->data;
+    for (int c = 0; c < file->chunkCount; c++) {
+        const char* end = dataEnd;
+        if (c < file->chunkCount - 1) {
+            end = file->data + (long)((double)file->size * (c + 1) / file->chunkCount);
+            if (end < cursor) end = cursor;
+            const char* newline = (const char*)memchr(end, '\n', dataEnd - end);
+            end = (newline != NULL) ? newline + 1 : dataEnd;
+        }
+        file->chunks[c].begin = cursor;
+        file->chunks[c].end = end;
+        cursor = end;
+    }
 
-        if (!file.is_open()) {
+    file->scheduler->parallelFor(0, file->chunkCount, 1, parseDataChunks, file);
+}
 
-            throw FileException("Cannot open students.txt for reading");
 
+// Reads students, staff, admins, jobs and applications in parallel and
+// replaces the matching stores. Returns how many of the files were found.
+int InternshipSystem::loadSystemData()
+{
+    MetricTimer timer(metrics, METRIC_LOAD);
+    TRACE_SCOPE("load", "InternshipSystem::loadSystemData");
+    double startTime = getWallClockSeconds();
+    beforeAllStoresChange();
+
+    const char* filenames[5] = { "students.txt", "staff.txt", "login_admin.txt",
+                                 "job_listings.txt", "applications.txt" };
+    DataFile files[5];
+    {
+        TaskGroup group(*scheduler);
+        for (int i = 0; i < 5; i++) {
+            files[i].kind = (DataFileKind)i;
+            files[i].filename = filenames[i];
+            files[i].scheduler = scheduler;
+            group.spawn(readDataFile, &files[i]);
         }
+        group.wait();
+    }
 
-        // Clear existing data
-        for (int i = 0; i < studentCount; i++) {
-            delete students[i];
-            students[i] = NULL;
-        }
-        studentCount = 0;
-        
-        string line;
-        while (getline(file, line) && studentCount < MAX_STUDENTS) {
+    int found = 0;
+    int skipped = 0;
+    if (files[STUDENTS_FILE].found) { skipped += mergeLoadedStudents(files[STUDENTS_FILE]); found++; }
+    if (files[STAFF_FILE].found) { skipped += mergeLoadedStaff(files[STAFF_FILE]); found++; }
+    if (files[ADMINS_FILE].found) { skipped += mergeLoadedAdmins(files[ADMINS_FILE]); found++; }
+    if (files[JOBS_FILE].found) { skipped += mergeLoadedJobs(files[JOBS_FILE]); found++; }
+    if (files[APPLICATIONS_FILE].found) { mergeLoadedApplications(files[APPLICATIONS_FILE]); found++; }
+
+    replayDecisionLog();
+    rebuildDepartmentIndexes();
+    applicationsLoaded = true;
+
+    if (found == 0) return 0;
+
+    stringstream summary;
+    summary << "Loaded " << studentCount << " students, " << staffCount << " staff, "
+            << adminCount << " admins, " << jobCount << " jobs and "
+            << applications->getCount() << " applications in "
+            << fixed << setprecision(1) << (getWallClockSeconds() - startTime) * 1000 << " ms";
+    cout << summary.str() << endl;
+    if (skipped > 0) {
+        cout << "Warning: " << skipped << " record(s) skipped (duplicate, incomplete or over capacity)" << endl;
+    }
+    logEvent("SYSTEM", summary.str());
+    return found;
+}
 
-            if (line.empty()) continue;
 
-            stringstream ss(line);
-            string id, name, email, cgpaStr, diploma, skills;
-            getline(ss, id, '|');
-            getline(ss, name, '|');
-            getline(ss, email, '|');
-            getline(ss, cgpaStr, '|');
-            getline(ss, diploma, '|');
-            getline(ss, skills, '|');
+// The merge functions replace a store with a loaded file's records and
+// return how many records were skipped
 
-            float cgpa = stringToFloat(cgpaStr);
-            Student* student = new Student(id, name, email, cgpa, diploma, skills);
-            students[studentCount++] = student;
-            studentHash->insert(student);
+int InternshipSystem::mergeLoadedStudents(DataFile& file)
+{
+    TRACE_SCOPE("load", "InternshipSystem::mergeLoadedStudents");
+    studentHash->clear();
+    for (int i = 0; i < studentCount; i++) {
+        delete students[i];
+        students[i] = NULL;
+    }
+    studentCount = 0;
+
+    int total = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        total += file.chunks[c].count;
+    }
+    reserveStudents(total);
+
+    int skipped = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        for (int r = 0; r < file.chunks[c].count; r++) {
+            const LoadedRecord& record = file.chunks[c].records[r];
+            // Table layout: Name | Student ID | Email | CGPA | Diploma | Skills | Applied Job
+            const string& id = file.tableLayout ? record.fields[1] : record.fields[0];
+            const string& name = file.tableLayout ? record.fields[0] : record.fields[1];
+
+            if (record.fieldCount < 4 || id.empty() || studentHash->search(id) != NULL) {
+                skipped++;
+                continue;
+            }
+            students[studentCount] = new Student(id, name, record.fields[2], stringToFloat(record.fields[3]),
+                                                 record.fields[4], record.fields[5]);
+            studentHash->insert(students[studentCount]);
+            studentCount++;
         }
-        file.close();
-        cout << "Loaded " << studentCount << " students from file.\n";
-        logEvent("SYSTEM", "Students loaded from file");
-    } catch (const FileException& e) {
+    }
+    return skipped;
+}
 
-        cout << "Error: " << e.what() << endl;
+int InternshipSystem::mergeLoadedStaff(DataFile& file)
+{
+    TRACE_SCOPE("load", "InternshipSystem::mergeLoadedStaff");
+    for (int i = 0; i < staffCount; i++) {
+        delete staffMembers[i];
+        staffMembers[i] = NULL;
+    }
+    staffCount = 0;
 
-        logEvent("ERROR", e.what());
+    int skipped = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        for (int r = 0; r < file.chunks[c].count; r++) {
+            const LoadedRecord& record = file.chunks[c].records[r];
+            if (record.fieldCount < 6 || record.fields[0].empty() || staffCount >= MAX_STAFF) {
+                skipped++;
+                continue;
+            }
+            staffMembers[staffCount++] = new Staff(record.fields[0], record.fields[1], record.fields[2],
+                                                   record.fields[3], record.fields[4], record.fields[5]);
+        }
+    }
+    return skipped;
+}
 
+int InternshipSystem::mergeLoadedAdmins(DataFile& file)
+{
+    TRACE_SCOPE("load", "InternshipSystem::mergeLoadedAdmins");
+    for (int i = 0; i < adminCount; i++) {
+        delete admins[i];
+        admins[i] = NULL;
     }
+    adminCount = 0;
 
+    int skipped = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        for (int r = 0; r < file.chunks[c].count; r++) {
+            const LoadedRecord& record = file.chunks[c].records[r];
+            if (record.fieldCount < 4 || record.fields[0].empty() || adminCount >= MAX_STUDENTS) {
+                skipped++;
+                continue;
+            }
+            admins[adminCount++] = new Admin(record.fields[0], record.fields[1], record.fields[2], record.fields[3]);
+        }
+    }
+    return skipped;
 }
 
+int InternshipSystem::mergeLoadedJobs(DataFile& file)
+{
+    TRACE_SCOPE("load", "InternshipSystem::mergeLoadedJobs");
+    jobHash->clear();
+    deadlineIndex->clear();
+    for (int i = 0; i < jobCount; i++) {
+        delete jobs[i];
+        jobs[i] = NULL;
+    }
+    jobCount = 0;
 
+    int skipped = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        for (int r = 0; r < file.chunks[c].count; r++) {
+            const LoadedRecord& record = file.chunks[c].records[r];
+            if (record.fieldCount < 4 || record.fields[0].empty() || jobCount >= MAX_JOBS ||
+                jobHash->search(record.fields[0]) != NULL) {
+                skipped++;
+                continue;
+            }
+            jobs[jobCount] = new InternshipJob(record.fields[0], record.fields[1], record.fields[2],
+                                               record.fields[3], record.fields[4]);
+            jobHash->insert(jobs[jobCount]);
+            jobCount++;
+        }
+    }
+    rebuildDeadlineIndex();
+    return skipped;
+}
 
-void InternshipSystem::saveStudentsToFile() 
+int InternshipSystem::mergeLoadedApplications(DataFile& file)
 {
-    try {
-        ofstream file("students.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open students.txt for writing");
-        }
+    TRACE_SCOPE("load", "InternshipSystem::mergeLoadedApplications");
+    int total = 0;
+    for (int c = 0; c < file.chunkCount; c++) {
+        total += file.chunks[c].count;
+    }
 
-        for (int i = 0; i < studentCount; i++) {
-            saveStudentToFile(*students[i], file);
+    applications->clear();
+    applications->reserve(total);
+    for (int c = 0; c < file.chunkCount; c++) {
+        for (int r = 0; r < file.chunks[c].count; r++) {
+            applications->append(file.chunks[c].nodes[r]);
         }
-        file.close();
-        cout << "Saved " << studentCount << " students to file.\n";
-        logEvent("SYSTEM", "Students saved to file");
-        
-    } catch (const FileException& e) {  // ? Fix: Add proper catch block
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
     }
+    return 0;
 }
 
 
-void InternshipSystem::loadStaffFromFile() 
+
+// Bulk application import
+
+// One data row of an import file. The validation workers fill in
+// studentID, jobID, status, job and error for the rows they own.
+struct ImportRow
 {
-    try {
+    long lineNumber;
+    string line;
+    string studentID;
+    string jobID;
+    string status;
+    InternshipJob* job;
+    string error;
+};
 
-        ifstream file("staff.txt");
 
-        if (!file.is_open()) {
+// Slice of a chunk handed to one validation thread
+struct ImportValidation
+{
+    ImportRow* rows;
+    StudentHashTable* studentHash;
+    JobHashTable* jobHash;
+};
 
-            throw FileException("Cannot open staff.txt for reading");
 
-        }
+string trimImportField(const string& str)
+{
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if (first == string::npos) return "";
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
 
-        
 
-        //  staffMembers.clear();  // This is vector method!
-        //  Clear array manually instead
-        for (int i = 0; i < staffCount; i++) {
-            delete staffMembers[i];
-            staffMembers[i] = NULL;
+// Splits a pipe separated line, or a CSV line if it has no '|'.
+// CSV fields may be wrapped in double quotes. Returns the number of fields.
+int splitImportLine(const string& line, string fields[], int maxFields)
+{
+    char delimiter = (line.find('|') != string::npos) ? '|' : ',';
+    int count = 0;
+    bool quoted = false;
+    string field;
+
+    for (size_t i = 0; i < line.length(); i++) {
+        char c = line[i];
+        if (c == '"' && delimiter == ',') {
+            if (quoted && i + 1 < line.length() && line[i + 1] == '"') {
+                field += '"';
+                i++;
+            } else {
+                quoted = !quoted;
+            }
+        } else if (c == delimiter && !quoted) {
+            if (count < maxFields) fields[count] = trimImportField(field);
+            count++;
+            field.clear();
+        } else {
+            field += c;
         }
-        staffCount = 0;
+    }
+    if (count < maxFields) fields[count] = trimImportField(field);
+    count++;
 
-        string line;
+    return count;
+}
 
-        while (getline(file, line) && staffCount < MAX_STAFF) {
 
-            if (line.empty()) continue;
+// Header rows name the columns, e.g. "studentID,jobID,status"
+bool isImportHeader(const string& line)
+{
+    string lower = line;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower.find("student") != string::npos && lower.find("job") != string::npos;
+}
 
 
+// Parallel loop body: parses and validates rows [first, last) against the hash indexes.
+// Only reads the indexes, so any number of workers can run at once.
+void validateImportRows(void* context, int first, int last)
+{
+    ImportValidation* task = (ImportValidation*)context;
+
+    for (int i = first; i < last; i++) {
+        ImportRow& row = task->rows[i];
+        string fields[3];
+        int fieldCount = splitImportLine(row.line, fields, 3);
+
+        row.studentID = fields[0];
+        row.jobID = fieldCount > 1 ? fields[1] : "";
+        row.status = (fieldCount > 2 && !fields[2].empty()) ? fields[2] : "Pending";
+        row.job = NULL;
+        row.error = "";
+
+        if (fieldCount < 2 || row.studentID.empty() || row.jobID.empty()) {
+            row.error = "Malformed row";
+        } else if (row.status != "Pending" && row.status != "Approved" && row.status != "Rejected") {
+            row.error = "Invalid status";
+        } else if (task->studentHash->search(row.studentID) == NULL) {
+            row.error = "Unknown student ID";
+        } else if ((row.job = task->jobHash->search(row.jobID)) == NULL) {
+            row.error = "Unknown job ID";
+        }
+    }
+}
 
-            stringstream ss(line);
 
-            string id, name, email, department, position, password;
+// Streams a partner file in chunks of IMPORT_CHUNK_ROWS rows. Each chunk is
+// validated in parallel, then deduplicated against the application store and
+// appended to applications.txt, which is flushed once per chunk. Rejected rows go to
+// import_rejects_<timestamp>.txt with their line number and reason.
+ImportResult InternshipSystem::importApplications(const string& filename)
+{
+    MetricTimer timer(metrics, METRIC_IMPORT);
+    TRACE_SCOPE("import", "InternshipSystem::importApplications");
+    ImportResult result;
+    double startTime = getWallClockSeconds();
+    ImportRow* rows = NULL;
 
-            getline(ss, id, '|');
+    try {
+        ifstream input(filename.c_str());
+        if (!input.is_open()) {
+            throw FileException("Cannot open import file: " + filename);
+        }
 
-            getline(ss, name, '|');
+        ensureApplicationsLoaded();
 
-            getline(ss, email, '|');
+        result.rejectFile = "import_rejects_" + getCurrentTimestamp() + ".txt";
+        ofstream rejects(result.rejectFile.c_str());
+        if (!rejects.is_open()) {
+            throw FileException("Cannot create reject report: " + result.rejectFile);
+        }
+        OutputBuffer rejectOut(rejects);
+        rejectOut.put("Line|Student ID|Job ID|Reason\n");
 
-            getline(ss, department, '|');
+        ofstream store("applications.txt", ios::app);
+        if (!store.is_open()) {
+            throw FileException("Cannot open applications.txt for writing");
+        }
+        OutputBuffer batch(store);
+        if (!endsWithNewline("applications.txt")) batch.put('\n');  // Saved without a final newline
 
-            getline(ss, position, '|');
+        rows = new ImportRow[IMPORT_CHUNK_ROWS];
+        ImportValidation validation;
+        validation.rows = rows;
+        validation.studentHash = studentHash;
+        validation.jobHash = jobHash;
 
-            getline(ss, password, '|');
+        long lineNumber = 0;
+        bool headerChecked = false;
+        string line;
 
+        while (true) {
+            // Read the next chunk
+            int rowCount = 0;
+            while (rowCount < IMPORT_CHUNK_ROWS && getline(input, line)) {
+                lineNumber++;
+                if (trimImportField(line).empty()) continue;
+                if (!headerChecked) {
+                    headerChecked = true;
+                    if (isImportHeader(line)) continue;
+                }
+                rows[rowCount].lineNumber = lineNumber;
+                rows[rowCount].line = line;
+                rowCount++;
+            }
+            if (rowCount == 0) break;
 
+            // Validate it in parallel
+            scheduler->parallelFor(0, rowCount, 256, validateImportRows, &validation);
 
-            //  staffMembers.push_back(staff);  // Vector method!
-            //  Use array indexing instead
-            staffMembers[staffCount++] = new Staff(id, name, email, department, position, password);
+            // Dedupe in file order and append the accepted rows
+            for (int i = 0; i < rowCount; i++) {
+                ImportRow& row = rows[i];
+                result.totalRows++;
 
-        }
+                if (row.error.empty() && applications->search(row.studentID, row.jobID)) {
+                    row.error = "Duplicate application";
+                    result.duplicates++;
+                } else if (!row.error.empty()) {
+                    result.rejected++;
+                }
 
-        file.close();
+                if (!row.error.empty()) {
+                    rejectOut.putInt(row.lineNumber).put('|').put(row.studentID).put('|')
+                             .put(row.jobID).put('|').put(row.error).put('\n');
+                    continue;
+                }
 
-        cout << "Loaded " << staffCount << " staff members from file.\n";
+                ApplicationNode* node = addApplication(row.studentID, row.jobID, row.job->getTitle(),
+                                                       row.job->getCompany(), row.status);
+                ApplicationList::writeLine(batch, node, node->status);
+                result.accepted++;
+            }
+            batch.flush();
+            store.flush();
+            if (!store) {
+                throw FileException("Write to applications.txt failed");
+            }
+        }
 
-        logEvent("SYSTEM", "Staff loaded from file");
+        rejectOut.flush();
+        store.close();
+        rejects.close();
+        input.close();
 
     } catch (const FileException& e) {
-
-        cout << "Error: " << e.what() << endl;
-
-        logEvent("ERROR", e.what());
-
+        cout << "Import Error: " << e.what() << endl;
+        logEvent("ERROR", "Import failed: " + string(e.what()));
     }
+    delete[] rows;
 
-}
+    result.seconds = getWallClockSeconds() - startTime;
+    if (result.seconds > 0) {
+        result.rowsPerSecond = result.totalRows / result.seconds;
+    }
 
+    stringstream details;
+    details << "Imported " << filename << ": " << result.accepted << " accepted, "
+            << result.duplicates << " duplicates, " << result.rejected << " rejected, "
+            << (long)result.rowsPerSecond << " rows/s";
+    logEvent("IMPORT", details.str());
 
+    return result;
+}
 
-void InternshipSystem::saveStaffToFile() 
 
+void InternshipSystem::bulkImportMenu()
 {
+    string filename;
+    cout << "Enter import file path (CSV or pipe separated): ";
+    getline(cin, filename);
+    filename = trim(filename);
+    if (filename.empty()) {
+        cout << "No file given.\n";
+        return;
+    }
 
-    try {
+    ImportResult result = importApplications(filename);
+
+    cout << "\n=== Import Summary ===" << endl;
+    cout << "Rows read: " << result.totalRows << endl;
+    cout << "Accepted: " << result.accepted << endl;
+    cout << "Duplicates: " << result.duplicates << endl;
+    cout << "Rejected: " << result.rejected << endl;
+    cout << "Time: " << fixed << setprecision(3) << result.seconds << " s ("
+         << setprecision(0) << result.rowsPerSecond << " rows/s)" << endl;
+    if (!result.rejectFile.empty()) {
+        cout << "Reject report: " << result.rejectFile << endl;
+    }
+}
 
-        ofstream file("staff.txt");
 
-        if (!file.is_open()) {
+// Applies a list of (studentID, jobID, status) decisions as one transaction.
+// Every row is validated first; if any row is invalid a DataException is
+// thrown and nothing changes. When one application appears more than once
+// the last row wins. Returns the number of applications whose status changed.
+int InternshipSystem::applyDecisionBatch(const ApplicationDecision* decisions, int count)
+{
+    ensureApplicationsLoaded();
+    if (count <= 0) return 0;
 
-            throw FileException("Cannot open staff.txt for writing");
+    ApplicationNode** resolved = new ApplicationNode*[count];
+    ApplicationNode** changedNodes = new ApplicationNode*[count];
+    string* changedStatus = new string[count];
+    int seenSize = count * 2 + 1;
+    ApplicationNode** seen = new ApplicationNode*[seenSize];
+    for (int i = 0; i < seenSize; i++) seen[i] = NULL;
+    int changed = 0;
 
+    try {
+        // Validate the whole batch before touching the store
+        for (int i = 0; i < count; i++) {
+            const ApplicationDecision& d = decisions[i];
+            stringstream row;
+            row << "Row " << (i + 1) << ": ";
+            if (!isApplicationStatus(d.status)) {
+                throw DataException(row.str() + "invalid status '" + d.status + "'");
+            }
+            resolved[i] = applications->find(d.studentID, d.jobID);
+            if (resolved[i] == NULL) {
+                throw DataException(row.str() + "no application for " + d.studentID + " / " + d.jobID);
+            }
         }
 
+        // Walk backwards so the last decision for an application wins
+        for (int i = count - 1; i >= 0; i--) {
+            size_t slot = ((size_t)resolved[i] / sizeof(void*)) % seenSize;
+            bool duplicate = false;
+            while (seen[slot] != NULL) {
+                if (seen[slot] == resolved[i]) {
+                    duplicate = true;
+                    break;
+                }
+                slot = (slot + 1) % seenSize;
+            }
+            if (duplicate) continue;
+            seen[slot] = resolved[i];
 
-
-        //  for (size_t i = 0; i < staffMembers.size(); i++) 
-        //  Use staffCount instead
-        for (int i = 0; i < staffCount; i++) {
-
-            ::saveStaffToFile(*staffMembers[i], file);
-
+            if (resolved[i]->status == decisions[i].status) continue;
+            changedNodes[changed] = resolved[i];
+            changedStatus[changed] = decisions[i].status;
+            changed++;
         }
 
-        file.close();
-
-        cout << "Saved " << staffCount << " staff members to file.\n";
-
-        logEvent("SYSTEM", "Staff saved to file");
+        commitDecisions(changedNodes, changedStatus, changed);
+    } catch (...) {
+        delete[] resolved;
+        delete[] changedNodes;
+        delete[] changedStatus;
+        delete[] seen;
+        throw;
+    }
 
-    } catch (const FileException& e) {
+    delete[] resolved;
+    delete[] changedNodes;
+    delete[] changedStatus;
+    delete[] seen;
+    return changed;
+}
 
-        cout << "Error: " << e.what() << endl;
 
-        logEvent("ERROR", e.what());
+// e.g. applyDecisionRule("JOB1001", "Approved", 3.5) approves every pending
+// application for JOB1001 whose student has CGPA >= 3.5, in one commit.
+int InternshipSystem::applyDecisionRule(const string& jobID, const string& newStatus, float minCGPA)
+{
+    ensureApplicationsLoaded();
+    if (newStatus != "Approved" && newStatus != "Rejected") {
+        throw DataException("Rule status must be Approved or Rejected");
+    }
 
+    int matches = 0;
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        if (node->jobID != jobID || node->status != "Pending") continue;
+        Student* student = studentHash->search(node->studentID);
+        if (student != NULL && student->getCGPA() >= minCGPA) matches++;
+    }
+    if (matches == 0) return 0;
+
+    ApplicationNode** nodes = new ApplicationNode*[matches];
+    string* statuses = new string[matches];
+    int n = 0;
+    for (ApplicationNode* node = applications->getHead(); node != NULL && n < matches; node = node->next) {
+        if (node->jobID != jobID || node->status != "Pending") continue;
+        Student* student = studentHash->search(node->studentID);
+        if (student != NULL && student->getCGPA() >= minCGPA) {
+            nodes[n] = node;
+            statuses[n] = newStatus;
+            n++;
+        }
     }
 
+    try {
+        commitDecisions(nodes, statuses, n);
+    } catch (...) {
+        delete[] nodes;
+        delete[] statuses;
+        throw;
+    }
+    delete[] nodes;
+    delete[] statuses;
+    return n;
 }
 
 
-
-void InternshipSystem::loadAdminsFromFile() 
-
+// Reads studentID|jobID|status rows (or CSV) and applies them as one batch
+int InternshipSystem::applyDecisionFile(const string& filename)
 {
+    ifstream file(filename.c_str());
+    if (!file.is_open()) {
+        throw FileException("Cannot open decision file: " + filename);
+    }
 
-    try {
-        ifstream file("login_admin.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open login_admin.txt for reading");
+    int count = 0, capacity = 64;
+    ApplicationDecision* decisions = new ApplicationDecision[capacity];
+    string line;
+    bool headerChecked = false;
+    while (getline(file, line)) {
+        if (trimImportField(line).empty()) continue;
+        if (!headerChecked) {
+            headerChecked = true;
+            if (isImportHeader(line)) continue;
         }
-
-        // Clear array manually
-        for (int i = 0; i < adminCount; i++) {
-            delete admins[i];
-            admins[i] = NULL;
+        if (count == capacity) {
+            ApplicationDecision* bigger = new ApplicationDecision[capacity * 2];
+            for (int i = 0; i < count; i++) bigger[i] = decisions[i];
+            delete[] decisions;
+            decisions = bigger;
+            capacity *= 2;
         }
-        adminCount = 0;
-
-        string line;
-        while (getline(file, line) && adminCount < MAX_STUDENTS) {
-            if (line.empty()) continue;
-
-            stringstream ss(line);
-            string id, name, email, password;
-            getline(ss, id, '|');
-            getline(ss, name, '|');
-            getline(ss, email, '|');
-            getline(ss, password, '|');
+        string fields[3];
+        splitImportLine(line, fields, 3);
+        decisions[count].studentID = fields[0];
+        decisions[count].jobID = fields[1];
+        decisions[count].status = fields[2];
+        count++;
+    }
+    file.close();
 
-            admins[adminCount++] = new Admin(id, name, email, password);
-        }
-        file.close();
-        cout << "Loaded " << adminCount << " admins from file.\n";
-        logEvent("SYSTEM", "Admins loaded from file");
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
+    int changed = 0;
+    try {
+        changed = applyDecisionBatch(decisions, count);
+    } catch (...) {
+        delete[] decisions;
+        throw;
     }
+    delete[] decisions;
+    return changed;
 }
 
 
-
-void InternshipSystem::saveAdminsToFile() 
-
+void InternshipSystem::batchDecisionMenu()
 {
+    cout << "\n=== Batch Decisions ===" << endl;
+    cout << "1. Apply decisions from file (studentID|jobID|status)" << endl;
+    cout << "2. Decide all pending applications for a job by CGPA" << endl;
+    cout << "Enter choice: ";
+    int choice;
+    cin >> choice;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
     try {
-        ofstream file("login_admin.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open login_admin.txt for writing");
-        }
-
-        for (int i = 0; i < adminCount; i++) {
-            saveAdminToFile(*admins[i], file);
+        int changed = 0;
+        if (choice == 1) {
+            string filename;
+            cout << "Enter decision file path: ";
+            getline(cin, filename);
+            changed = applyDecisionFile(trim(filename));
+        } else if (choice == 2) {
+            string jobID;
+            int statusChoice;
+            float minCGPA;
+            cout << "Enter Job ID: ";
+            getline(cin, jobID);
+            cout << "Set status (1: Approved, 2: Rejected): ";
+            cin >> statusChoice;
+            cout << "Minimum CGPA: ";
+            cin >> minCGPA;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            changed = applyDecisionRule(trim(jobID), statusChoice == 2 ? "Rejected" : "Approved", minCGPA);
+        } else {
+            cout << "Invalid choice.\n";
+            return;
         }
-        file.close();
-        cout << "Saved " << adminCount << " admins to file.\n";
-        logEvent("SYSTEM", "Admins saved to file");
-        
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
+        cout << changed << " application(s) changed.\n";
+    } catch (const exception& e) {
+        cout << "Batch not applied: " << e.what() << endl;
     }
 }
 
 
 
-void InternshipSystem::loadJobsFromFile() 
+// Command mode
+//
+// Runs operations without menus or prompts, one command per line, from
+// the command line (--run) or a script file (--script):
+//   load | save [students|jobs|staff|admins|applications]
+//   sort-by-cgpa | sort-by-id | sort-by-name
+//   sort-jobs-by-deadline | sort-jobs-by-title | sort-jobs-by-company
+//   find-student <id> | search-binary <id> | search-fibonacci <id> | search-cgpa <cgpa>
+//   search-title <text> | search-diploma <diploma> | search-cgpa-range <min> <max> | search-company <text>
+//   list students|jobs|staff | statistics | closing <days> | rank <jobID> [count]
+//   report detailed|performance [format] | export students|applications [format]
+//   apply <studentID> <jobID> | decide <studentID> <jobID> <Approved|Rejected>
+//   decide-file <file> | import <file> | backup | backups | restore <snapshot> | diagnostics
+// Returns a short result such as a count or snapshot ID; failures throw.
 
+string InternshipSystem::runCommand(const string& line)
 {
-
-    try {
-
-        ifstream file("job_listings.txt");
-
-        if (!file.is_open()) {
-
-            throw FileException("Cannot open job_listings.txt for reading");
-
+    MetricTimer timer(metrics, METRIC_COMMAND);
+    TRACE_SCOPE("command", "InternshipSystem::runCommand");
+    stringstream in(line);
+    string command;
+    in >> command;
+    transform(command.begin(), command.end(), command.begin(), ::tolower);
+    string rest;
+    getline(in, rest);
+    rest = trim(rest);
+    stringstream args(rest);
+    stringstream out;
+
+    if (command == "load") {
+        if (loadSystemData() == 0) throw FileException("No data files found");
+        out << studentCount << " students, " << jobCount << " jobs, " << applications->getCount() << " applications";
+    } else if (command == "save") {
+        if (!rest.empty() && rest != "students" && rest != "jobs" && rest != "staff" && rest != "admins" &&
+            rest != "applications") {
+            throw DataException("Usage: save [students|jobs|staff|admins|applications]");
         }
-
-        //  jobs.clear();
-        //  Clear array manually
-        for (int i = 0; i < jobCount; i++) {
-            delete jobs[i];
-            jobs[i] = NULL;
+        ensureApplicationsLoaded();
+        // Every file asked for is attempted; any that could not be written fail the command
+        string failed;
+        if ((rest.empty() || rest == "students") && !saveStudentsToFile()) failed += " students";
+        if ((rest.empty() || rest == "jobs") && !saveJobsToFile()) failed += " jobs";
+        if ((rest.empty() || rest == "staff") && !saveStaffToFile()) failed += " staff";
+        if ((rest.empty() || rest == "admins") && !saveAdminsToFile()) failed += " admins";
+        if ((rest.empty() || rest == "applications") && !saveApplicationsToFile()) failed += " applications";
+        if (!failed.empty()) throw FileException("Could not save" + failed);
+        out << saver.describeLast();
+    } else if (command == "sort-by-cgpa") {
+        selectionSortStudentsByCGPA();
+    } else if (command == "sort-by-id") {
+        selectionSortStudentsByID();
+    } else if (command == "sort-by-name") {
+        insertionSortStudentsByName();
+    } else if (command == "sort-jobs-by-deadline") {
+        bubbleSortJobsByDeadline();
+    } else if (command == "sort-jobs-by-title") {
+        bubbleSortJobsByTitle();
+    } else if (command == "sort-jobs-by-company") {
+        mergeSortJobsByCompany();
+    } else if (command == "find-student") {
+        if (rest.empty()) throw DataException("Usage: find-student <id>");
+        Student* student = hashSearchStudent(rest);
+        if (student == NULL) throw DataException("No student " + rest);
+        student->displayInfo();
+        out << student->getName();
+    } else if (command == "search-binary" || command == "search-fibonacci") {
+        if (rest.empty()) throw DataException("Usage: " + command + " <id>");
+        int position = (command == "search-binary") ? binarySearchStudentByID(rest) : fibonacciSearchStudentByID(rest);
+        if (position < 0) throw DataException("No student " + rest);
+        out << "position " << position;
+    } else if (command == "search-cgpa") {
+        float cgpa;
+        if (!(args >> cgpa)) throw DataException("Usage: search-cgpa <cgpa>");
+        int position = interpolationSearchStudentByCGPA(cgpa);
+        if (position < 0) throw DataException("No student with that CGPA");
+        out << "position " << position;
+    } else if (command == "search-title") {
+        if (rest.empty()) throw DataException("Usage: search-title <text>");
+        int position = linearSearchJobByTitle(rest);
+        if (position < 0) throw DataException("No job title contains " + rest);
+        out << jobs[position]->getJobID();
+    } else if (command == "search-diploma") {
+        if (rest.empty()) throw DataException("Usage: search-diploma <diploma>");
+        searchStudentsByDiploma(rest);
+    } else if (command == "search-cgpa-range") {
+        float minCGPA, maxCGPA;
+        if (!(args >> minCGPA >> maxCGPA)) throw DataException("Usage: search-cgpa-range <min> <max>");
+        searchStudentsByCGPARange(minCGPA, maxCGPA);
+    } else if (command == "search-company") {
+        if (rest.empty()) throw DataException("Usage: search-company <text>");
+        searchJobsByCompany(rest);
+    } else if (command == "list") {
+        if (rest == "students") displayAllStudents();
+        else if (rest == "jobs") displayAllJobs();
+        else if (rest == "staff") displayAllStaff();
+        else throw DataException("Usage: list students|jobs|staff");
+    } else if (command == "statistics") {
+        ensureApplicationsLoaded();
+        displayStatistics();
+    } else if (command == "closing") {
+        int days;
+        if (!(args >> days)) throw DataException("Usage: closing <days>");
+        displayJobsClosingWithin(days);
+    } else if (command == "rank") {
+        string jobID;
+        int count = REPORT_TOP_STUDENTS;
+        if (!(args >> jobID)) throw DataException("Usage: rank <jobID> [count]");
+        args >> count;
+        if (hashSearchJob(jobID) == NULL) throw DataException("Job ID not found");
+        showCandidateRanking(jobID, count);
+    } else if (command == "report" || command == "export") {
+        string what, formatName;
+        ReportFormat format = command == "report" ? REPORT_TEXT : REPORT_CSV;
+        args >> what >> formatName;
+        if (!formatName.empty() && !parseReportFormat(formatName, format)) {
+            throw DataException("Formats: text, csv, jsonl, columnar");
         }
-        jobCount = 0;
-
-        string line;
-
-        while (getline(file, line) && jobCount < MAX_JOBS) {
+        bool written;
+        if (command == "report" && what == "detailed") written = generateDetailedReport(format);
+        else if (command == "report" && what == "performance") written = generateStudentPerformanceReport(format);
+        else if (command == "export" && what == "students") written = exportStudents(format);
+        else if (command == "export" && what == "applications") written = exportApplications(format);
+        else if (command == "report") throw DataException("Usage: report detailed|performance [format]");
+        else throw DataException("Usage: export students|applications [format]");
+        if (!written) throw FileException("Could not write the " + what + " " + command);
+        out << reportFormatName(format);
+    } else if (command == "apply") {
+        string studentID, jobID;
+        if (!(args >> studentID >> jobID)) throw DataException("Usage: apply <studentID> <jobID>");
+        if (hashSearchStudent(studentID) == NULL) throw DataException("No student " + studentID);
+        submitApplication(studentID, jobID);
+        out << studentID << " applied for " << jobID;
+    } else if (command == "decide") {
+        ApplicationDecision decision;
+        if (!(args >> decision.studentID >> decision.jobID >> decision.status)) {
+            throw DataException("Usage: decide <studentID> <jobID> <Approved|Rejected>");
+        }
+        ensureApplicationsLoaded();
+        out << applyDecisionBatch(&decision, 1) << " changed";
+    } else if (command == "decide-file") {
+        if (rest.empty()) throw DataException("Usage: decide-file <file>");
+        out << applyDecisionFile(rest) << " changed";
+    } else if (command == "import") {
+        if (rest.empty()) throw DataException("Usage: import <file>");
+        ImportResult result = importApplications(rest);
+        if (result.totalRows == 0 && result.accepted == 0 && result.rejected == 0) {
+            throw FileException("Nothing imported from " + rest);
+        }
+        out << result.accepted << " accepted, " << result.duplicates << " duplicates, "
+            << result.rejected << " rejected";
+    } else if (command == "backup") {
+        string snapshotID = backupSystemData();
+        if (snapshotID.empty()) throw FileException("Backup failed");
+        out << snapshotID;
+    } else if (command == "backups") {
+        listBackups();
+    } else if (command == "restore") {
+        if (rest.empty()) throw DataException("Usage: restore <snapshot>");
+        if (!restoreSystemData(rest)) throw FileException("Restore of " + rest + " failed");
+        out << rest;
+    } else if (command == "diagnostics") {
+        ensureApplicationsLoaded();
+        runSystemDiagnostics();
+    } else {
+        throw DataException("Unknown command " + command);
+    }
+    return out.str();
+}
 
-            if (line.empty()) continue;
 
-            stringstream ss(line);
+const ReportColumn COMMAND_COLUMNS[] = {
+    { "sequence", "#", COLUMN_INTEGER, 7 },
+    { "command", "Command", COLUMN_TEXT, 36 },
+    { "status", "Status", COLUMN_TEXT, 7 },
+    { "microseconds", "Time (us)", COLUMN_INTEGER, 12 },
+    { "result", "Result", COLUMN_TEXT, 30 }
+};
+const ReportTable COMMAND_TABLE = { "command", "COMMAND RESULTS", COMMAND_COLUMNS, 5, TABLE_ROWS };
 
-            string jobID, title, company, deadline, requirements;
 
-            getline(ss, jobID, '|');
+// Runs every command of a script in order. Each one is followed by
+//   RESULT <number> OK|ERR <milliseconds> <command> [-- <result or error>]
+// on the console, after the command's own output unless quiet, and by a
+// row in results when given. Returns how many commands failed.
+int InternshipSystem::runCommandScript(istream& script, bool quiet, bool stopOnError, ReportWriter* results)
+{
+    ensureApplicationsLoaded();
+    if (results != NULL) results->beginTable(COMMAND_TABLE);
+
+    OutputBuffer console(cout);
+    long number = 0;
+    int failed = 0;
+    long long scriptStart = getMonotonicNanoseconds();
+    string line;
+    while (getline(script, line)) {
+        if (!line.empty() && line[line.length() - 1] == '\r') line.erase(line.length() - 1);
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        number++;
+
+        string result;
+        bool ok = true;
+        if (!quiet) console.flush();
+        long long start = getMonotonicNanoseconds();
+        try {
+            StreamSilencer silencer(cout, quiet);
+            result = runCommand(line);
+        } catch (const exception& e) {
+            ok = false;
+            result = e.what();
+        }
+        long long elapsed = getMonotonicNanoseconds() - start;
+        if (!ok) {
+            failed++;
+            metrics.increment(METRIC_COMMAND_ERRORS);
+            logEvent("ERROR", "Command failed: " + line + " (" + result + ")");
+        }
 
-            getline(ss, title, '|');
+        if (!quiet) cout.flush();
+        console.put("RESULT ").putInt(number).put(ok ? " OK " : " ERR ").putFixed(elapsed / 1e6, 3).put(' ').put(line);
+        if (!result.empty()) console.put(" -- ").put(result);
+        console.put('\n');
+        if (results != NULL) {
+            results->integer(number);
+            results->text(line);
+            results->text(ok ? "OK" : "ERR");
+            results->integer((long)(elapsed / 1000));
+            results->text(result);
+            results->endRow();
+        }
+        if (!ok && stopOnError) break;
+    }
 
-            getline(ss, company, '|');
+    console.put("DONE ").putInt(number).put(" command(s), ").putInt(failed).put(" failed in ")
+           .putFixed((getMonotonicNanoseconds() - scriptStart) / 1e6, 3).put(" ms\n");
+    console.flush();
+    cout.flush();
+    if (results != NULL) results->endTable();
+    return failed;
+}
 
-            getline(ss, deadline, '|');
 
-            getline(ss, requirements, '|');
 
+// Server mode
+//
+// Each client sends one command per line and gets either a single
+// "OK ..." / "ERR ..." line or data lines followed by "END":
+//   LOGIN STUDENT <id> | LOGIN STAFF <id> <password> | LOGIN ADMIN <id> <password>
+//   JOBS | CLOSING <days> | APPLY <jobID> | MYAPPS                (students)
+//   PENDING [count] | DECIDE <studentID> <jobID> <Approved|Rejected> (staff)
+//   BACKUP | METRICS                                              (admins)
+//   REPORT | HELP | QUIT
 
+string InternshipSystem::handleRequest(ServerSession& session, const string& line)
+{
+    MetricTimer timer(metrics, METRIC_REQUEST);
+    TRACE_SCOPE("request", "InternshipSystem::handleRequest");
+    stringstream in(line);
+    string command;
+    in >> command;
+    transform(command.begin(), command.end(), command.begin(), ::toupper);
+    stringstream out;
 
-            // if (jobs.size() < MAX_JOBS) { jobs.push_back(job); }
-            //  Use array indexing instead
-            jobs[jobCount++] = new InternshipJob(jobID, title, company, deadline, requirements);
+    try {
+        if (command.empty()) {
+            return "";
+        } else if (command == "QUIT") {
+            session.closing = true;
+            out << "OK bye\n";
+        } else if (command == "HELP") {
+            out << "LOGIN STUDENT <id> | LOGIN STAFF <id> <password> | LOGIN ADMIN <id> <password>\n"
+                << "JOBS | CLOSING <days> | APPLY <jobID> | MYAPPS\n"
+                << "PENDING [count] | DECIDE <studentID> <jobID> <Approved|Rejected>\n"
+                << "BACKUP | METRICS | REPORT | QUIT\nEND\n";
+        } else if (command == "LOGIN") {
+            MetricTimer timer(metrics, METRIC_LOGIN);
+            TRACE_SCOPE("login", "handleRequest LOGIN");
+            string role, userID, password;
+            in >> role >> userID >> password;
+            transform(role.begin(), role.end(), role.begin(), ::toupper);
+
+            if (role == "STUDENT") {
+                ReadLock lock(systemLock);
+                Student* student = studentHash->search(userID);
+                if (student == NULL) throw LoginException("Invalid Student ID");
+                session.role = role;
+                session.userID = userID;
+                out << "OK STUDENT " << student->getName() << "\n";
+            } else if (role == "STAFF") {
+                string department, name;
+                {
+                    ReadLock lock(systemLock);
+                    for (int i = 0; i < staffCount; i++) {
+                        if (staffMembers[i]->getID() == userID && staffMembers[i]->password == password) {
+                            department = staffMembers[i]->getDepartment();
+                            name = staffMembers[i]->getName();
+                        }
+                    }
+                }
+                if (name.empty()) throw LoginException("Invalid staff credentials");
+                {
+                    // Build the department's queue and counters now so later reads stay shared
+                    WriteLock lock(systemLock);
+                    getReviewQueue(department);
+                    getDepartmentStats(department);
+                }
+                session.role = role;
+                session.userID = userID;
+                session.department = department;
+                out << "OK STAFF " << name << " (" << department << ")\n";
+            } else if (role == "ADMIN") {
+                ReadLock lock(systemLock);
+                bool found = false;
+                for (int i = 0; i < adminCount && !found; i++) {
+                    found = admins[i]->getID() == userID && admins[i]->password == password;
+                }
+                if (!found) throw LoginException("Invalid admin credentials");
+                session.role = role;
+                session.userID = userID;
+                out << "OK ADMIN " << userID << "\n";
+            } else {
+                throw DataException("Usage: LOGIN STUDENT|STAFF|ADMIN <id> [password]");
+            }
+        } else if (command == "JOBS" || command == "CLOSING") {
+            int days = -1;
+            if (command == "CLOSING" && !(in >> days)) throw DataException("Usage: CLOSING <days>");
+
+            // Lock-free: reads the published catalog snapshot. Jobs past their
+            // deadline are skipped here and closed by the server's sweeper.
+            JobCatalogReader catalog(*jobCatalog);
+            long today = currentDayNumber();
+            long lastDay = (days < 0) ? NO_DEADLINE_DAY : today + days;
+            int first;
+            int end = catalog->openBetween(today, lastDay, first);
+            for (int i = first; i < end; i++) {
+                const JobListing* job = catalog->open[i];
+                out << job->jobID << "|" << job->title << "|"
+                    << job->company << "|" << job->deadline << "\n";
+            }
+            out << "END\n";
+        } else if (command == "APPLY") {
+            if (session.role != "STUDENT") throw SecurityException("Log in as a student first");
+            string jobID;
+            in >> jobID;
+            WriteLock lock(systemLock);
+            submitApplication(session.userID, jobID);
+            out << "OK applied " << jobID << "\n";
+        } else if (command == "MYAPPS") {
+            if (session.role != "STUDENT") throw SecurityException("Log in as a student first");
+            ReadLock lock(systemLock);
+            for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+                if (node->studentID == session.userID) {
+                    out << node->jobID << "|" << node->jobTitle << "|" << node->company << "|" << node->status << "\n";
+                }
+            }
+            out << "END\n";
+        } else if (command == "PENDING") {
+            if (session.role != "STAFF") throw SecurityException("Log in as staff first");
+            int wanted = REVIEW_PAGE_SIZE;
+            in >> wanted;
+            if (wanted < 1) wanted = 1;
+            if (wanted > 1000) wanted = 1000;
+
+            // Peeking pops from the heap and puts the entries back, so it writes
+            WriteLock lock(systemLock);
+            ReviewQueue* queue = getReviewQueue(session.department);
+            ApplicationNode** page = new ApplicationNode*[wanted];
+            int count = 0;
+            while (count < wanted && (page[count] = queue->popPending()) != NULL) count++;
+            for (int i = 0; i < count; i++) {
+                out << page[i]->studentID << "|" << page[i]->jobID << "|" << page[i]->jobTitle << "|"
+                    << page[i]->company << "|" << page[i]->status << "\n";
+                queue->push(page[i]);
+            }
+            delete[] page;
+            out << "END\n";
+        } else if (command == "DECIDE") {
+            if (session.role != "STAFF") throw SecurityException("Log in as staff first");
+            ApplicationDecision decision;
+            in >> decision.studentID >> decision.jobID >> decision.status;
+            if (decision.status != "Approved" && decision.status != "Rejected") {
+                throw DataException("Usage: DECIDE <studentID> <jobID> <Approved|Rejected>");
+            }
+            WriteLock lock(systemLock);
+            ApplicationNode* node = applications->find(decision.studentID, decision.jobID);
+            if (node == NULL || !departmentMatches(node->company, session.department)) {
+                throw DataException("No such application in your department");
+            }
+            int changed = applyDecisionBatch(&decision, 1);
+            out << "OK " << changed << " changed\n";
+        } else if (command == "METRICS") {
+            if (session.role != "ADMIN") throw SecurityException("Log in as an admin first");
+            metrics.writePrometheus(out);
+            out << "END\n";
+        } else if (command == "BACKUP") {
+            if (session.role != "ADMIN") throw SecurityException("Log in as an admin first");
+            // Writers are held off only while the stores are frozen
+            // The ID is picked first: that reads the backup directory
+            string snapshotID = newSnapshotID();
+            {
+                WriteLock lock(systemLock);
+                snapshotID = startBackgroundBackup(snapshotID);
+            }
+            if (snapshotID.empty()) throw DataException("A backup is already running");
+            out << "OK backup " << snapshotID << " started\n";
+        } else if (command == "REPORT") {
+            if (session.role == "STAFF") {
+                // Counters missing (e.g. after a reload) are created under the write lock
+                JobStatusCounts totals;
+                bool found = false;
+                {
+                    ReadLock lock(systemLock);
+                    DepartmentStats* stats = findDepartmentStats(session.department);
+                    if (stats != NULL) {
+                        totals = stats->getTotals();
+                        found = true;
+                    }
+                }
+                if (!found) {
+                    WriteLock lock(systemLock);
+                    totals = getDepartmentStats(session.department)->getTotals();
+                }
+                out << "OK total=" << totals.total << " pending=" << totals.pending
+                    << " approved=" << totals.approved << " rejected=" << totals.rejected << "\n";
+            } else if (session.role == "ADMIN") {
+                ReadLock lock(systemLock);
+                out << "OK students=" << studentCount << " jobs=" << jobCount << " staff=" << staffCount
+                    << " applications=" << applications->getCount() << "\n";
+            } else {
+                throw SecurityException("Log in as staff or admin first");
+            }
+        } else {
+            throw DataException("Unknown command " + command + " (try HELP)");
         }
-        file.close();
-        //  cout << "Loaded " << jobs.size() << " jobs from file.\n";
-        //  Fix to use jobCount
-        cout << "Loaded " << jobCount << " jobs from file.\n";
-        logEvent("SYSTEM", "Jobs loaded from file");
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
+    } catch (const LoginException& e) {
+        metrics.increment(METRIC_LOGIN_FAILURES);
+        metrics.increment(METRIC_REQUEST_ERRORS);
+        out.str("");
+        out << "ERR " << e.what() << "\n";
+    } catch (const exception& e) {
+        metrics.increment(METRIC_REQUEST_ERRORS);
+        out.str("");
+        out << "ERR " << e.what() << "\n";
     }
+    return out.str();
 }
 
 
+#ifndef _WIN32
+
+// One client. While idle it belongs to the accept loop, which reads from
+// it; once a complete request line has arrived it is handed to a pool
+// worker (busy) until that worker has answered every complete line.
+struct ServerConnection
+{
+    int socket;
+    InternshipSystem* system;
+    ServerSession session;
+    string buffer;     // Received text not yet answered
+    bool busy;         // A worker owns the connection; guarded by serverState.mutex
+    bool closing;      // QUIT, disconnect or a failed write
+};
+
+// Shared by the accept loop and the pool workers
+struct ServerState
+{
+    Mutex mutex;
+    ServerConnection* clients[MAX_SERVER_CONNECTIONS];
+    int clientCount;
+    int wakePipe[2];   // A worker writes a byte when it hands a connection back
+
+    ServerState() : clientCount(0) { wakePipe[0] = wakePipe[1] = -1; }
+};
 
-void InternshipSystem::saveJobsToFile() 
+ServerState serverState;
+volatile sig_atomic_t serverStopRequested = 0;
 
+void requestServerStop(int)
 {
+    serverStopRequested = 1;
+}
 
-    try {
-        ofstream file("job_listings.txt");
-        if (!file.is_open()) {
-            throw FileException("Cannot open job_listings.txt for writing");
-        }
 
-        // for (size_t i = 0; i < jobs.size(); i++) 
-        //  Use jobCount instead
-        for (int i = 0; i < jobCount; i++) {
-            saveJobToFile(*jobs[i], file);
-        }
-        file.close();
-        // cout << "Saved " << jobs.size() << " jobs to file.\n";
-        // Fix to use jobCount
-        cout << "Saved " << jobCount << " jobs to file.\n";
-        logEvent("SYSTEM", "Jobs saved to file");
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
+bool writeToSocket(int socket, const string& text)
+{
+    size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t n = send(socket, text.data() + sent, text.size() - sent, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += (size_t)n;
     }
+    return true;
 }
 
 
-
-void InternshipSystem::loadApplicationsFromFile() 
-
+// Thread pool task: answers the complete lines a connection has received,
+// then hands it back to the accept loop. Idle clients hold no worker.
+void serveRequests(void* argument)
 {
+    ServerConnection* connection = (ServerConnection*)argument;
+    size_t newline;
+    while (!connection->closing && (newline = connection->buffer.find('\n')) != string::npos) {
+        string line = connection->buffer.substr(0, newline);
+        connection->buffer.erase(0, newline + 1);
+        if (!line.empty() && line[line.length() - 1] == '\r') line.erase(line.length() - 1);
+
+        string response = connection->system->handleRequest(connection->session, line);
+        if (!response.empty() && !writeToSocket(connection->socket, response)) connection->closing = true;
+        if (connection->session.closing) connection->closing = true;
+    }
 
-    try {
-        applications->loadFromFile("applications.txt");
-        cout << "Loaded " << applications->getCount() << " applications from file.\n";
-        logEvent("SYSTEM", "Applications loaded from file");
-    } catch (const FileException& e) {
-        cout << "Error: " << e.what() << endl;
-        logEvent("ERROR", e.what());
+    {
+        ScopedLock guard(serverState.mutex);
+        connection->busy = false;
     }
+    char wake = 1;
+    while (write(serverState.wakePipe[1], &wake, 1) < 0 && errno == EINTR) {}
 }
 
+#endif
 
 
-void InternshipSystem::saveApplicationsToFile() 
-
+// Listens on a Unix domain socket and answers clients' requests on a thread
+// pool that shares this InternshipSystem: the pool size bounds how many
+// requests run at once, not how many clients can be connected. Runs until
+// SIGINT or SIGTERM.
+void InternshipSystem::runServer(const string& socketPath, int threadCount)
 {
+#ifdef _WIN32
+    (void)socketPath;
+    (void)threadCount;
+    cout << "Server mode needs Unix domain sockets and is not available in Windows builds." << endl;
+#else
+    ensureApplicationsLoaded();
+    sweepExpiredJobs();
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.length() >= sizeof(address.sun_path)) {
+        cout << "Server Error: socket path too long" << endl;
+        return;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
 
-    try {
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        cout << "Server Error: cannot create socket" << endl;
+        return;
+    }
+    unlink(socketPath.c_str());
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 64) < 0) {
+        cout << "Server Error: cannot listen on " << socketPath << endl;
+        close(listener);
+        return;
+    }
 
-        applications->saveToFile("applications.txt");
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, requestServerStop);
+    signal(SIGTERM, requestServerStop);
 
-        cout << "Saved " << applications->getCount() << " applications to file.\n";
+    // Non-blocking, so a full pipe never stalls a worker; a wake-up
+    // already pending is as good as another
+    if (pipe(serverState.wakePipe) < 0) {
+        cout << "Server Error: cannot create wake-up pipe" << endl;
+        close(listener);
+        return;
+    }
+    fcntl(serverState.wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(serverState.wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    ThreadPool pool(threadCount);
+    cout << "Serving on " << socketPath << " with " << pool.getThreadCount() << " worker threads" << endl;
+    logEvent("SERVER", "Server started on " + socketPath);
+
+    long lastSweepDay = currentDayNumber();
+    pollfd waitFor[MAX_SERVER_CONNECTIONS + 2];
+    ServerConnection* polled[MAX_SERVER_CONNECTIONS];
+    char chunk[4096];
+    while (!serverStopRequested) {
+        // Listen on the socket, the wake-up pipe and every idle client;
+        // connections done with are closed here, never by a worker
+        int polledCount = 0;
+        {
+            ScopedLock guard(serverState.mutex);
+            for (int i = serverState.clientCount - 1; i >= 0; i--) {
+                ServerConnection* connection = serverState.clients[i];
+                if (connection->busy) continue;
+                if (connection->closing) {
+                    close(connection->socket);
+                    delete connection;
+                    serverState.clients[i] = serverState.clients[--serverState.clientCount];
+                    continue;
+                }
+                polled[polledCount] = connection;
+                waitFor[polledCount + 2].fd = connection->socket;
+                waitFor[polledCount + 2].events = POLLIN;
+                waitFor[polledCount + 2].revents = 0;
+                polledCount++;
+            }
+        }
+        waitFor[0].fd = listener;
+        waitFor[1].fd = serverState.wakePipe[0];
+        for (int i = 0; i < 2; i++) {
+            waitFor[i].events = POLLIN;
+            waitFor[i].revents = 0;
+        }
+        int ready = poll(waitFor, polledCount + 2, 1000);
 
-        logEvent("SYSTEM", "Applications saved to file");
+        // Close jobs once the date changes
+        if (currentDayNumber() != lastSweepDay) {
+            WriteLock lock(systemLock);
+            sweepExpiredJobs();
+            lastSweepDay = currentDayNumber();
+        }
+        if (ready <= 0) continue;
 
-    } catch (const FileException& e) {
+        if (waitFor[1].revents != 0) {
+            while (read(serverState.wakePipe[0], chunk, sizeof(chunk)) > 0) {}
+        }
 
-        cout << "Error: " << e.what() << endl;
+        // Read from idle clients; a complete line hands the connection to the pool
+        for (int i = 0; i < polledCount; i++) {
+            if (waitFor[i + 2].revents == 0) continue;
+            ServerConnection* connection = polled[i];
+            ssize_t n = recv(connection->socket, chunk, sizeof(chunk), 0);
+            if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            if (n <= 0) {
+                connection->closing = true;
+                continue;
+            }
+            connection->buffer.append(chunk, (size_t)n);
+            if (connection->buffer.find('\n') == string::npos) continue;
+            {
+                ScopedLock guard(serverState.mutex);
+                connection->busy = true;
+            }
+            pool.submit(serveRequests, connection);
+        }
 
-        logEvent("ERROR", e.what());
+        if ((waitFor[0].revents & POLLIN) == 0) continue;
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+
+        ScopedLock guard(serverState.mutex);
+        if (serverState.clientCount >= MAX_SERVER_CONNECTIONS) {
+            writeToSocket(client, "ERR server busy\n");
+            close(client);
+            continue;
+        }
+        writeToSocket(client, "OK InternshipSystem server ready\n");
+        ServerConnection* connection = new ServerConnection;
+        connection->socket = client;
+        connection->system = this;
+        connection->busy = false;
+        connection->closing = false;
+        serverState.clients[serverState.clientCount++] = connection;
+    }
 
+    // Stop workers blocked writing to a client, let the pool answer what it
+    // was handed, then close every connection
+    close(listener);
+    {
+        ScopedLock guard(serverState.mutex);
+        for (int i = 0; i < serverState.clientCount; i++) {
+            shutdown(serverState.clients[i]->socket, SHUT_RDWR);
+        }
+    }
+    pool.shutdown();
+    {
+        ScopedLock guard(serverState.mutex);
+        for (int i = 0; i < serverState.clientCount; i++) {
+            close(serverState.clients[i]->socket);
+            delete serverState.clients[i];
+        }
+        serverState.clientCount = 0;
     }
+    close(serverState.wakePipe[0]);
+    close(serverState.wakePipe[1]);
+    unlink(socketPath.c_str());
+    backupThread.join();
 
+    {
+        WriteLock lock(systemLock);
+        compactDecisionLog();
+    }
+    cout << "Server stopped." << endl;
+    logEvent("SERVER", "Server stopped");
+#endif
 }
 
 
@@ -2558,7 +7681,7 @@ void InternshipSystem::mainMenu()
                 Student* student = new Student();
                 if (student->login()) 
                 {
-                    studentMenu();
+                    studentMenu(student);
                 }
                 delete student;
 
@@ -2607,12 +7730,18 @@ void InternshipSystem::mainMenu()
 
 
 
-void InternshipSystem::studentMenu() 
+void InternshipSystem::studentMenu(Student* student) 
 {
     int choice;
-    Student tempStudent;
+
+    // Work on the system's record for this student when there is one
+    Student* record = hashSearchStudent(student->getID());
+    Student& tempStudent = (record != NULL) ? *record : *student;
 
     do {
+        // Close jobs whose deadline passed; the job views read the published catalog
+        sweepExpiredJobs();
+
         cout << "\n=== Student Menu ===\n";
         cout << "1. View Internships\n";
         cout << "2. Apply for Internship\n";
@@ -2620,23 +7749,24 @@ void InternshipSystem::studentMenu()
         cout << "4. Generate Summary Report\n";
         cout << "5. Update Profile\n";
         cout << "6. Search Jobs by Company\n";
-        cout << "7. Logout\n";
+        cout << "7. Jobs Closing Soon\n";
+        cout << "8. Logout\n";
         cout << "Enter choice: ";
         cin >> choice;
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
         switch (choice) {
             case 1:
-                tempStudent.viewInternships();
+                tempStudent.viewInternships(this);
                 break;
             case 2:
-                tempStudent.applyForInternship();
+                tempStudent.applyForInternship(this);
                 break;
             case 3:
                 tempStudent.viewMyApplications();
                 break;
             case 4:
-                tempStudent.generateSummaryReport();
+                tempStudent.generateSummaryReport(promptReportFormat());
                 break;
             case 5:
                 tempStudent.updateProfile();
@@ -2650,6 +7780,15 @@ void InternshipSystem::studentMenu()
                 }
                 break;
             case 7:
+                {
+                    int days;
+                    cout << "Show jobs closing within how many days? ";
+                    cin >> days;
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    displayJobsClosingWithin(days);
+                }
+                break;
+            case 8:
                 cout << "Logging out...\n";
                 return;
             default:
@@ -2673,7 +7812,10 @@ void InternshipSystem::adminMenu()
         cout << "5. Search Students by Diploma\n";
         cout << "6. Search Students by CGPA Range\n";
         cout << "7. Search Jobs by Company\n";
-        cout << "8. Logout\n";
+        cout << "8. Bulk Import Applications\n";
+        cout << "9. Backup and Restore\n";
+        cout << "10. System Diagnostics\n";
+        cout << "11. Logout\n";
         cout << "Enter choice: ";
         cin >> choice;
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -2689,7 +7831,7 @@ void InternshipSystem::adminMenu()
                 currentAdmin->viewAllApplications();
                 break;
             case 4:
-                currentAdmin->generateReports();
+                reportsMenu(currentAdmin);
                 break;
             case 5:
                 {
@@ -2719,6 +7861,24 @@ void InternshipSystem::adminMenu()
                 }
                 break;
             case 8:
+                bulkImportMenu();
+                break;
+            case 9:
+                backupMenu();
+                break;
+            case 10:
+                {
+                    cout << "Save a copy of the diagnostics? (y/n): ";
+                    string answer;
+                    getline(cin, answer);
+                    if (answer == "y" || answer == "Y") {
+                        runSystemDiagnostics(promptReportFormat(), reportFileBase("diagnostics_"));
+                    } else {
+                        runSystemDiagnostics();
+                    }
+                }
+                break;
+            case 11:
                 cout << "Logging out...\n";
                 delete currentAdmin; // Clean up
                 return;
@@ -2738,7 +7898,10 @@ void InternshipSystem::staffMenu(Staff* staff)
         cout << "3. View Department Internships\n";
         cout << "4. Search Students by CGPA Range\n";
         cout << "5. Search Jobs by Company\n";
-        cout << "6. Logout\n";
+        cout << "6. Batch Approve/Reject\n";
+        cout << "7. Department Dashboard\n";
+        cout << "8. Rank Applicants for a Job\n";
+        cout << "9. Logout\n";
         cout << "Enter choice: ";
         cin >> choice;
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -2748,7 +7911,7 @@ void InternshipSystem::staffMenu(Staff* staff)
                 staff->processApplications(this);
                 break;
             case 2:
-                staff->generateDepartmentReport(this);
+                staff->generateDepartmentReport(this, promptReportFormat());
                 break;
             case 3:
                 staff->viewDepartmentInternships(this);
@@ -2773,7 +7936,17 @@ void InternshipSystem::staffMenu(Staff* staff)
                 }
                 break;
             case 6:
+                batchDecisionMenu();
+                break;
+            case 7:
+                departmentDashboard(staff->getDepartment());
+                break;
+            case 8:
+                candidateRankingMenu();
+                break;
+            case 9:
                 cout << "Logging out...\n";
+                compactDecisionLog();
                 currentStaff = NULL;
                 return;
             default:
@@ -2784,144 +7957,226 @@ void InternshipSystem::staffMenu(Staff* staff)
 
 
 // Fix sorting algorithms
-void InternshipSystem::selectionSortStudentsByCGPA() 
+// Sort orders. As a friend of Person these compare the ID and name in
+// place instead of copying them through the getters.
+bool InternshipSystem::studentHasHigherCGPA(Student* const& a, Student* const& b)
 {
-    for (int i = 0; i < studentCount - 1; i++) {
-        int maxIndex = i;
-        for (int j = i + 1; j < studentCount; j++) {
-            if (students[j]->getCGPA() > students[maxIndex]->getCGPA()) {
-                maxIndex = j;
-            }
-        }
-        if (maxIndex != i) {
-            Student* temp = students[i];
-            students[i] = students[maxIndex];  // ? Fix this line
-            students[maxIndex] = temp;         // ? Fix this line
-        }
-    }
-    cout << "Students sorted by CGPA.\n";
-    logEvent("SYSTEM", "Students sorted by CGPA");
+    return a->getCGPA() > b->getCGPA();
 }
 
-void InternshipSystem::selectionSortStudentsByID() 
+bool InternshipSystem::studentHasLowerID(Student* const& a, Student* const& b)
 {
-    for (int i = 0; i < studentCount - 1; i++) {
-        int minIndex = i;
-        for (int j = i + 1; j < studentCount; j++) {
-            if (students[j]->getID() < students[minIndex]->getID()) {
-                minIndex = j;
-            }
-        }
-        if (minIndex != i) {
-            Student* temp = students[i];
-            students[i] = students[minIndex];
-            students[minIndex] = temp;
-        }
-    }
-    cout << "Students sorted by ID.\n";
-    logEvent("SYSTEM", "Students sorted by ID");
+    return a->id < b->id;
 }
 
+bool InternshipSystem::studentNameBefore(Student* const& a, Student* const& b)
+{
+    return a->name < b->name;
+}
 
+bool InternshipSystem::jobDeadlineBefore(InternshipJob* const& a, InternshipJob* const& b)
+{
+    return a->getDeadlineDay() < b->getDeadlineDay();
+}
 
-void InternshipSystem::bubbleSortJobsByDeadline() 
+bool InternshipSystem::jobTitleBefore(InternshipJob* const& a, InternshipJob* const& b)
+{
+    return a->getTitle() < b->getTitle();
+}
 
+bool InternshipSystem::jobCompanyBefore(InternshipJob* const& a, InternshipJob* const& b)
 {
-    for (int i = 0; i < jobCount - 1; i++) {
-        for (int j = 0; j < jobCount - i - 1; j++) {
+    return a->getCompany() < b->getCompany();
+}
 
-            if (jobs[j]->getDeadline() > jobs[j + 1]->getDeadline()) {
-                InternshipJob* temp = jobs[j];
-                jobs[j] = jobs[j + 1];
-                jobs[j + 1] = temp;
-            }
-        }
+
+// Stable merge sort: split across the task scheduler from
+// PARALLEL_SORT_THRESHOLD elements up, on this thread below it. Both paths
+// run the same merge sort, so they give the same order, ties included.
+void InternshipSystem::sortStudents(StudentOrder less)
+{
+    MetricTimer timer(metrics, METRIC_SORT);
+    TRACE_SCOPE("sort", "InternshipSystem::sortStudents");
+    beforeStoreChange(STUDENTS_FILE);
+    if (studentCount >= PARALLEL_SORT_THRESHOLD) {
+        parallelStableSort(*scheduler, students, studentCount, less);
+    } else {
+        sequentialStableSort(students, studentCount, less);
     }
-    cout << "Jobs sorted by deadline using Bubble Sort.\n";
-    logEvent("SYSTEM", "Jobs sorted by deadline");
 }
 
+void InternshipSystem::sortJobs(JobOrder less)
+{
+    MetricTimer timer(metrics, METRIC_SORT);
+    TRACE_SCOPE("sort", "InternshipSystem::sortJobs");
+    beforeStoreChange(JOBS_FILE);
+    if (jobCount >= PARALLEL_SORT_THRESHOLD) {
+        parallelStableSort(*scheduler, jobs, jobCount, less);
+    } else {
+        sequentialStableSort(jobs, jobCount, less);
+    }
+}
 
 
-void InternshipSystem::mergeSortJobsByCompany(int low, int high) 
-
+// Grows the student array so it holds at least `needed` students
+void InternshipSystem::reserveStudents(int needed)
 {
+    if (needed <= studentCapacity) return;
 
-    if (low < high) {
+    int newCapacity = studentCapacity;
+    while (newCapacity < needed) newCapacity *= 2;
 
-        int mid = low + (high - low) / 2;
-
-        mergeSortJobsByCompany(low, mid);
-        mergeSortJobsByCompany(mid + 1, high);
-        mergeJobsByCompany(low, mid, high);
-    }
+    Student** bigger = new Student*[newCapacity];
+    for (int i = 0; i < studentCount; i++) bigger[i] = students[i];
+    for (int i = studentCount; i < newCapacity; i++) bigger[i] = NULL;
+    delete[] students;
+    students = bigger;
+    studentCapacity = newCapacity;
 }
 
 
+// A student with its position in the student array, which breaks CGPA ties
+// the same way a stable sort by CGPA would
+struct RankedStudent
+{
+    Student* student;
+    int position;
+};
 
-void InternshipSystem::mergeJobsByCompany(int low, int mid, int high) 
-
+bool rankedHigher(const RankedStudent& a, const RankedStudent& b)
 {
+    float cgpaA = a.student->getCGPA(), cgpaB = b.student->getCGPA();
+    if (cgpaA != cgpaB) return cgpaA > cgpaB;
+    return a.position < b.position;
+}
 
-    int n1 = mid - low + 1;
+typedef BoundedTopK<RankedStudent, REPORT_TOP_STUDENTS, rankedHigher> TopStudents;
 
-    int n2 = high - mid;
 
+// CGPA and diploma figures used by the admin reports
+struct StudentStatistics
+{
+    int count;
+    double totalCGPA;
+    float highestCGPA;
+    float lowestCGPA;
+    int itCount, businessCount, accountingCount;
+    int gradeA, gradeB, gradeC, gradeD;
+    TopStudents topStudents;
+
+    StudentStatistics() : count(0), totalCGPA(0.0), highestCGPA(0.0f), lowestCGPA(4.0f),
+                          itCount(0), businessCount(0), accountingCount(0),
+                          gradeA(0), gradeB(0), gradeC(0), gradeD(0) {}
+
+    void add(Student* student, int position)
+    {
+        RankedStudent ranked = { student, position };
+        topStudents.offer(ranked);
+
+        float cgpa = student->getCGPA();
+        count++;
+        totalCGPA += cgpa;
+        if (cgpa > highestCGPA) highestCGPA = cgpa;
+        if (cgpa < lowestCGPA) lowestCGPA = cgpa;
+
+        if (cgpa >= 3.5) gradeA++;
+        else if (cgpa >= 3.0) gradeB++;
+        else if (cgpa >= 2.5) gradeC++;
+        else gradeD++;
+
+        string diploma = student->getDiploma();
+        if (diploma == "IT") itCount++;
+        else if (diploma == "Business") businessCount++;
+        else if (diploma == "Accounting") accountingCount++;
+    }
 
+    void merge(const StudentStatistics& other)
+    {
+        count += other.count;
+        totalCGPA += other.totalCGPA;
+        if (other.highestCGPA > highestCGPA) highestCGPA = other.highestCGPA;
+        if (other.lowestCGPA < lowestCGPA) lowestCGPA = other.lowestCGPA;
+        itCount += other.itCount;
+        businessCount += other.businessCount;
+        accountingCount += other.accountingCount;
+        gradeA += other.gradeA;
+        gradeB += other.gradeB;
+        gradeC += other.gradeC;
+        gradeD += other.gradeD;
+        topStudents.merge(other.topStudents);
+    }
+};
 
 
-    // Use raw arrays instead
-    InternshipJob** left = new InternshipJob*[n1];
-    InternshipJob** right = new InternshipJob*[n2];
+struct StatisticsContext
+{
+    Student** students;
+    StudentStatistics total;
+    Mutex mutex;
+};
 
+void collectStudentStatistics(void* context, int begin, int end)
+{
+    StatisticsContext* stats = (StatisticsContext*)context;
+    StudentStatistics part;
+    for (int i = begin; i < end; i++) {
+        part.add(stats->students[i], i);
+    }
+    ScopedLock guard(stats->mutex);
+    stats->total.merge(part);
+}
 
+// One parallel pass over the students
+StudentStatistics computeStudentStatistics(TaskScheduler& scheduler, Student** students, int count)
+{
+    TRACE_SCOPE("report", "computeStudentStatistics");
+    StatisticsContext context;
+    context.students = students;
+    scheduler.parallelFor(0, count, 0, collectStudentStatistics, &context);
+    return context.total;
+}
 
-    for (int i = 0; i < n1; i++)
 
-        left[i] = jobs[low + i];
+void InternshipSystem::selectionSortStudentsByCGPA() 
+{
+    sortStudents(studentHasHigherCGPA);
+    cout << "Students sorted by CGPA.\n";
+    logEvent("SYSTEM", "Students sorted by CGPA");
+}
 
-    for (int j = 0; j < n2; j++)
+void InternshipSystem::selectionSortStudentsByID() 
+{
+    sortStudents(studentHasLowerID);
+    cout << "Students sorted by ID.\n";
+    logEvent("SYSTEM", "Students sorted by ID");
+}
 
-        right[j] = jobs[mid + 1 + j];
 
 
+void InternshipSystem::bubbleSortJobsByDeadline() 
 
-    int i = 0, j = 0, k = low;
-    while (i < n1 && j < n2) 
-    {
-        if (left[i]->getCompany() <= right[j]->getCompany()) 
-        {
-            jobs[k] = left[i];
-            i++;
-        } else {
-            jobs[k] = right[j];
-            j++;
-        }
-        k++;
-    }
+{
+    sortJobs(jobDeadlineBefore);
+    publishJobCatalog();
+    cout << "Jobs sorted by deadline.\n";
+    logEvent("SYSTEM", "Jobs sorted by deadline");
+}
 
-    while (i < n1) 
-    {
-        jobs[k] = left[i];
-        i++;
-        k++;
-    }
 
-    while (j < n2) 
-    {
-        jobs[k] = right[j];
-        j++;
-        k++;
-    }
 
-    // Clean up memory
-    delete[] left;
-    delete[] right;
+void InternshipSystem::mergeSortJobsByCompany() 
+{
+    sortJobs(jobCompanyBefore);
+    publishJobCatalog();
+    cout << "Jobs sorted by company.\n";
+    logEvent("SYSTEM", "Jobs sorted by company");
 }
 
 // Fix search algorithms
 int InternshipSystem::binarySearchStudentByID(string targetID) 
 {
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::binarySearchStudentByID");
     selectionSortStudentsByID(); // Ensure sorted array for binary search
     int left = 0, right = studentCount - 1;
     while (left <= right) {
@@ -2936,6 +8191,8 @@ int InternshipSystem::binarySearchStudentByID(string targetID)
 
 int InternshipSystem::linearSearchJobByTitle(string title) 
 {
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::linearSearchJobByTitle");
 
     for (int i = 0; i < jobCount; i++) {
         if (jobs[i]->getTitle().find(title) != string::npos) {
@@ -2947,6 +8204,8 @@ int InternshipSystem::linearSearchJobByTitle(string title)
 
 int InternshipSystem::fibonacciSearchStudentByID(string targetID) 
 {
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::fibonacciSearchStudentByID");
     selectionSortStudentsByID(); // Ensure sorted
     
     int fibM2 = 0; // (m-2)'th Fibonacci number
@@ -2990,6 +8249,8 @@ int InternshipSystem::fibonacciSearchStudentByID(string targetID)
 
 int InternshipSystem::interpolationSearchStudentByCGPA(float targetCGPA) 
 {
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::interpolationSearchStudentByCGPA");
     selectionSortStudentsByCGPA(); // Ensure sorted by CGPA
     
     int low = 0;
@@ -3112,107 +8373,538 @@ bool InternshipSystem::validatePassword(string password)
     return true;
 }
 
-// Extended file management functions
-void InternshipSystem::backupSystemData() 
+// Extended file management functions
+// Data files captured by a backup and the store each one comes from
+const char* const BACKUP_FILES[] = { "students.txt", "job_listings.txt", "staff.txt",
+                                     "login_admin.txt", "applications.txt" };
+const DataFileKind BACKUP_KINDS[] = { STUDENTS_FILE, JOBS_FILE, STAFF_FILE, ADMINS_FILE, APPLICATIONS_FILE };
+const int BACKUP_FILE_COUNT = 5;
+const int RESTORE_BATCH_CHUNKS = 64;   // Chunks expanded at once during a restore
+
+// Renders up to limit records of a frozen store, in its data file format,
+// from where the backup left off. Returns true once the whole store has
+// been rendered. Call with snapshotMutex held.
+bool InternshipSystem::renderSnapshotBatch(OnlineSnapshot* snapshot, DataFileKind kind, string& text, int limit)
+{
+    if (snapshot->detached[kind]) return true;
+
+    ostringstream rendered;
+    OutputBuffer out(rendered);
+    if (kind == APPLICATIONS_FILE) {
+        ApplicationNode* node = snapshot->nextApplication;
+        for (int n = 0; n < limit && !snapshot->detached[kind]; n++) {
+            const string* kept = snapshot->findStatus(node);
+            ApplicationList::writeLine(out, node, kept != NULL ? *kept : node->status);
+            if (node == snapshot->lastApplication) {
+                snapshot->detached[kind] = true;
+            } else {
+                node = node->next;
+            }
+        }
+        snapshot->nextApplication = node;
+    } else {
+        int& i = snapshot->cursor[kind];
+        int end = min(snapshot->frozenCount[kind], (limit < INT_MAX - i) ? i + limit : INT_MAX);
+        for (; i < end; i++) {
+            if (kind == STUDENTS_FILE) saveStudentToFile(*students[i], out);
+            else if (kind == JOBS_FILE) saveJobToFile(*jobs[i], out);
+            else if (kind == STAFF_FILE) ::saveStaffToFile(*staffMembers[i], out);
+            else saveAdminToFile(*admins[i], out);
+        }
+        if (i == snapshot->frozenCount[kind]) snapshot->detached[kind] = true;
+    }
+    out.flush();
+    text += rendered.str();
+    return snapshot->detached[kind];
+}
+
+
+// Call before changing a store in any way, including appends and
+// reordering: a running online backup gets the rest of the store as it is
+// now, so the change does not reach it
+void InternshipSystem::beforeStoreChange(DataFileKind kind)
+{
+    ScopedLock guard(snapshotMutex);
+    if (onlineSnapshot != NULL) {
+        renderSnapshotBatch(onlineSnapshot, kind, onlineSnapshot->rest[kind], INT_MAX);
+    }
+}
+
+
+void InternshipSystem::beforeAllStoresChange()
+{
+    for (int i = 0; i < DATA_FILE_KINDS; i++) beforeStoreChange((DataFileKind)i);
+}
+
+
+// Streams one frozen store into the chunk store a batch at a time; the
+// manifest section and counts are left in the part, errors in part->error
+void InternshipSystem::writeBackupPart(void* argument)
+{
+    TRACE_SCOPE("backup", "InternshipSystem::writeBackupPart");
+    BackupPart* part = (BackupPart*)argument;
+    InternshipSystem* system = part->system;
+
+    ChunkingStreamBuf chunker(*part->store, part->filename);
+    ostream file(&chunker);
+    bool finished = false;
+    while (!finished) {
+        string text;
+        {
+            ScopedLock guard(system->snapshotMutex);
+            if (part->snapshot->detached[part->kind]) {
+                text.swap(part->snapshot->rest[part->kind]);
+                finished = true;
+            } else {
+                finished = system->renderSnapshotBatch(part->snapshot, part->kind, text, SNAPSHOT_BATCH_RECORDS);
+            }
+        }
+        file.write(text.data(), text.size());
+    }
+    chunker.finish();
+
+    part->manifest = chunker.getManifest();
+    part->bytes = chunker.getTotalBytes();
+    part->newBytes = chunker.getNewBytes();
+    part->chunks = chunker.getChunkCount();
+    part->newChunks = chunker.getNewChunkCount();
+    if (!chunker.good() || !file) {
+        part->error = "Cannot write backup chunks for " + part->filename;
+    }
+}
+
+
+// Snapshot IDs sort by time: YYYYMMDD-HHMMSS, suffixed if taken by a
+// snapshot or by the pack of a backup that failed before its manifest.
+// This reads the backup directory, so call it before taking any lock.
+string InternshipSystem::newSnapshotID()
+{
+    time_t now = time(0);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+    string snapshotID = stamp;
+    for (int n = 2; ChunkStore::isNameUsed(BACKUP_DIRECTORY, snapshotID); n++) {
+        stringstream suffixed;
+        suffixed << stamp << "-" << n;
+        snapshotID = suffixed.str();
+    }
+    return snapshotID;
+}
+
+
+// Freezes every store for a backup under snapshotID (see newSnapshotID()).
+// Only the extent of each store is recorded, so this is O(1) however large
+// the data; writers must be held off just for the call. Returns NULL if a
+// backup is already running.
+OnlineSnapshot* InternshipSystem::freezeSnapshot(const string& snapshotID)
+{
+    TRACE_SCOPE("backup", "InternshipSystem::freezeSnapshot");
+    ensureApplicationsLoaded();
+
+    ScopedLock guard(snapshotMutex);
+    if (onlineSnapshot != NULL) return NULL;
+
+    OnlineSnapshot* snapshot = new OnlineSnapshot();
+    snapshot->frozenCount[STUDENTS_FILE] = studentCount;
+    snapshot->frozenCount[STAFF_FILE] = staffCount;
+    snapshot->frozenCount[ADMINS_FILE] = adminCount;
+    snapshot->frozenCount[JOBS_FILE] = jobCount;
+    for (int i = 0; i < DATA_FILE_KINDS; i++) {
+        snapshot->detached[i] = (i == APPLICATIONS_FILE) ? applications->getHead() == NULL
+                                                         : snapshot->frozenCount[i] == 0;
+    }
+    snapshot->nextApplication = applications->getHead();
+    snapshot->lastApplication = applications->getTail();
+    snapshot->snapshotID = snapshotID;
+    snapshot->createdAt = getCurrentTimestamp();
+
+    onlineSnapshot = snapshot;
+    return snapshot;
+}
+
+
+// Takes a snapshot of every store. Files are cut into content-defined
+// chunks and only chunks the backup store does not hold yet are written,
+// so after a small change a backup adds a few chunks and one manifest.
+// Returns the snapshot ID, or "" on failure.
+string InternshipSystem::backupSystemData()
+{
+    TRACE_SCOPE("backup", "InternshipSystem::backupSystemData");
+    OnlineSnapshot* snapshot = freezeSnapshot(newSnapshotID());
+    if (snapshot == NULL) {
+        cout << "Backup Error: Another backup is still running" << endl;
+        return "";
+    }
+    return writeSnapshot(snapshot);
+}
+
+
+// Server mode: freezes the stores and writes the backup on backupThread, so
+// requests keep being served meanwhile. Call with systemLock held
+// exclusively and an ID from newSnapshotID() picked before taking it.
+// Returns the snapshot ID, or "" if a backup is running.
+string InternshipSystem::startBackgroundBackup(const string& snapshotID)
+{
+    OnlineSnapshot* snapshot = freezeSnapshot(snapshotID);
+    if (snapshot == NULL) return "";
+    backupThread.join();   // The last backup has released its snapshot and is exiting
+    if (!backupThread.start(runBackgroundBackup, this)) {
+        writeSnapshot(snapshot);
+    }
+    return snapshotID;
+}
+
+
+void InternshipSystem::runBackgroundBackup(void* argument)
+{
+    InternshipSystem* system = (InternshipSystem*)argument;
+    OnlineSnapshot* snapshot;
+    {
+        ScopedLock guard(system->snapshotMutex);
+        snapshot = system->onlineSnapshot;
+    }
+    system->writeSnapshot(snapshot);
+}
+
+
+// Writes a frozen snapshot to the backup store and releases it
+string InternshipSystem::writeSnapshot(OnlineSnapshot* snapshot)
+{
+    MetricTimer timer(metrics, METRIC_BACKUP);
+    TRACE_SCOPE("backup", "InternshipSystem::writeSnapshot");
+    string snapshotID = snapshot->snapshotID;
+    try {
+        double startTime = getWallClockSeconds();
+
+        ChunkStore store(BACKUP_DIRECTORY);
+        if (!store.open()) {
+            throw FileException("Cannot open backup directory " + BACKUP_DIRECTORY);
+        }
+        if (!store.beginPack(snapshotID)) {
+            throw FileException("Cannot create backup pack for " + snapshotID);
+        }
+
+        // The files are independent, so chunk and compress them at the same time
+        BackupPart parts[BACKUP_FILE_COUNT];
+        {
+            TaskGroup group(*scheduler);
+            for (int i = 0; i < BACKUP_FILE_COUNT; i++) {
+                parts[i].system = this;
+                parts[i].snapshot = snapshot;
+                parts[i].store = &store;
+                parts[i].kind = BACKUP_KINDS[i];
+                parts[i].filename = BACKUP_FILES[i];
+                group.spawn(writeBackupPart, &parts[i]);
+            }
+            group.wait();
+        }
+
+        long long bytes = 0, newBytes = 0;
+        int chunks = 0, newChunks = 0;
+        string manifest = "IGS-SNAPSHOT 1\nsnapshot|" + snapshotID + "|" + snapshot->createdAt + "\n";
+        for (int i = 0; i < BACKUP_FILE_COUNT; i++) {
+            if (!parts[i].error.empty()) {
+                throw FileException(parts[i].error);
+            }
+            manifest += parts[i].manifest;
+            bytes += parts[i].bytes;
+            newBytes += parts[i].newBytes;
+            chunks += parts[i].chunks;
+            newChunks += parts[i].newChunks;
+        }
+        if (!store.finishPack()) {
+            throw FileException("Cannot write backup pack for " + snapshotID);
+        }
+        long long storedBytes = store.getPackStoredBytes();
+
+        // The manifest goes last and appears in one rename, so a snapshot
+        // that can be listed has all of its chunks in finished packs. The
+        // saver is local: a background backup runs beside the other savers.
+        DurableSaver manifestSaver;
+        string manifestPath = store.getRoot() + "/snapshots/" + snapshotID + ".manifest";
+        if (!manifestSaver.save(manifestPath, manifest)) {
+            throw FileException("Cannot write " + manifestPath);
+        }
+
+        stringstream entry;
+        entry << snapshotID << "|" << snapshot->createdAt << "|" << bytes << "|" << newBytes << "|"
+              << chunks << "|" << newChunks << "|" << storedBytes << "\n";
+        if (!appendDurably(store.getRoot() + "/snapshots.txt", entry.str())) {
+            throw FileException("Cannot update " + store.getRoot() + "/snapshots.txt");
+        }
+
+        int keptStatuses;
+        {
+            ScopedLock guard(snapshotMutex);
+            keptStatuses = snapshot->keptCount;
+            onlineSnapshot = NULL;
+        }
+        delete snapshot;
+
+        stringstream summary;
+        summary << "Backup " << snapshotID << ": " << bytes << " bytes in " << chunks << " chunks, "
+                << newChunks << " new (" << newBytes << " bytes, " << storedBytes << " compressed) in "
+                << fixed << setprecision(1) << (getWallClockSeconds() - startTime) * 1000 << " ms";
+        if (keptStatuses > 0) summary << ", " << keptStatuses << " status change(s) held back";
+        cout << summary.str() << endl;
+        logEvent("SYSTEM", summary.str());
+        return snapshotID;
+
+    } catch (const FileException& e) {
+        {
+            ScopedLock guard(snapshotMutex);
+            onlineSnapshot = NULL;
+        }
+        delete snapshot;
+        cout << "Backup Error: " << e.what() << endl;
+        logEvent("ERROR", "Backup failed: " + string(e.what()));
+        return "";
+    }
+}
+
+
+void InternshipSystem::readRestoreChunk(void* argument)
+{
+    TRACE_SCOPE("restore", "InternshipSystem::readRestoreChunk");
+    RestoreChunk* chunk = (RestoreChunk*)argument;
+    chunk->ok = chunk->store->get(chunk->hash, chunk->data) && (long long)chunk->data.size() == chunk->size;
+}
+
+
+// Expands a batch of chunks, at the same time when parallel, and appends
+// them to the file being restored in manifest order
+void InternshipSystem::writeRestoreBatch(RestoreChunk* batch, int count, bool parallel, FILE* output,
+                                         Sha256& fileHash, long long& fileBytes)
+{
+    if (parallel && count > 1) {
+        TaskGroup group(*scheduler);
+        for (int i = 0; i < count; i++) group.spawn(readRestoreChunk, &batch[i]);
+        group.wait();
+    } else {
+        for (int i = 0; i < count; i++) readRestoreChunk(&batch[i]);
+    }
+    for (int i = 0; i < count; i++) {
+        if (!batch[i].ok) {
+            throw FileException("Backup chunk missing or damaged: " + batch[i].hash);
+        }
+        if (fwrite(batch[i].data.data(), 1, batch[i].data.size(), output) != batch[i].data.size()) {
+            throw FileException("Cannot write restored data");
+        }
+        fileHash.update(batch[i].data.data(), batch[i].data.size());
+        fileBytes += batch[i].data.size();
+        batch[i].data.clear();
+    }
+}
+
+
+// Rolls every data file back to a snapshot and reloads all stores and
+// indexes from them. The current data is snapshotted first, and nothing is
+// replaced until every chunk of the snapshot has been read and verified.
+// Chunks are streamed from the packs and expanded in batches, on all cores
+// unless parallel is false.
+bool InternshipSystem::restoreSystemData(string snapshotID, bool parallel)
 {
+    MetricTimer timer(metrics, METRIC_RESTORE);
+    TRACE_SCOPE("restore", "InternshipSystem::restoreSystemData");
+    string restored[BACKUP_FILE_COUNT];
+    int restoredCount = 0;
+    FILE* output = NULL;
     try {
-        // Create backup directory if not exists
-        string backupDir = "backup_" + getCurrentTimestamp();
-        
-        // Backup students
-        string studentBackup = backupDir + "_students.txt";
-        ofstream studentFile(studentBackup.c_str());
-        if (!studentFile.is_open()) {
-            throw FileException("Cannot create student backup file");
+        double startTime = getWallClockSeconds();
+        string manifestPath = BACKUP_DIRECTORY + "/snapshots/" + snapshotID + ".manifest";
+        ifstream manifest(manifestPath.c_str());
+        if (!manifest.is_open()) {
+            throw FileException("Backup snapshot not found: " + snapshotID);
         }
-        
-        for (int i = 0; i < studentCount; i++) {
-            saveStudentToFile(*students[i], studentFile);
+        string line;
+        if (!getline(manifest, line) || line != "IGS-SNAPSHOT 1") {
+            throw FileException("Not a snapshot manifest: " + manifestPath);
         }
-        studentFile.close();
-        
-        // Backup jobs
-        string jobBackup = backupDir + "_jobs.txt";
-        ofstream jobFile(jobBackup.c_str());
-        if (!jobFile.is_open()) {
-            throw FileException("Cannot create job backup file");
+
+        string undoID = backupSystemData();
+        if (undoID.empty()) {
+            throw FileException("Cannot snapshot the current data before restoring");
         }
-        
-        for (int i = 0; i < jobCount; i++) {
-            saveJobToFile(*jobs[i], jobFile);
+        cout << "Current data kept as snapshot " << undoID << endl;
+
+        ChunkStore store(BACKUP_DIRECTORY);
+        if (!store.open()) {
+            throw FileException("Cannot open backup directory " + BACKUP_DIRECTORY);
         }
-        jobFile.close();
-        
-        // Backup staff
-        string staffBackup = backupDir + "_staff.txt";
-        ofstream staffFile(staffBackup.c_str());
-        if (!staffFile.is_open()) {
-            throw FileException("Cannot create staff backup file");
+
+        // Rebuild each file next to the original and check it against the manifest
+        Sha256 fileHash;
+        long long fileBytes = 0;
+        RestoreChunk* batch = new RestoreChunk[RESTORE_BATCH_CHUNKS];
+        int batchCount = 0;
+        try {
+            while (getline(manifest, line)) {
+                stringstream fields(line);
+                string kind, first, second;
+                getline(fields, kind, '|');
+                getline(fields, first, '|');
+                getline(fields, second, '|');
+
+                if (kind == "file") {
+                    bool known = false;
+                    for (int i = 0; i < BACKUP_FILE_COUNT; i++) {
+                        if (first == BACKUP_FILES[i]) known = true;
+                    }
+                    if (!known || output != NULL || restoredCount == BACKUP_FILE_COUNT) {
+                        throw FileException("Unexpected file in snapshot: " + first);
+                    }
+                    restored[restoredCount] = first;
+                    output = fopen((first + ".restore").c_str(), "wb");
+                    if (output == NULL) {
+                        throw FileException("Cannot create " + first + ".restore");
+                    }
+                    restoredCount++;
+                    fileHash.reset();
+                    fileBytes = 0;
+                } else if (kind == "chunk" && output != NULL) {
+                    batch[batchCount].store = &store;
+                    batch[batchCount].hash = first;
+                    batch[batchCount].size = stringToLongLong(second);
+                    if (++batchCount == RESTORE_BATCH_CHUNKS) {
+                        writeRestoreBatch(batch, batchCount, parallel, output, fileHash, fileBytes);
+                        batchCount = 0;
+                    }
+                } else if (kind == "end" && output != NULL) {
+                    writeRestoreBatch(batch, batchCount, parallel, output, fileHash, fileBytes);
+                    batchCount = 0;
+                    bool ok = syncFile(output);
+                    ok = (fclose(output) == 0) && ok;
+                    output = NULL;
+                    if (!ok) {
+                        throw FileException("Cannot write " + restored[restoredCount - 1] + ".restore");
+                    }
+                    if (fileBytes != stringToLongLong(first) || fileHash.finishHex() != second) {
+                        throw FileException("Restored " + restored[restoredCount - 1] + " does not match the snapshot");
+                    }
+                } else if (kind != "snapshot") {
+                    throw FileException("Damaged snapshot manifest: " + manifestPath);
+                }
+            }
+        } catch (...) {
+            delete[] batch;
+            throw;
         }
-        
-        // saveStaffToFile(*staffMembers[i], staffFile);
-        // Use the global friend function instead
-        for (int i = 0; i < staffCount; i++) {
-            ::saveStaffToFile(*staffMembers[i], staffFile);
+        delete[] batch;
+        if (output != NULL) {
+            throw FileException("Snapshot manifest is incomplete: " + manifestPath);
         }
-        staffFile.close();
-        
-        // Backup applications
-        string appBackup = backupDir + "_applications.txt";
-        applications->saveToFile(appBackup);
-        
-        cout << "System backup completed successfully!\n";
-        logEvent("SYSTEM", "Backup created: " + backupDir);
-        
-    } catch (const FileException& e) {
-        cout << "Backup Error: " << e.what() << endl;
-        logEvent("ERROR", "Backup failed: " + string(e.what()));
-    }
-}
 
-void InternshipSystem::restoreSystemData(string backupTimestamp) 
-{
-    try {
-        cout << "Restoring system data from backup: " << backupTimestamp << endl;
-        
-        // Restore students
-        string studentRestore = "backup_" + backupTimestamp + "_students.txt";
-        ifstream studentFile(studentRestore.c_str());
-        if (!studentFile.is_open()) {
-            throw FileException("Cannot open student backup file");
-        }
-        
-        // Clear current data
-        for (int i = 0; i < studentCount; i++) {
-            delete students[i];
+        // applications.txt already holds every decision in the snapshot, so
+        // the decision log is emptied in the same group
+        saver.begin();
+        for (int i = 0; i < restoredCount; i++) {
+            saver.adopt(restored[i] + ".restore", restored[i]);
         }
-        studentCount = 0;
-        
-        string line;
-        while (getline(studentFile, line) && studentCount < MAX_STUDENTS) {
-            if (line.empty()) continue;
-            
-            stringstream ss(line);
-            string id, name, email, cgpaStr, diploma, skills;
-            getline(ss, id, '|');
-            getline(ss, name, '|');
-            getline(ss, email, '|');
-            getline(ss, cgpaStr, '|');
-            getline(ss, diploma, '|');
-            getline(ss, skills, '|');
-            
-            float cgpa = stringToFloat(cgpaStr);
-            students[studentCount++] = new Student(id, name, email, cgpa, diploma, skills);
+        restoredCount = 0;
+        saver.save(DECISION_LOG_FILE, "");
+        if (!saver.commit()) {
+            throw FileException("Cannot replace the data files");
         }
-        studentFile.close();
-        
-        cout << "System restore completed successfully!\n";
-        logEvent("SYSTEM", "System restored from: " + backupTimestamp);
-        
+        decisionLogRows = 0;
+        decisionLogTorn = false;
+
+        // Replaces every store and rebuilds the hash tables, deadline index,
+        // review queues and counters; the cube and rankings rebuild on demand
+        loadSystemData();
+
+        stringstream summary;
+        summary << "Restored snapshot " << snapshotID << " in " << fixed << setprecision(1)
+                << (getWallClockSeconds() - startTime) * 1000 << " ms";
+        cout << summary.str() << endl;
+        logEvent("SYSTEM", summary.str());
+        return true;
+
     } catch (const FileException& e) {
+        if (output != NULL) fclose(output);
+        for (int i = 0; i < restoredCount; i++) {
+            remove((restored[i] + ".restore").c_str());
+        }
         cout << "Restore Error: " << e.what() << endl;
         logEvent("ERROR", "Restore failed: " + string(e.what()));
+        return false;
+    }
+}
+
+
+const ReportColumn BACKUP_COLUMNS[] = {
+    { "snapshot", "Snapshot", COLUMN_TEXT, 20 },
+    { "created", "Created", COLUMN_TEXT, 26 },
+    { "bytes", "Data Bytes", COLUMN_INTEGER, 14 },
+    { "new_bytes", "New Bytes", COLUMN_INTEGER, 12 },
+    { "chunks", "Chunks", COLUMN_INTEGER, 8 },
+    { "new_chunks", "New Chunks", COLUMN_INTEGER, 11 },
+    { "stored_bytes", "Stored Bytes", COLUMN_INTEGER, 12 }
+};
+const ReportTable BACKUP_TABLE = { "backups", "BACKUP SNAPSHOTS", BACKUP_COLUMNS, 7, TABLE_ROWS };
+
+
+void InternshipSystem::listBackups()
+{
+    ifstream index((BACKUP_DIRECTORY + "/snapshots.txt").c_str());
+    if (!index.is_open()) {
+        cout << "No backups yet.\n";
+        return;
     }
+    TextReportWriter screen(cout);
+    screen.beginTable(BACKUP_TABLE);
+    string line;
+    while (getline(index, line)) {
+        if (line.empty()) continue;
+        stringstream fields(line);
+        string values[7];
+        for (int i = 0; i < 7; i++) getline(fields, values[i], '|');
+        screen.text(values[0]);
+        screen.text(values[1]);
+        for (int i = 2; i < 7; i++) screen.integer((long)stringToLongLong(values[i]));
+        screen.endRow();
+    }
+    screen.endTable();
+    screen.finish();
+}
+
+
+void InternshipSystem::backupMenu()
+{
+    int choice;
+    do {
+        cout << "\n=== Backup and Restore ===\n";
+        cout << "1. Back Up Now\n";
+        cout << "2. List Backups\n";
+        cout << "3. Restore a Backup\n";
+        cout << "4. Back\n";
+        cout << "Enter choice: ";
+        cin >> choice;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        switch (choice) {
+            case 1:
+                backupSystemData();
+                break;
+            case 2:
+                listBackups();
+                break;
+            case 3:
+                {
+                    string snapshotID, confirm;
+                    listBackups();
+                    cout << "Snapshot to restore: ";
+                    getline(cin, snapshotID);
+                    cout << "Replace all current data with snapshot " << snapshotID << "? (y/n): ";
+                    getline(cin, confirm);
+                    if (confirm == "y" || confirm == "Y") restoreSystemData(trim(snapshotID));
+                }
+                break;
+            case 4:
+                return;
+            default:
+                cout << "Invalid choice. Please try again.\n";
+        }
+    } while (true);
 }
 
 string InternshipSystem::getCurrentTimestamp() 
@@ -3232,143 +8924,354 @@ string InternshipSystem::getCurrentTimestamp()
     return timestamp;
 }
 
-// System analytics and reporting functions
-void InternshipSystem::generateDetailedReport() 
+
+// Base name for a report file: prefix + timestamp. The timestamp only has
+// whole seconds, so a second report in the same second, or one whose file
+// is already there, gets _2, _3, ... instead of overwriting the first.
+string InternshipSystem::reportFileBase(const string& prefix)
+{
+    string stamp = getCurrentTimestamp();
+    ScopedLock guard(reportNameMutex);
+    if (stamp != reportNameStamp) {
+        reportNameStamp = stamp;
+        reportNameUses = 0;
+    }
+    while (true) {
+        stringstream base;
+        base << prefix << stamp;
+        if (++reportNameUses > 1) base << "_" << reportNameUses;
+        if (!fileExists(base.str() + ".txt") && !fileExists(base.str() + ".jsonl") &&
+            !fileExists(base.str() + ".igc")) {
+            return base.str();
+        }
+    }
+}
+
+// Tables of the admin reports and exports
+const ReportColumn STUDENT_STATISTICS_COLUMNS[] = {
+    { "total_students", "Total Students", COLUMN_INTEGER, 0 },
+    { "average_cgpa", "Average CGPA", COLUMN_DECIMAL, 0 },
+    { "highest_cgpa", "Highest CGPA", COLUMN_DECIMAL, 0 },
+    { "lowest_cgpa", "Lowest CGPA", COLUMN_DECIMAL, 0 }
+};
+const ReportTable STUDENT_STATISTICS_TABLE = { "student_statistics", "STUDENT STATISTICS",
+                                               STUDENT_STATISTICS_COLUMNS, 4, TABLE_RECORD };
+
+const ReportColumn DIPLOMA_COLUMNS[] = {
+    { "diploma", "Diploma", COLUMN_TEXT, 14 },
+    { "students", "Students", COLUMN_INTEGER, 10 },
+    { "percent", "Percent", COLUMN_DECIMAL, 0 }
+};
+const ReportTable DIPLOMA_TABLE = { "diploma_distribution", "DIPLOMA DISTRIBUTION", DIPLOMA_COLUMNS, 3, TABLE_ROWS };
+
+const ReportColumn JOB_STATISTICS_COLUMNS[] = {
+    { "total_jobs", "Total Jobs Available", COLUMN_INTEGER, 0 },
+    { "total_applications", "Total Applications", COLUMN_INTEGER, 0 }
+};
+const ReportTable JOB_STATISTICS_TABLE = { "job_statistics", "JOB STATISTICS", JOB_STATISTICS_COLUMNS, 2, TABLE_RECORD };
+
+const ReportColumn TOP_STUDENT_COLUMNS[] = {
+    { "rank", "Rank", COLUMN_INTEGER, 6 },
+    { "student_id", "Student ID", COLUMN_TEXT, 13 },
+    { "name", "Name", COLUMN_TEXT, 25 },
+    { "cgpa", "CGPA", COLUMN_DECIMAL, 6 },
+    { "diploma", "Diploma", COLUMN_TEXT, 0 }
+};
+const ReportTable TOP_STUDENT_TABLE = { "top_students", "TOP STUDENTS BY CGPA", TOP_STUDENT_COLUMNS, 5, TABLE_ROWS };
+
+const ReportColumn GRADE_COLUMNS[] = {
+    { "grade", "Grade", COLUMN_TEXT, 7 },
+    { "cgpa_range", "CGPA Range", COLUMN_TEXT, 13 },
+    { "students", "Students", COLUMN_INTEGER, 10 },
+    { "percent", "Percent", COLUMN_DECIMAL, 0 }
+};
+const ReportTable GRADE_TABLE = { "grade_distribution", "CGPA GRADE DISTRIBUTION", GRADE_COLUMNS, 4, TABLE_ROWS };
+
+const ReportColumn STUDENT_EXPORT_COLUMNS[] = {
+    { "student_id", "Student ID", COLUMN_TEXT, 13 },
+    { "name", "Name", COLUMN_TEXT, 25 },
+    { "email", "Email", COLUMN_TEXT, 30 },
+    { "cgpa", "CGPA", COLUMN_DECIMAL, 6 },
+    { "diploma", "Diploma", COLUMN_TEXT, 12 },
+    { "skills", "Skills", COLUMN_TEXT, 0 }
+};
+const ReportTable STUDENT_EXPORT_TABLE = { "students", "STUDENTS", STUDENT_EXPORT_COLUMNS, 6, TABLE_ROWS };
+
+const ReportColumn APPLICATION_EXPORT_COLUMNS[] = {
+    { "student_id", "Student ID", COLUMN_TEXT, 13 },
+    { "job_id", "Job ID", COLUMN_TEXT, 9 },
+    { "job_title", "Job Title", COLUMN_TEXT, 28 },
+    { "company", "Company", COLUMN_TEXT, 28 },
+    { "status", "Status", COLUMN_TEXT, 10 },
+    { "sequence", "Sequence", COLUMN_INTEGER, 0 }
+};
+const ReportTable APPLICATION_EXPORT_TABLE = { "applications", "APPLICATIONS", APPLICATION_EXPORT_COLUMNS, 6, TABLE_ROWS };
+
+
+// System analytics and reporting functions. Both reports take their figures
+// from one pass over the students and stream their tables through a
+// ReportWriter, so the student array is left in its current order.
+bool InternshipSystem::generateDetailedReport(ReportFormat format) 
 {
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "InternshipSystem::generateDetailedReport");
     try {
-        string reportFile = "detailed_report_" + getCurrentTimestamp() + ".txt";
-        ofstream report(reportFile.c_str());
-        if (!report.is_open()) {
+        ReportOutput report(format, reportFileBase("detailed_report_"));
+        if (!report->good()) {
             throw FileException("Cannot create report file");
         }
         
-        report << "=== INTERNSHIP SYSTEM DETAILED REPORT ===" << endl;
-        report << "Generated on: " << getCurrentTimestamp() << endl;
-        report << string(50, '=') << endl;
-        
-        // Student statistics
-        report << "\n--- STUDENT STATISTICS ---" << endl;
-        report << "Total Students: " << studentCount << endl;
-        
-        float totalCGPA = 0.0;
-        float highestCGPA = 0.0;
-        float lowestCGPA = 4.0;
+        StudentStatistics stats = computeStudentStatistics(*scheduler, students, studentCount);
+        double average = studentCount > 0 ? stats.totalCGPA / studentCount : 0.0;
+        double percentBase = studentCount > 0 ? 100.0 / studentCount : 0.0;
         
-        for (int i = 0; i < studentCount; i++) {
-            float cgpa = students[i]->getCGPA();
-            totalCGPA += cgpa;
-            if (cgpa > highestCGPA) highestCGPA = cgpa;
-            if (cgpa < lowestCGPA) lowestCGPA = cgpa;
-        }
+        report->heading("=== INTERNSHIP SYSTEM DETAILED REPORT ===");
+        report->heading("Generated on: " + getCurrentTimestamp());
+        report->heading(string(50, '='));
         
-        if (studentCount > 0) {
-            report << "Average CGPA: " << fixed << setprecision(2) << (totalCGPA / studentCount) << endl;
-            report << "Highest CGPA: " << highestCGPA << endl;
-            report << "Lowest CGPA: " << lowestCGPA << endl;
-        }
+        // Student statistics
+        report->beginTable(STUDENT_STATISTICS_TABLE);
+        report->integer(studentCount);
+        report->decimal(average);
+        report->decimal(studentCount > 0 ? stats.highestCGPA : 0.0);
+        report->decimal(studentCount > 0 ? stats.lowestCGPA : 0.0);
+        report->endRow();
+        report->endTable();
         
         // Diploma distribution
-        int itCount = 0, businessCount = 0, accountingCount = 0;
-        for (int i = 0; i < studentCount; i++) {
-            string diploma = students[i]->getDiploma(); // ? Fix: Use students[i]->getDiploma()
-            if (diploma == "IT") itCount++;
-            else if (diploma == "Business") businessCount++;
-            else if (diploma == "Accounting") accountingCount++;
-        }
-        
-        report << "\n--- DIPLOMA DISTRIBUTION ---" << endl;
-        if (studentCount > 0) {
-            report << "IT Students: " << itCount << " (" << (itCount * 100.0 / studentCount) << "%)" << endl;
-            report << "Business Students: " << businessCount << " (" << (businessCount * 100.0 / studentCount) << "%)" << endl;
-            report << "Accounting Students: " << accountingCount << " (" << (accountingCount * 100.0 / studentCount) << "%)" << endl;
+        const char* diplomas[3] = { "IT", "Business", "Accounting" };
+        int diplomaCounts[3] = { stats.itCount, stats.businessCount, stats.accountingCount };
+        report->beginTable(DIPLOMA_TABLE);
+        for (int i = 0; i < 3; i++) {
+            report->text(diplomas[i]);
+            report->integer(diplomaCounts[i]);
+            report->decimal(diplomaCounts[i] * percentBase);
+            report->endRow();
         }
+        report->endTable();
         
         // Job statistics
-        report << "\n--- JOB STATISTICS ---" << endl;
-        report << "Total Jobs Available: " << jobCount << endl;
-        report << "Total Applications: " << applications->getCount() << endl;
-        
-        report.close();
-        cout << "Detailed report generated: " << reportFile << endl;
-        logEvent("SYSTEM", "Detailed report generated");
+        report->beginTable(JOB_STATISTICS_TABLE);
+        report->integer(jobCount);
+        report->integer(applications->getCount());
+        report->endRow();
+        report->endTable();
         
+        if (!report->finish()) {
+            throw FileException("Cannot write report file");
+        }
+        cout << "Detailed report generated: " << report->getFiles() << endl;
+        logEvent("SYSTEM", string("Detailed report generated (") + reportFormatName(format) + ")");
+        return true;
     } catch (const FileException& e) {
         cout << "Report Error: " << e.what() << endl;
         logEvent("ERROR", "Report generation failed");
+        return false;
     }
 }
 
-void InternshipSystem::generateStudentPerformanceReport() 
+bool InternshipSystem::generateStudentPerformanceReport(ReportFormat format) 
 {
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "InternshipSystem::generateStudentPerformanceReport");
     try {
-        string reportFile = "student_performance_" + getCurrentTimestamp() + ".txt";
-        ofstream report(reportFile.c_str());
-        if (!report.is_open()) {
+        ReportOutput report(format, reportFileBase("student_performance_"));
+        if (!report->good()) {
             throw FileException("Cannot create performance report file");
         }
         
-        report << "=== STUDENT PERFORMANCE ANALYSIS ===" << endl;
-        report << "Generated on: " << getCurrentTimestamp() << endl;
-        report << string(50, '=') << endl;
+        // Ranking and grade bands come from the same pass; only the
+        // top students are kept, never a sorted copy of the array
+        StudentStatistics stats = computeStudentStatistics(*scheduler, students, studentCount);
+        RankedStudent top[REPORT_TOP_STUDENTS];
+        int topCount = stats.topStudents.getRanked(top);
+        double percentBase = studentCount > 0 ? 100.0 / studentCount : 0.0;
         
-        // Sort students by CGPA for analysis
-        selectionSortStudentsByCGPA();
+        report->heading("=== STUDENT PERFORMANCE ANALYSIS ===");
+        report->heading("Generated on: " + getCurrentTimestamp());
+        report->heading(string(50, '='));
         
-        report << "\n--- TOP 10 STUDENTS BY CGPA ---" << endl;
-        int topCount = min(10, studentCount);
+        report->beginTable(TOP_STUDENT_TABLE);
         for (int i = 0; i < topCount; i++) {
-            report << (i + 1) << ". " << students[i]->getName() 
-                   << " (ID: " << students[i]->getID() 
-                   << ") - CGPA: " << fixed << setprecision(2) << students[i]->getCGPA() 
-                   << " - " << students[i]->getDiploma() << endl;
+            Student* student = top[i].student;
+            report->integer(i + 1);
+            report->text(student->getID());
+            report->text(student->getName());
+            report->decimal(student->getCGPA());
+            report->text(student->getDiploma());
+            report->endRow();
+        }
+        report->endTable();
+        
+        const char* grades[4] = { "A", "B", "C", "D" };
+        const char* ranges[4] = { "3.5-4.0", "3.0-3.49", "2.5-2.99", "Below 2.5" };
+        int counts[4] = { stats.gradeA, stats.gradeB, stats.gradeC, stats.gradeD };
+        report->beginTable(GRADE_TABLE);
+        for (int i = 0; i < 4; i++) {
+            report->text(grades[i]);
+            report->text(ranges[i]);
+            report->integer(counts[i]);
+            report->decimal(counts[i] * percentBase);
+            report->endRow();
         }
+        report->endTable();
         
-        report << "\n--- CGPA GRADE DISTRIBUTION ---" << endl;
-        int gradeA = 0, gradeB = 0, gradeC = 0, gradeD = 0;
+        if (!report->finish()) {
+            throw FileException("Cannot write performance report file");
+        }
+        cout << "Student performance report generated: " << report->getFiles() << endl;
+        logEvent("SYSTEM", string("Performance report generated (") + reportFormatName(format) + ")");
+        return true;
+    } catch (const FileException& e) {
+        cout << "Performance Report Error: " << e.what() << endl;
+        logEvent("ERROR", "Performance report generation failed");
+        return false;
+    }
+}
+
+// Exports stream one row per record straight into the writer, so their
+// memory use does not depend on how many records there are
+bool InternshipSystem::exportStudents(ReportFormat format)
+{
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "InternshipSystem::exportStudents");
+    try {
+        ReportOutput report(format, reportFileBase("students_export_"));
+        if (!report->good()) {
+            throw FileException("Cannot create export file");
+        }
         
+        report->beginTable(STUDENT_EXPORT_TABLE);
         for (int i = 0; i < studentCount; i++) {
-            float cgpa = students[i]->getCGPA();
-            if (cgpa >= 3.5) gradeA++;
-            else if (cgpa >= 3.0) gradeB++;
-            else if (cgpa >= 2.5) gradeC++;
-            else gradeD++;
+            Student* student = students[i];
+            report->text(student->getID());
+            report->text(student->getName());
+            report->text(student->getEmail());
+            report->decimal(student->getCGPA());
+            report->text(student->getDiploma());
+            report->text(student->getSkills());
+            report->endRow();
         }
+        report->endTable();
         
-        report << "Grade A (3.5-4.0): " << gradeA << " students (" << (gradeA * 100.0 / studentCount) << "%)" << endl;
-        report << "Grade B (3.0-3.49): " << gradeB << " students (" << (gradeB * 100.0 / studentCount) << "%)" << endl;
-        report << "Grade C (2.5-2.99): " << gradeC << " students (" << (gradeC * 100.0 / studentCount) << "%)" << endl;
-        report << "Grade D (Below 2.5): " << gradeD << " students (" << (gradeD * 100.0 / studentCount) << "%)" << endl;
+        if (!report->finish()) {
+            throw FileException("Cannot write export file");
+        }
+        cout << "Exported " << studentCount << " students to " << report->getFiles() << endl;
+        logEvent("SYSTEM", string("Students exported (") + reportFormatName(format) + ")");
+        return true;
+    } catch (const FileException& e) {
+        cout << "Export Error: " << e.what() << endl;
+        logEvent("ERROR", "Student export failed");
+        return false;
+    }
+}
+
+bool InternshipSystem::exportApplications(ReportFormat format)
+{
+    MetricTimer timer(metrics, METRIC_REPORT);
+    TRACE_SCOPE("report", "InternshipSystem::exportApplications");
+    try {
+        ensureApplicationsLoaded();
+        ReportOutput report(format, reportFileBase("applications_export_"));
+        if (!report->good()) {
+            throw FileException("Cannot create export file");
+        }
         
-        report.close();
-        cout << "Student performance report generated: " << reportFile << endl;
-        logEvent("SYSTEM", "Performance report generated");
+        report->beginTable(APPLICATION_EXPORT_TABLE);
+        for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+            report->text(node->studentID);
+            report->text(node->jobID);
+            report->text(node->jobTitle);
+            report->text(node->company);
+            report->text(node->status);
+            report->integer(node->sequence);
+            report->endRow();
+        }
+        report->endTable();
         
+        if (!report->finish()) {
+            throw FileException("Cannot write export file");
+        }
+        cout << "Exported " << applications->getCount() << " applications to " << report->getFiles() << endl;
+        logEvent("SYSTEM", string("Applications exported (") + reportFormatName(format) + ")");
+        return true;
     } catch (const FileException& e) {
-        cout << "Performance Report Error: " << e.what() << endl;
-        logEvent("ERROR", "Performance report generation failed");
+        cout << "Export Error: " << e.what() << endl;
+        logEvent("ERROR", "Application export failed");
+        return false;
     }
 }
 
+void InternshipSystem::reportsMenu(Admin* admin)
+{
+    admin->generateReports();
+    
+    int choice;
+    do {
+        cout << "\n=== Reports and Exports ===\n";
+        cout << "1. Detailed Report\n";
+        cout << "2. Student Performance Report\n";
+        cout << "3. Export Students\n";
+        cout << "4. Export Applications\n";
+        cout << "5. Application Cube (cross-tab)\n";
+        cout << "6. Applicant Query\n";
+        cout << "7. Back\n";
+        cout << "Enter choice: ";
+        cin >> choice;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        
+        switch (choice) {
+            case 1:
+                generateDetailedReport(promptReportFormat());
+                break;
+            case 2:
+                generateStudentPerformanceReport(promptReportFormat());
+                break;
+            case 3:
+                exportStudents(promptReportFormat());
+                break;
+            case 4:
+                exportApplications(promptReportFormat());
+                break;
+            case 5:
+                applicationCubeMenu();
+                break;
+            case 6:
+                applicantQueryMenu();
+                break;
+            case 7:
+                return;
+            default:
+                cout << "Invalid choice. Please try again.\n";
+        }
+    } while (true);
+}
+
 // Advanced search and filter functions
 void InternshipSystem::searchStudentsByDiploma(string diploma) 
 {
-    cout << "\n=== Students in " << diploma << " Program ===" << endl;
-    cout << left << setw(12) << "Student ID" 
-         << setw(25) << "Name" 
-         << setw(6) << "CGPA" 
-         << setw(30) << "Skills" << endl;
-    cout << string(73, '-') << endl;
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::searchStudentsByDiploma");
+    OutputBuffer out(cout);
+    out.put("\n=== Students in ").put(diploma).put(" Program ===\n");
+    out.padded("Student ID", 12)
+       .padded("Name", 25)
+       .padded("CGPA", 6)
+       .padded("Skills", 30).put('\n');
+    out.repeat('-', 73).put('\n');
     
     int count = 0;
     for (int i = 0; i < studentCount; i++) {
         if (students[i]->getDiploma() == diploma) {
-            cout << left << setw(12) << students[i]->getID()
-                 << setw(25) << students[i]->getName()
-                 << setw(6) << fixed << setprecision(2) << students[i]->getCGPA()
-                 << setw(30) << students[i]->getSkills() << endl;
+            out.padded(students[i]->getID(), 12)
+               .padded(students[i]->getName(), 25)
+               .paddedFixed(students[i]->getCGPA(), 2, 6)
+               .padded(students[i]->getSkills(), 30).put('\n');
             count++;
         }
     }
+    out.flush();
     
     if (count == 0) {
         cout << "No students found in " << diploma << " program." << endl;
@@ -3381,24 +9284,28 @@ void InternshipSystem::searchStudentsByDiploma(string diploma)
 
 void InternshipSystem::searchStudentsByCGPARange(float minCGPA, float maxCGPA) 
 {
-    cout << "\n=== Students with CGPA between " << minCGPA << " and " << maxCGPA << " ===" << endl;
-    cout << left << setw(12) << "Student ID" 
-         << setw(25) << "Name" 
-         << setw(6) << "CGPA" 
-         << setw(15) << "Diploma" << endl;
-    cout << string(58, '-') << endl;
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::searchStudentsByCGPARange");
+    OutputBuffer out(cout);
+    out.put("\n=== Students with CGPA between ").putFixed(minCGPA, 2).put(" and ").putFixed(maxCGPA, 2).put(" ===\n");
+    out.padded("Student ID", 12)
+       .padded("Name", 25)
+       .padded("CGPA", 6)
+       .padded("Diploma", 15).put('\n');
+    out.repeat('-', 58).put('\n');
     
     int count = 0;
     for (int i = 0; i < studentCount; i++) {
         float cgpa = students[i]->getCGPA();
         if (cgpa >= minCGPA && cgpa <= maxCGPA) {
-            cout << left << setw(12) << students[i]->getID()
-                 << setw(25) << students[i]->getName()
-                 << setw(6) << fixed << setprecision(2) << cgpa
-                 << setw(15) << students[i]->getDiploma() << endl;
+            out.padded(students[i]->getID(), 12)
+               .padded(students[i]->getName(), 25)
+               .paddedFixed(cgpa, 2, 6)
+               .padded(students[i]->getDiploma(), 15).put('\n');
             count++;
         }
     }
+    out.flush();
     
     if (count == 0) {
         cout << "No students found in the specified CGPA range." << endl;
@@ -3411,23 +9318,29 @@ void InternshipSystem::searchStudentsByCGPARange(float minCGPA, float maxCGPA)
 
 void InternshipSystem::searchJobsByCompany(string company) 
 {
-    cout << "\n=== Jobs from " << company << " ===" << endl;
-    cout << left << setw(8) << "Job ID" 
-         << setw(30) << "Title" 
-         << setw(12) << "Deadline" 
-         << setw(20) << "Requirements" << endl;
-    cout << string(70, '-') << endl;
+    MetricTimer timer(metrics, METRIC_SEARCH);
+    TRACE_SCOPE("search", "InternshipSystem::searchJobsByCompany");
+    OutputBuffer out(cout);
+    out.put("\n=== Jobs from ").put(company).put(" ===\n");
+    out.padded("Job ID", 8)
+       .padded("Title", 30)
+       .padded("Deadline", 12)
+       .padded("Requirements", 20).put('\n');
+    out.repeat('-', 70).put('\n');
     
+    JobCatalogReader catalog(*jobCatalog);
     int count = 0;
-    for (int i = 0; i < jobCount; i++) {
-        if (jobs[i]->getCompany().find(company) != string::npos) {
-            cout << left << setw(8) << jobs[i]->getJobID()
-                 << setw(30) << jobs[i]->getTitle()
-                 << setw(12) << jobs[i]->getDeadline()
-                 << setw(20) << jobs[i]->getRequirements() << endl;
+    for (int i = 0; i < catalog->count; i++) {
+        const JobListing& job = catalog->listings[i];
+        if (job.company.find(company) != string::npos) {
+            out.padded(job.jobID, 8)
+               .padded(job.title, 30)
+               .padded(job.deadline, 12)
+               .padded(job.requirements, 20).put('\n');
             count++;
         }
     }
+    out.flush();
     
     if (count == 0) {
         cout << "No jobs found from " << company << endl;
@@ -3443,24 +9356,16 @@ void InternshipSystem::optimizeHashTable()
 {
     cout << "Optimizing hash table..." << endl;
     
-    // Save current students
-    Student* tempStudents[MAX_STUDENTS];
-    int tempCount = 0;
-    
-    for (int i = 0; i < studentCount; i++) {
-        tempStudents[tempCount++] = students[i];
-    }
-    
     // Create new optimized hash table
     delete studentHash;
-    int newSize = studentCount * 2; // Double the size for better distribution
+    int newSize = studentCount * 2 + 1; // Double the size for better distribution
     if (newSize < TABLE_SIZE) newSize = TABLE_SIZE;
     
     studentHash = new StudentHashTable(newSize);
     
     // Re-insert all students
-    for (int i = 0; i < tempCount; i++) {
-        studentHash->insert(tempStudents[i]);
+    for (int i = 0; i < studentCount; i++) {
+        studentHash->insert(students[i]);
     }
     
     cout << "Hash table optimized. New size: " << newSize << endl;
@@ -3471,6 +9376,9 @@ void InternshipSystem::optimizeHashTable()
 void InternshipSystem::defragmentData() 
 {
     cout << "Defragmenting data structures..." << endl;
+    beforeStoreChange(STUDENTS_FILE);
+    beforeStoreChange(JOBS_FILE);
+    beforeStoreChange(STAFF_FILE);
     
     // Remove NULL pointers and compact arrays
     int newStudentCount = 0;
@@ -3516,109 +9424,374 @@ void InternshipSystem::defragmentData()
     logEvent("SYSTEM", "Data defragmentation completed");
 }
 
-int InternshipSystem::calculateSystemHealth() 
+// Walks every record and index and adds up the heap each one holds, the
+// way the allocator hands it out (block headers and rounding included).
+// Applications are only counted once they are loaded.
+void InternshipSystem::measureMemory(MemoryReport& report)
 {
-    int healthScore = 100;
-    
-    // Check load factors
-    double hashLoadFactor = studentHash->getLoadFactor();
-    if (hashLoadFactor > 0.8) healthScore -= 10;
-    if (hashLoadFactor > 0.9) healthScore -= 20;
-    
-    // Check data integrity
-    int nullStudents = 0, nullJobs = 0, nullStaff = 0;
-    
+    MemoryUsage& studentRow = report.add("record", "Students", studentCount);
+    studentRow.objectBytes = heapBlockBytes(studentCapacity * sizeof(Student*));
     for (int i = 0; i < studentCount; i++) {
-        if (students[i] == NULL) nullStudents++;
+        if (students[i] == NULL) continue;
+        studentRow.objectBytes += heapBlockBytes(sizeof(Student));
+        studentRow.stringBytes += students[i]->stringBytes();
+    }
+
+    MemoryUsage& adminRow = report.add("record", "Admins", adminCount);
+    for (int i = 0; i < adminCount; i++) {
+        if (admins[i] == NULL) continue;
+        adminRow.objectBytes += heapBlockBytes(sizeof(Admin));
+        adminRow.stringBytes += admins[i]->stringBytes();
+    }
+
+    MemoryUsage& staffRow = report.add("record", "Staff", staffCount);
+    for (int i = 0; i < staffCount; i++) {
+        if (staffMembers[i] == NULL) continue;
+        staffRow.objectBytes += heapBlockBytes(sizeof(Staff));
+        staffRow.stringBytes += staffMembers[i]->stringBytes();
+    }
+
+    MemoryUsage& jobRow = report.add("record", "Jobs", jobCount);
+    for (int i = 0; i < jobCount; i++) {
+        if (jobs[i] == NULL) continue;
+        jobRow.objectBytes += heapBlockBytes(sizeof(InternshipJob));
+        jobRow.stringBytes += jobs[i]->stringBytes();
+    }
+
+    MemoryUsage& applicationRow = report.add("record", "Applications", applications->getCount());
+    applicationRow.objectBytes = heapBlockBytes(sizeof(ApplicationList));
+    for (ApplicationNode* node = applications->getHead(); node != NULL; node = node->next) {
+        applicationRow.objectBytes += heapBlockBytes(sizeof(ApplicationNode));
+        applicationRow.stringBytes += stringHeapBytes(node->studentID) + stringHeapBytes(node->jobID) +
+                                      stringHeapBytes(node->status);
+    }
+
+    MemoryUsage& pooledRow = report.add("record", "Pooled strings", 0);
+    pooledRow.count = applicationStrings.measure(pooledRow.objectBytes, pooledRow.stringBytes);
+
+    report.add("index", "Student hash", studentCount).objectBytes = studentHash->memoryBytes();
+    report.add("index", "Job hash", jobCount).objectBytes = jobHash->memoryBytes();
+    report.add("index", "Deadline index", deadlineIndex->getSize()).objectBytes = deadlineIndex->memoryBytes();
+    report.add("index", "Application index", applications->getCount()).objectBytes = applications->indexBytes();
+
+    if (jobApplicants != NULL) {
+        report.add("index", "Applicant index", applications->getCount()).objectBytes = jobApplicants->memoryBytes();
+    }
+    if (applicationCube != NULL) {
+        long cells = 0;
+        for (int mask = 0; mask < CUBE_CUBOIDS; mask++) cells += applicationCube->getCellCount(mask);
+        report.add("index", "Application cube", cells).objectBytes = applicationCube->memoryBytes();
+    }
+
+    MemoryUsage& queueRow = report.add("index", "Review queues", 0);
+    for (int i = 0; i < reviewQueueCount; i++) {
+        queueRow.count += reviewQueues[i]->getSize();
+        queueRow.objectBytes += reviewQueues[i]->memoryBytes();
+    }
+
+    MemoryUsage& departmentRow = report.add("index", "Department stats", departmentStatsCount);
+    for (int i = 0; i < departmentStatsCount; i++) {
+        departmentRow.objectBytes += departmentStats[i]->memoryBytes();
+    }
+
+    JobCatalogReader catalog(*jobCatalog);
+    report.add("index", "Job catalog", catalog->count).objectBytes = catalog->memoryBytes();
+
+    report.allocator = readAllocatorStats();
+    report.process = readProcessMemory();
+}
+
+
+// Scores the system out of 100. Every deduction comes from a measured
+// figure and is kept with its reason so diagnostics can show why.
+void InternshipSystem::checkSystemHealth(const MemoryReport& report, HealthCheck& health)
+{
+    stringstream reason;
+
+    // Index load: the hash tables probe linearly, the application index chains
+    double studentLoad = studentHash->getLoadFactor();
+    double jobLoad = jobHash->getLoadFactor();
+    if (studentLoad > 0.8 || jobLoad > 0.8) {
+        reason.str("");
+        reason << fixed << setprecision(2) << "Hash table load factor " << (studentLoad > jobLoad ? studentLoad : jobLoad);
+        health.deduct(studentLoad > 0.9 || jobLoad > 0.9 ? 30 : 10, reason.str());
+    }
+    int chain = applications->longestChain();
+    if (chain > HEALTH_CHAIN_WARN) {
+        reason.str("");
+        reason << "Application index chain of " << chain << " entries";
+        health.deduct(10, reason.str());
+    }
+
+    // Heap held by the allocator but free. A small heap is mostly free
+    // space by proportion, so the share only counts once it is big too.
+    if (report.allocator.available && report.allocator.freeBytes >= HEALTH_FRAGMENTATION_MIN_BYTES) {
+        double fragmentation = report.allocator.fragmentation();
+        if (fragmentation > HEALTH_FRAGMENTATION_WARN) {
+            reason.str("");
+            reason << fixed << setprecision(1) << "Heap fragmentation " << fragmentation * 100 << "% ("
+                   << report.allocator.freeBytes / (1024 * 1024) << " MB free)";
+            health.deduct(fragmentation > HEALTH_FRAGMENTATION_BAD ? 20 : 10, reason.str());
+        }
+    }
+
+    // Resident memory against the machine's RAM
+    if (report.process.available && report.process.systemBytes > 0) {
+        double share = (double)report.process.residentBytes / report.process.systemBytes;
+        if (share > HEALTH_RSS_SHARE_WARN) {
+            reason.str("");
+            reason << fixed << setprecision(1) << "Resident memory is " << share * 100 << "% of system RAM";
+            health.deduct(share > HEALTH_RSS_SHARE_BAD ? 25 : 10, reason.str());
+        }
+    }
+
+    // Data integrity
+    int nullRecords = 0;
+    for (int i = 0; i < studentCount; i++) {
+        if (students[i] == NULL) nullRecords++;
     }
-    
     for (int i = 0; i < jobCount; i++) {
-        if (jobs[i] == NULL) nullJobs++;
+        if (jobs[i] == NULL) nullRecords++;
+    }
+    for (int i = 0; i < staffCount; i++) {
+        if (staffMembers[i] == NULL) nullRecords++;
+    }
+    if (nullRecords > 0) {
+        reason.str("");
+        reason << nullRecords << " empty record slots";
+        health.deduct(nullRecords * 2, reason.str());
+    }
+
+    if (health.score < 0) health.score = 0;
+}
+
+int InternshipSystem::calculateSystemHealth() 
+{
+    MemoryReport report;
+    measureMemory(report);
+    HealthCheck health;
+    checkSystemHealth(report, health);
+    return health.score;
+}
+
+
+const ReportColumn DIAGNOSTIC_HEALTH_COLUMNS[] = {
+    { "health_score", "System Health Score", COLUMN_INTEGER, 0 },
+    { "status", "Status", COLUMN_TEXT, 0 },
+    { "students", "Student Count", COLUMN_INTEGER, 0 },
+    { "student_capacity", "Student Capacity", COLUMN_INTEGER, 0 },
+    { "jobs", "Job Count", COLUMN_INTEGER, 0 },
+    { "staff", "Staff Count", COLUMN_INTEGER, 0 },
+    { "applications", "Application Count", COLUMN_INTEGER, 0 },
+    { "student_load_factor", "Student Hash Load Factor", COLUMN_DECIMAL, 0 },
+    { "job_load_factor", "Job Hash Load Factor", COLUMN_DECIMAL, 0 },
+    { "longest_chain", "Longest Application Chain", COLUMN_INTEGER, 0 }
+};
+const ReportTable DIAGNOSTIC_HEALTH_TABLE = { "health", "SYSTEM HEALTH", DIAGNOSTIC_HEALTH_COLUMNS, 10, TABLE_RECORD };
+
+const ReportColumn HEALTH_FINDING_COLUMNS[] = {
+    { "points", "Points", COLUMN_INTEGER, 8 },
+    { "finding", "Finding", COLUMN_TEXT, 50 }
+};
+const ReportTable HEALTH_FINDING_TABLE = { "health_findings", "HEALTH DEDUCTIONS", HEALTH_FINDING_COLUMNS, 2, TABLE_ROWS };
+
+const ReportColumn MEMORY_COLUMNS[] = {
+    { "category", "Kind", COLUMN_TEXT, 8 },
+    { "name", "Name", COLUMN_TEXT, 20 },
+    { "count", "Count", COLUMN_INTEGER, 10 },
+    { "object_bytes", "Object Bytes", COLUMN_INTEGER, 14 },
+    { "string_bytes", "String Bytes", COLUMN_INTEGER, 14 },
+    { "total_bytes", "Total Bytes", COLUMN_INTEGER, 14 },
+    { "bytes_per_item", "Per Item", COLUMN_DECIMAL, 10 }
+};
+const ReportTable MEMORY_TABLE = { "memory", "MEMORY BY RECORD AND INDEX", MEMORY_COLUMNS, 7, TABLE_ROWS };
+
+const ReportColumn PROCESS_MEMORY_COLUMNS[] = {
+    { "measured_bytes", "Measured Heap (bytes)", COLUMN_INTEGER, 0 },
+    { "allocator_in_use_bytes", "Allocator In Use (bytes)", COLUMN_INTEGER, 0 },
+    { "allocator_arena_bytes", "Allocator Arena (bytes)", COLUMN_INTEGER, 0 },
+    { "allocator_mapped_bytes", "Allocator Mapped (bytes)", COLUMN_INTEGER, 0 },
+    { "allocator_free_bytes", "Allocator Free (bytes)", COLUMN_INTEGER, 0 },
+    { "fragmentation_percent", "Heap Fragmentation (%)", COLUMN_DECIMAL, 0 },
+    { "resident_bytes", "Resident Memory (bytes)", COLUMN_INTEGER, 0 },
+    { "peak_resident_bytes", "Peak Resident Memory (bytes)", COLUMN_INTEGER, 0 },
+    { "anonymous_bytes", "Anonymous Resident (bytes)", COLUMN_INTEGER, 0 },
+    { "virtual_bytes", "Virtual Memory (bytes)", COLUMN_INTEGER, 0 },
+    { "system_bytes", "System RAM (bytes)", COLUMN_INTEGER, 0 },
+    { "resident_percent", "Resident Share of RAM (%)", COLUMN_DECIMAL, 0 }
+};
+const ReportColumn LATENCY_COLUMNS[] = {
+    { "operation", "Operation", COLUMN_TEXT, 12 },
+    { "count", "Count", COLUMN_INTEGER, 10 },
+    { "p50_us", "p50 (us)", COLUMN_DECIMAL, 12 },
+    { "p99_us", "p99 (us)", COLUMN_DECIMAL, 12 },
+    { "p999_us", "p99.9 (us)", COLUMN_DECIMAL, 12 },
+    { "max_us", "Max (us)", COLUMN_DECIMAL, 12 },
+    { "mean_us", "Mean (us)", COLUMN_DECIMAL, 12 }
+};
+const ReportTable LATENCY_TABLE = { "latency", "OPERATION LATENCY", LATENCY_COLUMNS, 7, TABLE_ROWS };
+
+const ReportColumn COUNTER_COLUMNS[] = {
+    { "counter", "Counter", COLUMN_TEXT, 16 },
+    { "value", "Value", COLUMN_INTEGER, 10 }
+};
+const ReportTable COUNTER_TABLE = { "counters", "COUNTERS", COUNTER_COLUMNS, 2, TABLE_ROWS };
+
+const ReportTable PROCESS_MEMORY_TABLE = { "process_memory", "PROCESS MEMORY", PROCESS_MEMORY_COLUMNS, 12, TABLE_RECORD };
+
+
+const char* healthStatus(int score)
+{
+    if (score >= 90) return "EXCELLENT - System running optimally";
+    if (score >= 75) return "GOOD - System running well";
+    if (score >= 60) return "FAIR - Consider optimization";
+    if (score >= 40) return "POOR - Optimization recommended";
+    return "CRITICAL - Immediate attention required";
+}
+
+
+// Writes the diagnostics tables; allocator and process figures the
+// platform does not provide are written as 0
+void InternshipSystem::writeDiagnostics(ReportWriter& writer, const MemoryReport& report, const HealthCheck& health)
+{
+    writer.beginTable(DIAGNOSTIC_HEALTH_TABLE);
+    writer.integer(health.score);
+    writer.text(healthStatus(health.score));
+    writer.integer(studentCount);
+    writer.integer(studentCapacity);
+    writer.integer(jobCount);
+    writer.integer(staffCount);
+    writer.integer(applications->getCount());
+    writer.decimal(studentHash->getLoadFactor());
+    writer.decimal(jobHash->getLoadFactor());
+    writer.integer(applications->longestChain());
+    writer.endRow();
+    writer.endTable();
+
+    if (health.findingCount > 0) {
+        writer.beginTable(HEALTH_FINDING_TABLE);
+        for (int i = 0; i < health.findingCount; i++) {
+            writer.integer(-health.points[i]);
+            writer.text(health.findings[i]);
+            writer.endRow();
+        }
+        writer.endTable();
+    }
+
+    writer.beginTable(MEMORY_TABLE);
+    for (int i = 0; i < report.rowCount; i++) {
+        const MemoryUsage& row = report.rows[i];
+        long total = row.objectBytes + row.stringBytes;
+        writer.text(row.category);
+        writer.text(row.name);
+        writer.integer(row.count);
+        writer.integer(row.objectBytes);
+        writer.integer(row.stringBytes);
+        writer.integer(total);
+        writer.decimal(row.count > 0 ? (double)total / row.count : 0.0);
+        writer.endRow();
     }
-    
-    for (int i = 0; i < staffCount; i++) {
-        if (staffMembers[i] == NULL) nullStaff++;
+    writer.endTable();
+
+    const AllocatorStats& allocator = report.allocator;
+    const ProcessMemory& process = report.process;
+    writer.beginTable(PROCESS_MEMORY_TABLE);
+    writer.integer(report.totalBytes());
+    writer.integer(allocator.inUseBytes);
+    writer.integer(allocator.arenaBytes);
+    writer.integer(allocator.mappedBytes);
+    writer.integer(allocator.freeBytes);
+    writer.decimal(allocator.fragmentation() * 100);
+    writer.integer(process.residentBytes);
+    writer.integer(process.peakResidentBytes);
+    writer.integer(process.anonymousBytes);
+    writer.integer(process.virtualBytes);
+    writer.integer(process.systemBytes);
+    writer.decimal(process.systemBytes > 0 ? 100.0 * process.residentBytes / process.systemBytes : 0.0);
+    writer.endRow();
+    writer.endTable();
+
+    // Operations timed since the program started, see metrics.hpp
+    writer.beginTable(LATENCY_TABLE);
+    for (int m = 0; m < metrics.getMetricCount(); m++) {
+        if (metrics.getDefinition(m).kind != METRIC_TIMER) continue;
+        MetricSummary summary;
+        metrics.summarize(m, summary);
+        if (summary.count == 0) continue;
+        writer.text(metrics.getDefinition(m).name);
+        writer.integer(summary.count);
+        writer.decimal(summary.quantile(0.5) / 1000.0);
+        writer.decimal(summary.quantile(0.99) / 1000.0);
+        writer.decimal(summary.quantile(0.999) / 1000.0);
+        writer.decimal(summary.maxNanoseconds / 1000.0);
+        writer.decimal(summary.meanNanoseconds() / 1000.0);
+        writer.endRow();
     }
-    
-    int totalNulls = nullStudents + nullJobs + nullStaff;
-    healthScore -= (totalNulls * 2);
-    
-    // Check file consistency
-    // This would involve checking if files exist and are readable
-    
-    if (healthScore < 0) healthScore = 0;
-    if (healthScore > 100) healthScore = 100;
-    
-    return healthScore;
+    writer.endTable();
+
+    writer.beginTable(COUNTER_TABLE);
+    for (int m = 0; m < metrics.getMetricCount(); m++) {
+        if (metrics.getDefinition(m).kind != METRIC_COUNTER) continue;
+        MetricSummary summary;
+        metrics.summarize(m, summary);
+        writer.text(metrics.getDefinition(m).name);
+        writer.integer(summary.count);
+        writer.endRow();
+    }
+    writer.endTable();
 }
 
-void InternshipSystem::runSystemDiagnostics() 
+
+// Shows health and memory on screen and, given dumpBase, also writes the
+// same tables in the chosen format for monitoring scripts. Returns false
+// if the dump could not be written.
+bool InternshipSystem::runSystemDiagnostics(ReportFormat format, const string& dumpBase) 
 {
     cout << "\n=== SYSTEM DIAGNOSTICS ===" << endl;
     cout << "Running comprehensive system check..." << endl;
     
-    int healthScore = calculateSystemHealth();
-    
-    cout << "\nSystem Health Score: " << healthScore << "/100" << endl;
-    
-    if (healthScore >= 90) {
-        cout << "Status: EXCELLENT - System running optimally" << endl;
-    } else if (healthScore >= 75) {
-        cout << "Status: GOOD - System running well" << endl;
-    } else if (healthScore >= 60) {
-        cout << "Status: FAIR - Consider optimization" << endl;
-    } else if (healthScore >= 40) {
-        cout << "Status: POOR - Optimization recommended" << endl;
-    } else {
-        cout << "Status: CRITICAL - Immediate attention required" << endl;
+    MemoryReport report;
+    measureMemory(report);
+    HealthCheck health;
+    checkSystemHealth(report, health);
+
+    TextReportWriter screen(cout);
+    writeDiagnostics(screen, report, health);
+    screen.finish();
+
+    bool written = true;
+    if (!dumpBase.empty()) {
+        ReportOutput dump(format, dumpBase);
+        if (dump->good()) {
+            writeDiagnostics(*dump, report, health);
+        }
+        written = dump->finish();
+        if (written) {
+            cout << "Diagnostics written: " << dump->getFiles() << endl;
+        } else {
+            cout << "Error: Cannot write diagnostics file" << endl;
+            logEvent("ERROR", "Cannot write diagnostics to " + dumpBase);
+        }
     }
     
-    cout << "\nDetailed Diagnostics:" << endl;
-    cout << "- Student Count: " << studentCount << "/" << MAX_STUDENTS << endl;
-    cout << "- Job Count: " << jobCount << "/" << MAX_JOBS << endl;
-    cout << "- Staff Count: " << staffCount << "/" << MAX_STAFF << endl;
-    cout << "- Application Count: " << applications->getCount() << endl;
-    cout << "- Hash Table Load Factor: " << fixed << setprecision(2) << studentHash->getLoadFactor() << endl;
-    
-    // Memory usage estimation
-    int memoryUsage = (studentCount * sizeof(Student*)) + 
-                     (jobCount * sizeof(InternshipJob*)) + 
-                     (staffCount * sizeof(Staff*));
-    cout << "- Estimated Memory Usage: " << memoryUsage << " bytes" << endl;
-    
     stringstream healthStr;
-    healthStr << healthScore;
+    healthStr << health.score;
     logEvent("SYSTEM", "System diagnostics completed - Health: " + healthStr.str());
+    return written;
 }
 
 void InternshipSystem::insertionSortStudentsByName() 
 {
-    for (int i = 1; i < studentCount; i++) {
-        Student* key = students[i];
-        int j = i - 1;
-        
-        while (j >= 0 && students[j]->getName() > key->getName()) {
-            students[j + 1] = students[j];
-            j--;
-        }
-        students[j + 1] = key;
-    }
-    cout << "Students sorted by name using Insertion Sort.\n";
+    sortStudents(studentNameBefore);
+    cout << "Students sorted by name.\n";
     logEvent("SYSTEM", "Students sorted by name");
 }
 
 void InternshipSystem::bubbleSortJobsByTitle() 
 {
-    for (int i = 0; i < jobCount - 1; i++) {
-        for (int j = 0; j < jobCount - i - 1; j++) {
-            if (jobs[j]->getTitle() > jobs[j + 1]->getTitle()) {
-                InternshipJob* temp = jobs[j];
-                jobs[j] = jobs[j + 1];
-                jobs[j + 1] = temp;
-            }
-        }
-    }
-    cout << "Jobs sorted by title using Bubble Sort.\n";
+    sortJobs(jobTitleBefore);
+    publishJobCatalog();
+    cout << "Jobs sorted by title.\n";
     logEvent("SYSTEM", "Jobs sorted by title");
 }
 
@@ -3626,16 +9799,112 @@ void InternshipSystem::bubbleSortJobsByTitle()
 
 Student* InternshipSystem::hashSearchStudent(string studentID) 
 {
+    MetricTimer timer(metrics, METRIC_LOOKUP);
+    TRACE_SCOPE("lookup", "InternshipSystem::hashSearchStudent");
     return studentHash->search(studentID);
 }
 
-void InternshipSystem::registerStudent() 
+InternshipJob* InternshipSystem::hashSearchJob(const string& jobID) 
 {
-    if (studentCount >= MAX_STUDENTS) {
-        cout << "Maximum student capacity reached!" << endl;
-        return;
+    MetricTimer timer(metrics, METRIC_LOOKUP);
+    TRACE_SCOPE("lookup", "InternshipSystem::hashSearchJob");
+    return jobHash->search(jobID);
+}
+
+// Puts every job with a future deadline in the index and closes the rest
+void InternshipSystem::rebuildDeadlineIndex()
+{
+    deadlineIndex->clear();
+    long today = currentDayNumber();
+    for (int i = 0; i < jobCount; i++) {
+        jobs[i]->setIsActive(jobs[i]->getDeadlineDay() >= today);
+        if (jobs[i]->getIsActive()) deadlineIndex->insert(jobs[i]);
     }
-    
+    publishJobCatalog();
+}
+
+// Call after a job is added or its deadline edited
+void InternshipSystem::refreshJobDeadline(InternshipJob* job)
+{
+    deadlineIndex->remove(job);
+    job->setIsActive(job->getDeadlineDay() >= currentDayNumber());
+    if (job->getIsActive()) deadlineIndex->insert(job);
+    publishJobCatalog();
+    invalidateApplicationCube();   // The job's deadline month may have moved
+}
+
+// Closes jobs whose deadline has passed. Cost is O(log n) per closed job.
+int InternshipSystem::sweepExpiredJobs()
+{
+    int closed = deadlineIndex->sweep(currentDayNumber());
+    if (closed > 0) {
+        stringstream details;
+        details << closed << " job(s) closed after their deadline";
+        logEvent("SYSTEM", details.str());
+        publishJobCatalog();
+    }
+    return closed;
+}
+
+// Copies the jobs into a new catalog snapshot and publishes it to readers.
+// Call after any change to a job or to the job list.
+void InternshipSystem::publishJobCatalog()
+{
+    JobCatalogSnapshot* snapshot = new JobCatalogSnapshot(jobCount);
+    for (int i = 0; i < jobCount; i++) {
+        JobListing& listing = snapshot->listings[i];
+        listing.jobID = jobs[i]->getJobID();
+        listing.title = jobs[i]->getTitle();
+        listing.company = jobs[i]->getCompany();
+        listing.deadline = jobs[i]->getDeadline();
+        listing.requirements = jobs[i]->getRequirements();
+        listing.deadlineDay = jobs[i]->getDeadlineDay();
+        listing.isActive = jobs[i]->getIsActive();
+
+        // Insertion into the deadline-ordered open list
+        if (listing.isActive) {
+            int j = snapshot->openCount++;
+            while (j > 0 && snapshot->open[j - 1]->deadlineDay > listing.deadlineDay) {
+                snapshot->open[j] = snapshot->open[j - 1];
+                j--;
+            }
+            snapshot->open[j] = &listing;
+        }
+    }
+    snapshot->count = jobCount;
+    jobCatalog->publish(snapshot);
+}
+
+// Reads the published catalog, so it needs no lock; jobs past their
+// deadline but not yet swept are skipped
+void InternshipSystem::displayJobsClosingWithin(int days)
+{
+    JobCatalogReader catalog(*jobCatalog);
+    long today = currentDayNumber();
+    int first;
+    int end = catalog->openBetween(today, today + days, first);
+
+    OutputBuffer out(cout);
+    out.put("\n=== Jobs Closing Within ").putInt(days).put(" Day(s) ===\n");
+    out.padded("Job ID", 8)
+       .padded("Title", 30)
+       .padded("Company", 20)
+       .padded("Deadline", 12).put('\n');
+    out.repeat('-', 70).put('\n');
+    for (int i = first; i < end; i++) {
+        out.padded(catalog->open[i]->jobID, 8)
+           .padded(catalog->open[i]->title, 30)
+           .padded(catalog->open[i]->company, 20)
+           .padded(catalog->open[i]->deadline, 12).put('\n');
+    }
+    out.flush();
+    if (first == end) {
+        cout << "No open jobs close within " << days << " day(s)." << endl;
+    }
+}
+
+void InternshipSystem::registerStudent() 
+{
     string id, name, email, diploma, skills;
     float cgpa;
     
@@ -3662,8 +9931,12 @@ void InternshipSystem::registerStudent()
     cout << "Enter Skills: ";
     getline(cin, skills);
     
+    beforeStoreChange(STUDENTS_FILE);
+    reserveStudents(studentCount + 1);
     students[studentCount++] = new Student(id, name, email, cgpa, diploma, skills);
     studentHash->insert(students[studentCount-1]);
+    invalidateApplicationCube();
+    invalidateCandidateRankings();
     cout << "Student registered successfully!" << endl;
     logEvent("SYSTEM", "New student registered: " + id);
 }
@@ -3688,6 +9961,7 @@ void InternshipSystem::registerAdmin()
     cin >> password;
     if (!validatePassword(password)) return;
     
+    beforeStoreChange(ADMINS_FILE);
     admins[adminCount++] = new Admin(id, name, email, password);
     cout << "Admin registered successfully!" << endl;
     logEvent("SYSTEM", "New admin registered: " + id);
@@ -3717,6 +9991,7 @@ void InternshipSystem::registerStaff()
     cin >> password;
     if (!validatePassword(password)) return;
     
+    beforeStoreChange(STAFF_FILE);
     staffMembers[staffCount++] = new Staff(id, name, email, department, position, password);
     cout << "Staff registered successfully!" << endl;
     logEvent("SYSTEM", "New staff registered: " + id);
@@ -3744,33 +10019,43 @@ void InternshipSystem::addInternshipJob()
     cin.ignore();
     getline(cin, requirements);
     
+    if (jobHash->search(jobID) != NULL) {
+        cout << "Error: Job ID already exists." << endl;
+        return;
+    }
+    
+    beforeStoreChange(JOBS_FILE);
     jobs[jobCount++] = new InternshipJob(jobID, title, company, deadline, requirements);
+    jobHash->insert(jobs[jobCount - 1]);
+    refreshJobDeadline(jobs[jobCount - 1]);
     cout << "Job added successfully!" << endl;
     logEvent("SYSTEM", "New job added: " + jobID);
 }
 
 void InternshipSystem::displayAllStudents() 
 {
-    cout << "\n=== All Students ===" << endl;
-    cout << left << setw(12) << "Student ID" 
-         << setw(25) << "Name" 
-         << setw(6) << "CGPA" 
-         << setw(15) << "Diploma" << endl;
-    cout << string(58, '-') << endl;
+    OutputBuffer out(cout);
+    out.put("\n=== All Students ===\n");
+    out.padded("Student ID", 12)
+       .padded("Name", 25)
+       .padded("CGPA", 6)
+       .padded("Diploma", 15).put('\n');
+    out.repeat('-', 58).put('\n');
     
     for (int i = 0; i < studentCount; i++) {
-        cout << left << setw(12) << students[i]->getID()
-             << setw(25) << students[i]->getName()
-             << setw(6) << fixed << setprecision(2) << students[i]->getCGPA()
-             << setw(15) << students[i]->getDiploma() << endl;
+        out.padded(students[i]->getID(), 12)
+           .padded(students[i]->getName(), 25)
+           .paddedFixed(students[i]->getCGPA(), 2, 6)
+           .padded(students[i]->getDiploma(), 15).put('\n');
     }
 }
 
 void InternshipSystem::displayAllJobs() 
 {
-    cout << "\n=== All Jobs ===" << endl;
+    OutputBuffer out(cout);
+    out.put("\n=== All Jobs ===\n");
     for (int i = 0; i < jobCount; i++) {
-        jobs[i]->display();
+        jobs[i]->display(out);
     }
 }
 
@@ -3789,11 +10074,1022 @@ void InternshipSystem::displayStatistics()
     cout << "Total Jobs: " << jobCount << endl;
     cout << "Total Staff: " << staffCount << endl;
     cout << "Total Applications: " << applications->getCount() << endl;
+    if (saver.getOperations() > 0) {
+        cout << "File Saves: " << saver.getOperations() << " (" << fixed << setprecision(1)
+             << saver.getTotalSeconds() * 1000 / saver.getOperations() << " ms and "
+             << setprecision(1) << (double)saver.getTotalSyncs() / saver.getOperations()
+             << " fsyncs per save)" << endl;
+    }
+}
+// Scheduler scaling benchmark: sorts and report statistics over a synthetic
+// student set, once per thread count from 1 up to maxThreads
+void runParallelBenchmark(int records, int maxThreads)
+{
+    const char* diplomas[3] = { "IT", "Business", "Accounting" };
+    Student** master = new Student*[records];
+    Student** work = new Student*[records];
+    Student** expectedCGPA = new Student*[records];
+    Student** expectedName = new Student*[records];
+
+    // Fixed-seed generator so every run sorts the same data
+    unsigned long seed = 20240601UL;
+    for (int i = 0; i < records; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        unsigned long r = (seed >> 8) & 0xFFFFFFUL;
+        stringstream id, name;
+        id << (1200000000L + (long)(r % 900000000UL));
+        name << "Student " << (r % 100000UL);
+        master[i] = new Student(id.str(), name.str(), "", (float)(200 + (r % 201)) / 100.0f,
+                                diplomas[r % 3], "");
+    }
+
+    cout << "Parallel benchmark: " << records << " students" << endl;
+    cout << left << setw(9) << "Threads" << setw(16) << "Sort CGPA (ms)" << setw(16) << "Sort name (ms)"
+         << setw(14) << "Stats (ms)" << setw(10) << "Speedup" << "Check" << endl;
+
+    // Sequential reference: the order every parallel run must reproduce
+    for (int i = 0; i < records; i++) expectedCGPA[i] = master[i];
+    double start = getWallClockSeconds();
+    sequentialStableSort(expectedCGPA, records, InternshipSystem::studentHasHigherCGPA);
+    double sequentialCGPA = getWallClockSeconds() - start;
+
+    for (int i = 0; i < records; i++) expectedName[i] = master[i];
+    start = getWallClockSeconds();
+    sequentialStableSort(expectedName, records, InternshipSystem::studentNameBefore);
+    double sequentialName = getWallClockSeconds() - start;
+
+    cout << left << setw(9) << "seq" << fixed << setprecision(1)
+         << setw(16) << sequentialCGPA * 1000 << setw(16) << sequentialName * 1000 << setw(14) << "-"
+         << setw(10) << "-" << "reference" << endl;
+
+    double baseline = 0.0;
+    for (int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+        TaskScheduler scheduler(threads - 1);
+        bool same = true;
+
+        for (int i = 0; i < records; i++) work[i] = master[i];
+        start = getWallClockSeconds();
+        parallelStableSort(scheduler, work, records, InternshipSystem::studentHasHigherCGPA);
+        double cgpaTime = getWallClockSeconds() - start;
+        for (int i = 0; i < records && same; i++) same = (expectedCGPA[i] == work[i]);
+
+        for (int i = 0; i < records; i++) work[i] = master[i];
+        start = getWallClockSeconds();
+        parallelStableSort(scheduler, work, records, InternshipSystem::studentNameBefore);
+        double nameTime = getWallClockSeconds() - start;
+        for (int i = 0; i < records && same; i++) same = (expectedName[i] == work[i]);
+
+        start = getWallClockSeconds();
+        StudentStatistics stats = computeStudentStatistics(scheduler, master, records);
+        double statsTime = getWallClockSeconds() - start;
+        same = same && stats.count == records;
+
+        double total = cgpaTime + nameTime + statsTime;
+        if (threads == 1) baseline = total;
+        cout << left << setw(9) << threads << fixed << setprecision(1)
+             << setw(16) << cgpaTime * 1000 << setw(16) << nameTime * 1000 << setw(14) << statsTime * 1000
+             << setprecision(2) << setw(10) << (total > 0 ? baseline / total : 0.0)
+             << (same ? "ok" : "MISMATCH") << endl;
+
+        if (threads == maxThreads) break;
+    }
+
+    for (int i = 0; i < records; i++) delete master[i];
+    delete[] master;
+    delete[] work;
+    delete[] expectedCGPA;
+    delete[] expectedName;
+}
+
+
+// Backup codec benchmark: compresses each file in backup-chunk-sized blocks,
+// repeating until the timings are stable, and checks every round trip
+void runCompressionBenchmark(int fileCount, const char* const* files)
+{
+    const int blockSize = 8 * 1024;   // Average content-defined chunk size
+    const double minimumSeconds = 0.25;
+
+    cout << "Compression benchmark: " << blockSize / 1024 << "KB blocks" << endl;
+    cout << left << setw(20) << "File" << setw(12) << "Raw (KB)" << setw(14) << "Packed (KB)" << setw(8) << "Ratio"
+         << setw(16) << "Compress MB/s" << setw(18) << "Decompress MB/s" << "Check" << endl;
+
+    char* packed = new char[lzCompressBound(blockSize)];
+    char* unpacked = new char[blockSize];
+    long long allRaw = 0, allPacked = 0;
+
+    for (int f = 0; f < fileCount; f++) {
+        ifstream file(files[f], ios::in | ios::binary);
+        if (!file.is_open()) {
+            cout << left << setw(20) << files[f] << "not found" << endl;
+            continue;
+        }
+        stringstream contents;
+        contents << file.rdbuf();
+        string data = contents.str();
+        long long raw = (long long)data.size();
+
+        // Pack once to size the blocks and check the round trip
+        long long packedBytes = 0;
+        bool same = true;
+        for (long long offset = 0; offset < raw; offset += blockSize) {
+            int size = (int)min((long long)blockSize, raw - offset);
+            int stored = lzCompress(data.data() + offset, size, packed);
+            packedBytes += min(stored, size);   // Blocks that do not shrink are kept raw
+            same = same && lzDecompress(packed, stored, unpacked, size)
+                        && memcmp(unpacked, data.data() + offset, size) == 0;
+        }
+
+        int compressRounds = 0;
+        double start = getWallClockSeconds();
+        double compressTime = 0.0;
+        do {
+            for (long long offset = 0; offset < raw; offset += blockSize) {
+                lzCompress(data.data() + offset, (int)min((long long)blockSize, raw - offset), packed);
+            }
+            compressRounds++;
+            compressTime = getWallClockSeconds() - start;
+        } while (compressTime < minimumSeconds && raw > 0);
+
+        // Decompression is timed over the whole file, block by block
+        int blockCount = (int)((raw + blockSize - 1) / blockSize);
+        string* blocks = new string[blockCount > 0 ? blockCount : 1];
+        for (int b = 0; b < blockCount; b++) {
+            long long offset = (long long)b * blockSize;
+            int size = (int)min((long long)blockSize, raw - offset);
+            blocks[b] = string(packed, lzCompress(data.data() + offset, size, packed));
+        }
+        int decompressRounds = 0;
+        start = getWallClockSeconds();
+        double decompressTime = 0.0;
+        do {
+            long long offset = 0;
+            for (int b = 0; b < blockCount; b++, offset += blockSize) {
+                int size = (int)min((long long)blockSize, raw - offset);
+                lzDecompress(blocks[b].data(), (int)blocks[b].size(), unpacked, size);
+            }
+            decompressRounds++;
+            decompressTime = getWallClockSeconds() - start;
+        } while (decompressTime < minimumSeconds && raw > 0);
+        delete[] blocks;
+
+        double megabytes = raw / (1024.0 * 1024.0);
+        cout << left << setw(20) << files[f] << setw(12) << (raw + 1023) / 1024 << setw(14) << (packedBytes + 1023) / 1024
+             << fixed << setprecision(2) << setw(8) << (packedBytes > 0 ? (double)raw / packedBytes : 0.0)
+             << setprecision(1) << setw(16) << (compressTime > 0 ? megabytes * compressRounds / compressTime : 0.0)
+             << setw(18) << (decompressTime > 0 ? megabytes * decompressRounds / decompressTime : 0.0)
+             << (same ? "ok" : "MISMATCH") << endl;
+        allRaw += raw;
+        allPacked += packedBytes;
+    }
+    cout << "Total: " << allRaw << " bytes packed to " << allPacked << " bytes ("
+         << fixed << setprecision(2) << (allPacked > 0 ? (double)allRaw / allPacked : 0.0) << "x)" << endl;
+
+    delete[] packed;
+    delete[] unpacked;
+}
+
+
+// Seeded test data: InternshipSystem --generate <scale> [seed] [--customers]
+
+// splitmix64: the same seed gives the same data on every platform
+class SeededRandom
+{
+private:
+    unsigned long long state;
+
+public:
+    explicit SeededRandom(unsigned long long seed) : state(seed) {}
+
+    unsigned long long next()
+    {
+        unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound)
+    long below(long bound) { return (long)(next() % (unsigned long long)bound); }
+};
+
+
+const char* const DATASET_FIRST_NAMES[] = { "Aisyah", "Kevin", "Nurul", "Arvind", "Sarah", "Faizal", "Michelle",
+                                            "Daniel", "Hema", "Amirul", "Kai Jie", "Rani", "John", "Siti",
+                                            "Thinesh", "Wei Ming", "Maya", "Riashini", "Farah", "Jason" };
+const char* const DATASET_LAST_NAMES[] = { "Rahman", "Lim", "Izzati", "Raj", "Wong", "Mohd", "Tan", "Lee",
+                                           "Letchumy", "Hakim", "Goh", "Devi", "Noraini", "Kumar", "Leong",
+                                           "Shanti", "Ismail", "Ng", "Chong", "Abdullah" };
+const char* const DATASET_SKILLS[] = { "Java", "HTML", "Communication", "Marketing", "Sales", "Data Analysis",
+                                       "Graphic Design", "Python", "C++", "SQL", "Excel", "Auditing", "SEO",
+                                       "Figma", "Linux", "Agile", "Project Management", "Networking",
+                                       "Financial Reporting", "Public Speaking" };
+const char* const DATASET_DIPLOMAS[] = { "IT", "Business", "Accounting" };
+const char* const DATASET_TITLES[] = { "Software Developer", "Marketing Assistant", "Data Analyst", "UX Designer",
+                                       "IT Support Technician", "Graphic Designer", "Mobile App Developer",
+                                       "Business Analyst", "Accounting Intern", "Cybersecurity Intern" };
+const char* const DATASET_COMPANIES[] = { "Amazon", "Shopee", "Google", "Grab", "Dell", "Canva", "TikTok",
+                                          "AirAsia", "PwC", "CyberSecurity Malaysia", "Petronas", "Maybank" };
+const char* const DATASET_POSITIONS[] = { "Manager", "Coordinator", "Advisor" };
+
+const int DATASET_NAME_COUNT = 20;
+const int DATASET_SKILL_COUNT = 20;
+const int DATASET_TITLE_COUNT = 10;
+const int DATASET_COMPANY_COUNT = 12;
+const int DATASET_DEADLINE_YEAR = 2035;        // Far enough ahead that every generated job is open
+const long DATASET_EPOCH = 1750000000L;        // Customer module timestamps count back from here (June 2025)
+
+
+// One generated file: written to <name>.tmp and renamed into place when
+// complete, so a cancelled run never leaves half a data file
+class DatasetFile
+{
+private:
+    string name;
+    ofstream file;
+    OutputBuffer out;
+    long rows;
+
+    DatasetFile(const DatasetFile&);
+    DatasetFile& operator=(const DatasetFile&);
+
+public:
+    explicit DatasetFile(const string& filename)
+        : name(filename), file((filename + ".tmp").c_str(), ios::out | ios::binary | ios::trunc), out(file), rows(0) {}
+
+    bool isOpen() const { return file.is_open(); }
+    long getRows() const { return rows; }
+    const string& getName() const { return name; }
+
+    // Buffer for the next row; the caller ends it with "|\n" or "\n"
+    OutputBuffer& row()
+    {
+        rows++;
+        return out;
+    }
+
+    bool commit()
+    {
+        out.flush();
+        file.close();
+        return !file.fail() && replaceFile(name + ".tmp", name);
+    }
+};
+
+
+// first.last<number>@domain in lower case, spaces dropped
+void putDatasetEmail(OutputBuffer& out, const char* first, const char* last, long number, const char* domain)
+{
+    for (const char* p = first; *p != '\0'; p++) if (*p != ' ') out.put((char)tolower((unsigned char)*p));
+    out.put('.');
+    for (const char* p = last; *p != '\0'; p++) if (*p != ' ') out.put((char)tolower((unsigned char)*p));
+    out.putInt(number).put('@').put(domain);
+}
+
+// count different skills, comma separated
+void putDatasetSkills(OutputBuffer& out, SeededRandom& random, int count)
+{
+    unsigned long chosen = 0;
+    for (int i = 0; i < count; i++) {
+        int skill;
+        do {
+            skill = (int)random.below(DATASET_SKILL_COUNT);
+        } while (chosen & (1UL << skill));
+        chosen |= 1UL << skill;
+        if (i > 0) out.put(", ");
+        out.put(DATASET_SKILLS[skill]);
+    }
+}
+
+void putTwoDigits(OutputBuffer& out, int value)
+{
+    out.put((char)('0' + value / 10)).put((char)('0' + value % 10));
+}
+
+
+// "5000", "50k", "1.5m": students to generate
+bool parseDatasetScale(const string& text, long& scale)
+{
+    char* end = NULL;
+    double value = strtod(text.c_str(), &end);
+    if (end == text.c_str()) return false;
+    if (*end == 'k' || *end == 'K') {
+        value *= 1000;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        value *= 1000000;
+        end++;
+    }
+    if (*end != '\0' || value < 1 || value > DATASET_MAX_SCALE) return false;
+    scale = (long)value;
+    return true;
+}
+
+
+// Writes students.txt, job_listings.txt, staff.txt, login_admin.txt and
+// applications.txt for scale students in the current directory, and with
+// customers the customer module's customers.txt, orders.txt and
+// tickets.txt. Each file draws from a generator of its own, so the same
+// seed gives the same files whichever of them are written. Jobs and staff
+// live in fixed arrays and are generated at capacity.
+bool generateDataset(long scale, unsigned long seed, bool customers)
+{
+    if (fileExists("students.txt") || fileExists("applications.txt")) {
+        cout << "Data files already exist here; run --generate in an empty directory" << endl;
+        return false;
+    }
+    double startTime = getWallClockSeconds();
+    static const int MONTH_DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    // Jobs: every company gets some, deadlines spread over one year
+    SeededRandom jobRandom(seed ^ 0x4A4F4253ULL);
+    DatasetFile jobs("job_listings.txt");
+    string jobIDs[MAX_JOBS], titles[MAX_JOBS], companies[MAX_JOBS];
+    for (int j = 0; j < MAX_JOBS; j++) {
+        stringstream id;
+        id << "JOB" << (1001 + j);
+        jobIDs[j] = id.str();
+        titles[j] = DATASET_TITLES[jobRandom.below(DATASET_TITLE_COUNT)];
+        companies[j] = DATASET_COMPANIES[j % DATASET_COMPANY_COUNT];
+        int day = (int)jobRandom.below(365);
+        int month = 0;
+        while (day >= MONTH_DAYS[month]) day -= MONTH_DAYS[month++];
+
+        OutputBuffer& out = jobs.row();
+        out.put(jobIDs[j]).put('|').put(titles[j]).put('|').put(companies[j]).put('|');
+        out.putInt(DATASET_DEADLINE_YEAR).put('-');
+        putTwoDigits(out, month + 1);
+        out.put('-');
+        putTwoDigits(out, day + 1);
+        out.put('|');
+        putDatasetSkills(out, jobRandom, 2 + (int)jobRandom.below(2));
+        out.put("|\n");
+    }
+
+    // Staff: one department per company, so every review queue has work
+    SeededRandom staffRandom(seed ^ 0x53544146ULL);
+    DatasetFile staff("staff.txt");
+    for (int s = 0; s < MAX_STAFF; s++) {
+        const char* first = DATASET_FIRST_NAMES[staffRandom.below(DATASET_NAME_COUNT)];
+        const char* last = DATASET_LAST_NAMES[staffRandom.below(DATASET_NAME_COUNT)];
+        OutputBuffer& out = staff.row();
+        out.put("STF").putInt(2001 + s).put('|').put(first).put(' ').put(last).put('|');
+        putDatasetEmail(out, first, last, 2001 + s, "mmu.edu.my");
+        out.put('|').put(DATASET_COMPANIES[s % DATASET_COMPANY_COUNT]);
+        out.put('|').put(DATASET_POSITIONS[staffRandom.below(3)]);
+        out.put("|pwd").putInt(2001 + s).put("|\n");
+    }
+
+    // Admins: the sample accounts, so the documented logins work
+    DatasetFile admins("login_admin.txt");
+    admins.row().put("admin1|Admin One|admin1@mmu.edu.my|password123|\n");
+    admins.row().put("admin2|Admin Two|admin2@mmu.edu.my|admin456|\n");
+    admins.row().put("test|Test Admin|test@mmu.edu.my|123456|\n");
+
+    // Students and their applications in one pass. IDs are a permutation
+    // of 1300000000 + [0, scale), so they are unique but not in file order.
+    SeededRandom studentRandom(seed);
+    SeededRandom applicationRandom(seed ^ 0x41505053ULL);
+    DatasetFile students("students.txt");
+    DatasetFile applications("applications.txt");
+    long long step = scale / 2 + 1 + studentRandom.below(scale);
+    while (true) {
+        long long a = step, b = scale;
+        while (b != 0) {
+            long long rest = a % b;
+            a = b;
+            b = rest;
+        }
+        if (a == 1) break;
+        step++;
+    }
+    long long offset = studentRandom.below(scale);
+
+    for (long i = 0; i < scale; i++) {
+        long id = 1300000000L + (long)((i * step + offset) % scale);
+        const char* first = DATASET_FIRST_NAMES[studentRandom.below(DATASET_NAME_COUNT)];
+        const char* last = DATASET_LAST_NAMES[studentRandom.below(DATASET_NAME_COUNT)];
+        long cents = 200 + studentRandom.below(101) + studentRandom.below(101);  // 2.00 to 4.00, most near 3.00
+
+        OutputBuffer& out = students.row();
+        out.putInt(id).put('|').put(first).put(' ').put(last).put('|');
+        putDatasetEmail(out, first, last, i, "mmu.edu.my");
+        out.put('|').putFixed(cents / 100.0, 2);
+        out.put('|').put(DATASET_DIPLOMAS[studentRandom.below(3)]).put('|');
+        putDatasetSkills(out, studentRandom, 2 + (int)studentRandom.below(3));
+        out.put("|\n");
+
+        // Zero to six different jobs, three on average
+        int applied = (int)applicationRandom.below(7);
+        unsigned long long chosen = 0;
+        for (int a = 0; a < applied; a++) {
+            int j;
+            do {
+                j = (int)applicationRandom.below(MAX_JOBS);
+            } while (chosen & (1ULL << j));
+            chosen |= 1ULL << j;
+            long roll = applicationRandom.below(100);
+            OutputBuffer& row = applications.row();
+            row.putInt(id).put('|').put(jobIDs[j]).put('|').put(titles[j]).put('|').put(companies[j]).put('|');
+            row.put(roll < 70 ? "Pending" : roll < 85 ? "Approved" : "Rejected").put('\n');
+        }
+    }
+
+    DatasetFile* files[4] = { &jobs, &staff, &admins, &students };
+    bool ok = applications.isOpen() && applications.commit();
+    for (int f = 0; f < 4; f++) ok = files[f]->isOpen() && files[f]->commit() && ok;
+    if (!ok) {
+        cout << "Cannot write the data files in this directory" << endl;
+        return false;
+    }
+    cout << "Generated " << students.getRows() << " students, " << jobs.getRows() << " jobs, "
+         << staff.getRows() << " staff, " << admins.getRows() << " admins and "
+         << applications.getRows() << " applications (seed " << seed << ") in "
+         << fixed << setprecision(1) << (getWallClockSeconds() - startTime) * 1000 << " ms" << endl;
+    if (!customers) return true;
+
+    // Customer module files, in the proportions of its own sample data:
+    // two orders and half a ticket per customer. Each customer's orders are
+    // written with the customer, whose row ends with their order IDs as the
+    // module's order history.
+    startTime = getWallClockSeconds();
+    SeededRandom customerRandom(seed ^ 0x43555354ULL);
+    SeededRandom orderRandom(seed ^ 0x4F524452ULL);
+    DatasetFile customerFile("customers.txt");
+    DatasetFile orderFile("orders.txt");
+    long orderID = 0;
+    for (long c = 1; c <= scale; c++) {
+        const char* first = DATASET_FIRST_NAMES[customerRandom.below(DATASET_NAME_COUNT)];
+        const char* last = DATASET_LAST_NAMES[customerRandom.below(DATASET_NAME_COUNT)];
+        long spentCents = customerRandom.below(250000);
+        OutputBuffer& out = customerFile.row();
+        out.put('C').putInt(c).put('|').put(first).put(' ').put(last).put('|');
+        putDatasetEmail(out, first, last, c, "customer.com");
+        out.put("|01").putInt(customerRandom.below(10)).put('-').putInt(1000000 + customerRandom.below(9000000));
+        out.put('|').putFixed(spentCents / 100.0, 2).put('|').putInt(spentCents / 5000);
+        out.put('|').put(spentCents < 50000 ? "Basic" : spentCents < 100000 ? "Silver" : "Gold");
+        out.put('|').putInt(DATASET_EPOCH - customerRandom.below(365L * 86400));
+
+        // Zero to four orders, two on average
+        int orderCount = (int)orderRandom.below(5);
+        for (int o = 0; o < orderCount; o++) {
+            out.put("|O").putInt(++orderID);
+            OutputBuffer& order = orderFile.row();
+            order.put('O').putInt(orderID).put("|C").putInt(c);
+            order.put("|Product").putInt(1 + orderRandom.below(10));
+            order.put('|').putFixed((50 + orderRandom.below(500)) / 10.0, 1);
+            order.put('|').put(orderRandom.below(3) == 0 ? "Completed" : "Pending");
+            order.put('|').putInt(DATASET_EPOCH - orderRandom.below(10L * 86400));
+            order.put('|').put(orderRandom.below(2) == 0 ? "Cash" : "Card").put('\n');
+        }
+        out.put('\n');
+    }
+
+    SeededRandom ticketRandom(seed ^ 0x5449434BULL);
+    DatasetFile ticketFile("tickets.txt");
+    for (long t = 1; t <= (scale + 1) / 2; t++) {
+        bool resolved = ticketRandom.below(2) == 0;
+        long created = DATASET_EPOCH - ticketRandom.below(10L * 86400);
+        OutputBuffer& out = ticketFile.row();
+        out.put('T').putInt(t).put("|C").putInt(1 + ticketRandom.below(scale));
+        out.put("|Issue").putInt(1 + ticketRandom.below(5));
+        out.put('|').put(resolved ? "Resolved" : "Open").put('|').putInt(created);
+        out.put('|').putInt(resolved ? created + ticketRandom.below(86400) : 0).put('\n');
+    }
+
+    ok = customerFile.isOpen() && customerFile.commit();
+    ok = orderFile.isOpen() && orderFile.commit() && ok;
+    ok = ticketFile.isOpen() && ticketFile.commit() && ok;
+    if (!ok) {
+        cout << "Cannot write the customer module files in this directory" << endl;
+        return false;
+    }
+    cout << "Generated " << customerFile.getRows() << " customers, " << orderFile.getRows() << " orders and "
+         << ticketFile.getRows() << " tickets in " << fixed << setprecision(1)
+         << (getWallClockSeconds() - startTime) * 1000 << " ms (copy them to the customer module's shared directory)"
+         << endl;
+    return true;
+}
+
+
+// Benchmark suite: InternshipSystem --bench [--rounds n] [results file]
+
+enum BenchmarkStep
+{
+    BENCH_LOAD,
+    BENCH_SAVE_STUDENTS, BENCH_SAVE_JOBS, BENCH_SAVE_STAFF, BENCH_SAVE_ADMINS, BENCH_SAVE_APPLICATIONS,
+    BENCH_LOOKUP_STUDENT, BENCH_LOOKUP_JOB, BENCH_LOOKUP_APPLICATION,
+    BENCH_SORT_STUDENTS_CGPA, BENCH_SORT_STUDENTS_ID, BENCH_SORT_STUDENTS_NAME,
+    BENCH_SORT_JOBS_DEADLINE, BENCH_SORT_JOBS_TITLE, BENCH_SORT_JOBS_COMPANY,
+    BENCH_SEARCH_BINARY_ID, BENCH_SEARCH_FIBONACCI_ID, BENCH_SEARCH_INTERPOLATION_CGPA, BENCH_SEARCH_LINEAR_TITLE,
+    BENCH_SEARCH_DIPLOMA, BENCH_SEARCH_CGPA_RANGE, BENCH_SEARCH_COMPANY,
+    BENCH_REPORT_DETAILED, BENCH_REPORT_PERFORMANCE, BENCH_EXPORT_STUDENTS, BENCH_EXPORT_APPLICATIONS,
+    BENCH_BACKUP,
+    BENCH_STEP_COUNT
+};
+
+struct BenchmarkDefinition
+{
+    const char* name;
+    const char* group;
+};
+
+const BenchmarkDefinition BENCHMARK_STEPS[BENCH_STEP_COUNT] = {
+    { "load_all", "load" },
+    { "save_students", "save" },
+    { "save_jobs", "save" },
+    { "save_staff", "save" },
+    { "save_admins", "save" },
+    { "save_applications", "save" },
+    { "lookup_student_hash", "lookup" },
+    { "lookup_job_hash", "lookup" },
+    { "lookup_application", "lookup" },
+    { "sort_students_cgpa", "sort" },
+    { "sort_students_id", "sort" },
+    { "sort_students_name", "sort" },
+    { "sort_jobs_deadline", "sort" },
+    { "sort_jobs_title", "sort" },
+    { "sort_jobs_company", "sort" },
+    { "search_binary_id", "search" },
+    { "search_fibonacci_id", "search" },
+    { "search_interpolation_cgpa", "search" },
+    { "search_linear_title", "search" },
+    { "search_diploma", "search" },
+    { "search_cgpa_range", "search" },
+    { "search_company", "search" },
+    { "report_detailed", "report" },
+    { "report_performance", "report" },
+    { "export_students_csv", "report" },
+    { "export_applications_csv", "report" },
+    { "backup", "backup" }
+};
+
+const ReportColumn BENCHMARK_COLUMNS[] = {
+    { "benchmark", "Benchmark", COLUMN_TEXT, 27 },
+    { "group", "Group", COLUMN_TEXT, 8 },
+    { "runs", "Runs", COLUMN_INTEGER, 6 },
+    { "operations", "Ops/run", COLUMN_INTEGER, 9 },
+    { "found", "Found", COLUMN_INTEGER, 9 },
+    { "median_ms", "Median (ms)", COLUMN_DECIMAL, 13 },
+    { "min_ms", "Min (ms)", COLUMN_DECIMAL, 12 },
+    { "max_ms", "Max (ms)", COLUMN_DECIMAL, 12 },
+    { "ns_per_op", "ns/op", COLUMN_DECIMAL, 14 }
+};
+const ReportTable BENCHMARK_TABLE = { "benchmark", "BENCHMARK RESULTS", BENCHMARK_COLUMNS, 9, TABLE_ROWS };
+
+
+// Random keys for the lookups, so they touch the tables the way users do
+// rather than in file order, and the order every sort starts from
+void InternshipSystem::takeBenchmarkSample(BenchmarkSample& sample)
+{
+    SeededRandom random(DATASET_SEED);
+    sample.keyCount = (studentCount > 0 && jobCount > 0) ? BENCHMARK_LOOKUPS : 0;
+    sample.studentIDs = new string[BENCHMARK_LOOKUPS];
+    sample.jobIDs = new string[BENCHMARK_LOOKUPS];
+    for (int k = 0; k < sample.keyCount; k++) {
+        sample.studentIDs[k] = students[random.below(studentCount)]->getID();
+        sample.jobIDs[k] = jobs[random.below(jobCount)]->getJobID();
+    }
+
+    // Every stride-th application, then shuffled
+    sample.applicationStudents = new string[BENCHMARK_LOOKUPS];
+    sample.applicationJobs = new string[BENCHMARK_LOOKUPS];
+    int stride = applications->getCount() / BENCHMARK_LOOKUPS + 1;
+    int index = 0;
+    for (ApplicationNode* node = applications->getHead(); node != NULL && sample.applicationKeyCount < BENCHMARK_LOOKUPS;
+         node = node->next, index++) {
+        if (index % stride != 0) continue;
+        sample.applicationStudents[sample.applicationKeyCount] = node->studentID;
+        sample.applicationJobs[sample.applicationKeyCount++] = node->jobID;
+    }
+    for (int k = sample.applicationKeyCount - 1; k > 0; k--) {
+        int other = (int)random.below(k + 1);
+        sample.applicationStudents[k].swap(sample.applicationStudents[other]);
+        sample.applicationJobs[k].swap(sample.applicationJobs[other]);
+    }
+
+    sample.studentOrder = new Student*[studentCount > 0 ? studentCount : 1];
+    for (int i = 0; i < studentCount; i++) sample.studentOrder[i] = students[i];
+    for (int j = 0; j < jobCount; j++) sample.jobOrder[j] = jobs[j];
+}
+
+// Puts the records back in loaded order, so every sort run sorts the same input
+void InternshipSystem::restoreBenchmarkOrder(const BenchmarkSample& sample)
+{
+    for (int i = 0; i < studentCount; i++) students[i] = sample.studentOrder[i];
+    for (int j = 0; j < jobCount; j++) jobs[j] = sample.jobOrder[j];
+}
+
+// Runs one benchmark once through the same functions the menus call;
+// returns how many operations that was. found counts the records the
+// lookups and searches found, so the compiler cannot drop a lookup whose
+// result would otherwise go unused, and it shows in the results.
+long InternshipSystem::runBenchmarkStep(int step, const BenchmarkSample& sample, long& found)
+{
+    string someStudent = sample.keyCount > 0 ? sample.studentIDs[0] : "";
+    InternshipJob* lastJob = jobCount > 0 ? sample.jobOrder[jobCount - 1] : NULL;
+    found = 0;
+
+    switch (step) {
+        case BENCH_LOAD: loadSystemData(); return 1;
+        case BENCH_SAVE_STUDENTS: saveStudentsToFile(); return 1;
+        case BENCH_SAVE_JOBS: saveJobsToFile(); return 1;
+        case BENCH_SAVE_STAFF: saveStaffToFile(); return 1;
+        case BENCH_SAVE_ADMINS: saveAdminsToFile(); return 1;
+        case BENCH_SAVE_APPLICATIONS: saveApplicationsToFile(); return 1;
+
+        case BENCH_LOOKUP_STUDENT:
+            for (int k = 0; k < sample.keyCount; k++) {
+                if (hashSearchStudent(sample.studentIDs[k]) != NULL) found++;
+            }
+            return sample.keyCount;
+        case BENCH_LOOKUP_JOB:
+            for (int k = 0; k < sample.keyCount; k++) {
+                if (hashSearchJob(sample.jobIDs[k]) != NULL) found++;
+            }
+            return sample.keyCount;
+        case BENCH_LOOKUP_APPLICATION:
+            for (int k = 0; k < sample.applicationKeyCount; k++) {
+                if (applications->find(sample.applicationStudents[k], sample.applicationJobs[k]) != NULL) found++;
+            }
+            return sample.applicationKeyCount;
+
+        case BENCH_SORT_STUDENTS_CGPA: selectionSortStudentsByCGPA(); return 1;
+        case BENCH_SORT_STUDENTS_ID: selectionSortStudentsByID(); return 1;
+        case BENCH_SORT_STUDENTS_NAME: insertionSortStudentsByName(); return 1;
+        case BENCH_SORT_JOBS_DEADLINE: bubbleSortJobsByDeadline(); return 1;
+        case BENCH_SORT_JOBS_TITLE: bubbleSortJobsByTitle(); return 1;
+        case BENCH_SORT_JOBS_COMPANY: mergeSortJobsByCompany(); return 1;
+
+        case BENCH_SEARCH_BINARY_ID: found = binarySearchStudentByID(someStudent) >= 0; return 1;
+        case BENCH_SEARCH_FIBONACCI_ID: found = fibonacciSearchStudentByID(someStudent) >= 0; return 1;
+        case BENCH_SEARCH_INTERPOLATION_CGPA: found = interpolationSearchStudentByCGPA(3.0f) >= 0; return 1;
+        case BENCH_SEARCH_LINEAR_TITLE:
+            found = linearSearchJobByTitle(lastJob != NULL ? lastJob->getTitle() : "") >= 0;
+            return 1;
+        case BENCH_SEARCH_DIPLOMA: searchStudentsByDiploma("IT"); return 1;
+        case BENCH_SEARCH_CGPA_RANGE: searchStudentsByCGPARange(3.0f, 3.5f); return 1;
+        case BENCH_SEARCH_COMPANY: searchJobsByCompany(lastJob != NULL ? lastJob->getCompany() : ""); return 1;
+
+        case BENCH_REPORT_DETAILED: generateDetailedReport(REPORT_TEXT); return 1;
+        case BENCH_REPORT_PERFORMANCE: generateStudentPerformanceReport(REPORT_TEXT); return 1;
+        case BENCH_EXPORT_STUDENTS: exportStudents(REPORT_CSV); return 1;
+        case BENCH_EXPORT_APPLICATIONS: exportApplications(REPORT_CSV); return 1;
+
+        case BENCH_BACKUP: backupSystemData(); return 1;
+    }
+    return 0;
+}
+
+
+// Times every benchmark over the data in the current directory, shows the
+// results and saves them as JSON for comparing runs. Console output of the
+// functions under test is discarded while they run. Reports, exports and
+// backups are written next to the data like any other run's.
+bool InternshipSystem::runBenchmarkSuite(const string& resultsFile, int rounds)
+{
+    ensureApplicationsLoaded();
+    cout << "Benchmark: " << studentCount << " students, " << jobCount << " jobs, "
+         << applications->getCount() << " applications; " << rounds << " run(s) each on "
+         << getHardwareThreadCount() << " thread(s)" << endl;
+
+    BenchmarkResult results[BENCH_STEP_COUNT];
+    BenchmarkSample sample;
+    for (int step = 0; step < BENCH_STEP_COUNT; step++) {
+        BenchmarkResult& result = results[step];
+        result.name = BENCHMARK_STEPS[step].name;
+        result.group = BENCHMARK_STEPS[step].group;
+        for (int run = 0; run < rounds; run++) {
+            if (sample.studentOrder != NULL) restoreBenchmarkOrder(sample);
+            StreamSilencer quiet(cout);
+            long long start = getMonotonicNanoseconds();
+            result.operations = runBenchmarkStep(step, sample, result.found);
+            result.nanoseconds[result.runs++] = getMonotonicNanoseconds() - start;
+        }
+        // Loading replaces every record, so the sample is taken after it
+        if (step == BENCH_LOAD) takeBenchmarkSample(sample);
+    }
+    restoreBenchmarkOrder(sample);
+
+    TextReportWriter screen(cout);
+    screen.beginTable(BENCHMARK_TABLE);
+    for (int step = 0; step < BENCH_STEP_COUNT; step++) {
+        const BenchmarkResult& result = results[step];
+        screen.text(result.name);
+        screen.text(result.group);
+        screen.integer(result.runs);
+        screen.integer(result.operations);
+        screen.integer(result.found);
+        screen.decimal(result.median() / 1e6);
+        screen.decimal(result.fastest() / 1e6);
+        screen.decimal(result.slowest() / 1e6);
+        screen.decimal(result.operations > 0 ? result.median() / result.operations : 0.0);
+        screen.endRow();
+    }
+    screen.endTable();
+    screen.finish();
+
+    time_t now = time(0);
+    char created[32];
+    strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    ostringstream json;
+    json << "{\n  \"suite\": \"InternshipSystem\",\n  \"created\": \"" << created << "\",\n"
+         << "  \"threads\": " << getHardwareThreadCount() << ",\n  \"rounds\": " << rounds << ",\n"
+         << "  \"dataset\": { \"students\": " << studentCount << ", \"jobs\": " << jobCount
+         << ", \"staff\": " << staffCount << ", \"admins\": " << adminCount
+         << ", \"applications\": " << applications->getCount() << " },\n  \"results\": [\n"
+         << fixed << setprecision(3);
+    for (int step = 0; step < BENCH_STEP_COUNT; step++) {
+        const BenchmarkResult& result = results[step];
+        json << "    { \"name\": \"" << result.name << "\", \"group\": \"" << result.group
+             << "\", \"runs\": " << result.runs << ", \"operations\": " << result.operations
+             << ", \"found\": " << result.found
+             << ", \"median_ms\": " << result.median() / 1e6 << ", \"mean_ms\": " << result.mean() / 1e6
+             << ", \"min_ms\": " << result.fastest() / 1e6 << ", \"max_ms\": " << result.slowest() / 1e6
+             << ", \"ns_per_op\": " << (result.operations > 0 ? result.median() / result.operations : 0.0)
+             << " }" << (step + 1 < BENCH_STEP_COUNT ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    if (!saver.save(resultsFile, json.str())) {
+        cout << "Cannot write " << resultsFile << endl;
+        return false;
+    }
+    cout << "Results written to " << resultsFile << endl;
+    logEvent("SYSTEM", "Benchmark suite completed: " + resultsFile);
+    return true;
 }
-int main() 
+
+
+int main(int argc, char* argv[]) 
 {
+    // Options that watch any mode below, given before it:
+    //   --metrics <file>  Prometheus metrics, rewritten while the program runs
+    //   --trace <file>    Chrome trace of the run, written on exit
+    MetricsExporter exporter(metrics);
+    TraceSession trace;
+    while (argc >= 3 && (string(argv[1]) == "--metrics" || string(argv[1]) == "--trace")) {
+        bool started = string(argv[1]) == "--metrics" ? exporter.start(argv[2], METRICS_EXPORT_SECONDS)
+                                                      : trace.start(argv[2]);
+        if (!started) {
+            cout << "Cannot write " << argv[2] << endl;
+            return 1;
+        }
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    // Scaling benchmark: InternshipSystem --bench-parallel [records] [max threads]
+    if (argc >= 2 && string(argv[1]) == "--bench-parallel") {
+        int records = (argc >= 3) ? atoi(argv[2]) : 1000000;
+        int maxThreads = (argc >= 4) ? atoi(argv[3]) : getHardwareThreadCount();
+        if (records < 1) records = 1;
+        if (maxThreads < 1) maxThreads = 1;
+        if (maxThreads > MAX_WORKER_THREADS + 1) maxThreads = MAX_WORKER_THREADS + 1;
+        runParallelBenchmark(records, maxThreads);
+        return 0;
+    }
+
+    // Backup codec benchmark: InternshipSystem --bench-compression [files...]
+    if (argc >= 2 && string(argv[1]) == "--bench-compression") {
+        if (argc >= 3) {
+            runCompressionBenchmark(argc - 2, argv + 2);
+        } else {
+            runCompressionBenchmark(BACKUP_FILE_COUNT, BACKUP_FILES);
+        }
+        return 0;
+    }
+
+    // Seeded test data: InternshipSystem --generate <scale> [seed] [--customers]
+    if (argc >= 3 && string(argv[1]) == "--generate") {
+        long scale = 0;
+        unsigned long seed = DATASET_SEED;
+        bool customers = false;
+        bool valid = parseDatasetScale(argv[2], scale);
+        for (int i = 3; i < argc && valid; i++) {
+            char* end = NULL;
+            if (string(argv[i]) == "--customers") {
+                customers = true;
+            } else {
+                seed = strtoul(argv[i], &end, 10);
+                valid = (end != argv[i] && *end == '\0');
+            }
+        }
+        if (!valid) {
+            cout << "Usage: --generate <students, e.g. 1000, 50k or 10m> [seed] [--customers]" << endl;
+            cout << "Scales from 1 to " << DATASET_MAX_SCALE << " students" << endl;
+            return 1;
+        }
+        return generateDataset(scale, seed, customers) ? 0 : 1;
+    }
+
     try {
         InternshipSystem system;
+
+        // Commands without menus: InternshipSystem --run [options] <command> ... | --script <file or -> [options]
+        // Options: --quiet, --stop-on-error, --results <file base> [--format text|csv|jsonl|columnar]
+        if (argc >= 2 && (string(argv[1]) == "--run" || string(argv[1]) == "--script")) {
+            bool fromScript = string(argv[1]) == "--script";
+            bool quiet = false;
+            bool stopOnError = false;
+            string scriptFile, resultsBase;
+            ReportFormat resultsFormat = REPORT_JSONL;
+            stringstream commands;
+            bool valid = true;
+            for (int i = 2; i < argc && valid; i++) {
+                string argument = argv[i];
+                if (argument == "--quiet") {
+                    quiet = true;
+                } else if (argument == "--stop-on-error") {
+                    stopOnError = true;
+                } else if (argument == "--results" && i + 1 < argc) {
+                    resultsBase = argv[++i];
+                } else if (argument == "--format" && i + 1 < argc) {
+                    valid = parseReportFormat(argv[++i], resultsFormat);
+                } else if (!fromScript) {
+                    commands << argument << "\n";
+                } else if (scriptFile.empty()) {
+                    scriptFile = argument;
+                } else {
+                    valid = false;
+                }
+            }
+            if (!valid || (fromScript && scriptFile.empty()) || (!fromScript && commands.str().empty())) {
+                cout << "Usage: --run [options] \"<command> [arguments]\" ...  or  --script <file or -> [options]" << endl;
+                cout << "Options: --quiet, --stop-on-error, --results <file base> [--format text|csv|jsonl|columnar]" << endl;
+                return 1;
+            }
+
+            istream* script = &commands;
+            ifstream file;
+            if (fromScript && scriptFile == "-") {
+                script = &cin;
+            } else if (fromScript) {
+                file.open(scriptFile.c_str());
+                if (!file.is_open()) {
+                    cout << "Cannot open " << scriptFile << endl;
+                    return 1;
+                }
+                script = &file;
+            }
+
+            if (resultsBase.empty()) {
+                return system.runCommandScript(*script, quiet, stopOnError, NULL) == 0 ? 0 : 1;
+            }
+            ReportOutput results(resultsFormat, resultsBase);
+            int failed = system.runCommandScript(*script, quiet, stopOnError, &*results);
+            if (!results->finish()) {
+                cout << "Cannot write " << results->getFiles() << endl;
+                return 1;
+            }
+            return failed == 0 ? 0 : 1;
+        }
+
+        // Benchmark suite: InternshipSystem --bench [--rounds n] [results file]
+        if (argc >= 2 && string(argv[1]) == "--bench") {
+            int rounds = BENCHMARK_ROUNDS;
+            string resultsFile = "benchmark_" + system.getCurrentTimestamp() + ".json";
+            for (int i = 2; i < argc; i++) {
+                if (string(argv[i]) == "--rounds" && i + 1 < argc) {
+                    rounds = atoi(argv[++i]);
+                } else {
+                    resultsFile = argv[i];
+                }
+            }
+            if (rounds < 1) rounds = 1;
+            if (rounds > MAX_BENCHMARK_ROUNDS) rounds = MAX_BENCHMARK_ROUNDS;
+            return system.runBenchmarkSuite(resultsFile, rounds) ? 0 : 1;
+        }
+
+        // Non-interactive bulk import: InternshipSystem --import <file>
+        if (argc >= 3 && string(argv[1]) == "--import") {
+            ImportResult result = system.importApplications(argv[2]);
+            cout << "Rows: " << result.totalRows
+                 << " | Accepted: " << result.accepted
+                 << " | Duplicates: " << result.duplicates
+                 << " | Rejected: " << result.rejected
+                 << " | " << fixed << setprecision(0) << result.rowsPerSecond << " rows/s" << endl;
+            cout << "Reject report: " << result.rejectFile << endl;
+            return result.totalRows == result.accepted ? 0 : 1;
+        }
+
+        // Non-interactive batch decisions: InternshipSystem --decide <file>
+        if (argc >= 3 && string(argv[1]) == "--decide") {
+            try {
+                int changed = system.applyDecisionFile(argv[2]);
+                cout << changed << " application(s) changed" << endl;
+                return 0;
+            } catch (const exception& e) {
+                cout << "Batch not applied: " << e.what() << endl;
+                return 1;
+            }
+        }
+
+        // Cross-tab query: InternshipSystem --cube <rows>[,<columns>] [dimension=value ...] [--rate]
+        if (argc >= 3 && string(argv[1]) == "--cube") {
+            CubeQuery query;
+            string groupBy = argv[2];
+            size_t comma = groupBy.find(',');
+            string rows = groupBy.substr(0, comma);
+            string columns = (comma == string::npos) ? "" : groupBy.substr(comma + 1);
+            bool valid = (rows == "all" || parseCubeDimension(rows, query.rows)) &&
+                         (columns.empty() || parseCubeDimension(columns, query.columns));
+            for (int i = 3; i < argc && valid; i++) {
+                string argument = argv[i];
+                size_t equals = argument.find('=');
+                int dimension;
+                if (argument == "--rate") {
+                    query.approvalRate = true;
+                } else if (equals != string::npos && parseCubeDimension(argument.substr(0, equals), dimension)) {
+                    query.slice[dimension] = argument.substr(equals + 1);
+                } else {
+                    valid = false;
+                }
+            }
+            if (!valid) {
+                cout << "Usage: --cube <rows>[,<columns>] [dimension=value ...] [--rate]" << endl;
+                cout << "Dimensions: diploma, company (or department), status, month; rows may be 'all'" << endl;
+                return 1;
+            }
+            system.showApplicationCube(query);
+            return 0;
+        }
+
+        // Backups: InternshipSystem --backup | --backups | --restore <snapshot> [--serial]
+        if (argc >= 2 && string(argv[1]) == "--backup") {
+            return system.backupSystemData().empty() ? 1 : 0;
+        }
+        if (argc >= 2 && string(argv[1]) == "--backups") {
+            system.listBackups();
+            return 0;
+        }
+        if (argc >= 3 && string(argv[1]) == "--restore") {
+            bool parallel = !(argc >= 4 && string(argv[3]) == "--serial");
+            return system.restoreSystemData(argv[2], parallel) ? 0 : 1;
+        }
+
+        // Diagnostics: InternshipSystem --diagnostics [file base], which also writes <file base>.jsonl
+        if (argc >= 2 && string(argv[1]) == "--diagnostics") {
+            system.ensureApplicationsLoaded();
+            return system.runSystemDiagnostics(REPORT_JSONL, (argc >= 3) ? argv[2] : "") ? 0 : 1;
+        }
+
+        // Candidate ranking: InternshipSystem --rank <job ID> [count]
+        if (argc >= 3 && string(argv[1]) == "--rank") {
+            system.showCandidateRanking(argv[2], (argc >= 4) ? atoi(argv[3]) : REPORT_TOP_STUDENTS);
+            return 0;
+        }
+
+        // Applicant query: InternshipSystem --query [condition ...] [--select fields]
+        //                  [--format text|csv|jsonl|columnar] [--limit rows]
+        if (argc >= 2 && string(argv[1]) == "--query") {
+            ApplicantQuery query;
+            parseJoinColumns("student_id,name,cgpa,job_id,title,company,status", query);
+            string format;
+            ReportFormat chosen = REPORT_TEXT;
+            bool valid = true;
+            for (int i = 2; i < argc && valid; i++) {
+                string argument = argv[i];
+                if (argument == "--select" && i + 1 < argc) {
+                    valid = parseJoinColumns(argv[++i], query);
+                } else if (argument == "--format" && i + 1 < argc) {
+                    format = argv[++i];
+                    valid = parseReportFormat(format, chosen);
+                } else if (argument == "--limit" && i + 1 < argc) {
+                    query.limit = atol(argv[++i]);
+                } else if (query.conditionCount < MAX_JOIN_CONDITIONS) {
+                    valid = parseJoinCondition(argument, query.conditions[query.conditionCount++]);
+                } else {
+                    valid = false;
+                }
+            }
+            if (!valid) {
+                cout << "Usage: --query [field<op>value ...] [--select f1,f2] [--format text|csv|jsonl|columnar] [--limit n]" << endl;
+                cout << "Operators: = != < <= > >= ~ (contains); fields as in the Applicant Query menu" << endl;
+                return 1;
+            }
+            if (format.empty()) {
+                TextReportWriter screen(cout);
+                system.runApplicantQuery(query, screen);
+                return screen.finish() ? 0 : 1;
+            }
+            ReportOutput output(chosen, system.reportFileBase("applicant_query_"));
+            long rows = system.runApplicantQuery(query, *output);
+            if (!output->finish()) {
+                cout << "Cannot write " << output->getFiles() << endl;
+                return 1;
+            }
+            cout << rows << " row(s) written to " << output->getFiles() << endl;
+            return 0;
+        }
+
+        // Multi-user server: InternshipSystem --serve <socket path> [threads]
+        if (argc >= 3 && string(argv[1]) == "--serve") {
+            int threads = (argc >= 4) ? atoi(argv[3]) : getHardwareThreadCount() * 2;
+            system.runServer(argv[2], threads);
+            return 0;
+        }
+
         system.mainMenu();
     } catch (const exception& e) {
         cout << "System Error: " << e.what() << endl;
@@ -0,0 +1,629 @@
+#ifndef BACKUP_STORE_HPP
+#define BACKUP_STORE_HPP
+
+// Content-addressed backup storage for Project_GR1.cpp. Data is cut into
+// chunks at content-defined boundaries, so an edit only changes the chunks
+// around it, and each chunk is stored once under the SHA-256 of its bytes.
+// A snapshot is a manifest listing the chunks of every file it contains.
+//
+// Layout under the backup root:
+//   packs/<snapshot id>.pack    compressed chunks first stored by that backup
+//   packs.txt                   finished packs, oldest first
+//   snapshots/<snapshot id>.manifest
+//   snapshots.txt               one summary line per snapshot, oldest first
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <streambuf>
+#include <string>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+#include "block_codec.hpp"
+#include "file_utils.hpp"
+#include "thread_utils.hpp"
+using namespace std;
+
+
+const int CHUNK_MIN_SIZE = 2 * 1024;    // No boundary before this many bytes
+const int CHUNK_MAX_SIZE = 64 * 1024;   // Forced boundary
+const int CHUNK_BOUNDARY_BITS = 13;     // About 8KB between boundaries after the minimum
+
+
+inline bool makeDirectory(const string& path)
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) return (info.st_mode & S_IFDIR) != 0;
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0;
+#else
+    return mkdir(path.c_str(), 0755) == 0;
+#endif
+}
+
+
+inline bool fileExists(const string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+
+// SHA-256 (FIPS 180-4), fed incrementally
+class Sha256
+{
+private:
+    unsigned int state[8];
+    unsigned char block[64];
+    int blockUsed;
+    unsigned long long length;
+
+    static unsigned int rotate(unsigned int x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress(const unsigned char* data)
+    {
+        static const unsigned int K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        unsigned int w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = ((unsigned int)data[4 * i] << 24) | ((unsigned int)data[4 * i + 1] << 16)
+                 | ((unsigned int)data[4 * i + 2] << 8) | (unsigned int)data[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            unsigned int s0 = rotate(w[i - 15], 7) ^ rotate(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            unsigned int s1 = rotate(w[i - 2], 17) ^ rotate(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        unsigned int a = state[0], b = state[1], c = state[2], d = state[3];
+        unsigned int e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+            unsigned int t1 = h + (rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            unsigned int t2 = (rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+public:
+    Sha256() { reset(); }
+
+    void reset()
+    {
+        static const unsigned int INITIAL[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        memcpy(state, INITIAL, sizeof(state));
+        blockUsed = 0;
+        length = 0;
+    }
+
+    void update(const char* data, size_t size)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        length += size;
+        if (blockUsed > 0) {
+            size_t room = 64 - (size_t)blockUsed;
+            size_t take = room < size ? room : size;
+            memcpy(block + blockUsed, bytes, take);
+            blockUsed += (int)take;
+            bytes += take;
+            size -= take;
+            if (blockUsed < 64) return;
+            compress(block);
+            blockUsed = 0;
+        }
+        while (size >= 64) {
+            compress(bytes);
+            bytes += 64;
+            size -= 64;
+        }
+        memcpy(block, bytes, size);
+        blockUsed = (int)size;
+    }
+
+    // Digest as 64 lowercase hex digits; the object must be reset() before reuse
+    string finishHex()
+    {
+        unsigned long long bits = length * 8;
+        unsigned char padding[72];
+        int padLength = (blockUsed < 56) ? 56 - blockUsed : 120 - blockUsed;
+        memset(padding, 0, sizeof(padding));
+        padding[0] = 0x80;
+        for (int i = 0; i < 8; i++) padding[padLength + i] = (unsigned char)(bits >> (56 - 8 * i));
+        update((const char*)padding, padLength + 8);
+
+        static const char HEX[] = "0123456789abcdef";
+        string digest(64, '0');
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) digest[8 * i + j] = HEX[(state[i] >> (28 - 4 * j)) & 0xf];
+        }
+        return digest;
+    }
+
+    static string hashHex(const char* data, size_t size)
+    {
+        Sha256 hash;
+        hash.update(data, size);
+        return hash.finishHex();
+    }
+};
+
+
+// Chunks addressed by content hash. Each backup run appends its new chunks,
+// compressed with lzCompress(), to one pack archive:
+//   "IGSPACK1"                   magic
+//   chunk data                   back to back, compressed or stored
+//   hash|offset|stored|raw|lz    index, one line per chunk
+//   %016llx offset of the index, then "IGSPIDX\n"
+// A pack is listed in packs.txt only once it is complete and synced, and
+// open() reads just the indexes, so finding a chunk never scans data.
+// Loose chunk files (chunks/ab/cdef...) from older backups are still read.
+class ChunkStore
+{
+private:
+    struct PackedChunk
+    {
+        char hash[65];
+        int pack;
+        long long offset;
+        int storedSize;
+        int rawSize;
+        bool compressed;
+    };
+
+    string root;
+    Mutex mutex;
+
+    PackedChunk* entries;
+    int entryCount;
+    int entryCapacity;
+    int* slots;          // Open addressing on the hash, -1 when empty
+    int slotCount;
+
+    string* packNames;
+    FILE** packFiles;    // Opened for reading on first use
+    int packCount;
+    int packCapacity;
+
+    FILE* writing;       // Pack of the current backup run, see beginPack()
+    long long writeOffset;
+    long long packRawBytes;
+    long long packStoredBytes;
+    bool writeFailed;
+
+    ChunkStore(const ChunkStore&);
+    ChunkStore& operator=(const ChunkStore&);
+
+    int slotFor(const char* hash) const
+    {
+        unsigned int h = 0;
+        for (int i = 0; i < 8; i++) h = h * 16 + (unsigned int)(hash[i] <= '9' ? hash[i] - '0' : hash[i] - 'a' + 10);
+        int slot = (int)(h & (unsigned int)(slotCount - 1));
+        while (slots[slot] != -1 && memcmp(entries[slots[slot]].hash, hash, 64) != 0) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        return slot;
+    }
+
+    int find(const string& hash) const
+    {
+        if (hash.size() != 64) return -1;
+        return slots[slotFor(hash.c_str())];
+    }
+
+    void addEntry(const PackedChunk& chunk)
+    {
+        if (entryCount == entryCapacity) {
+            entryCapacity *= 2;
+            PackedChunk* bigger = new PackedChunk[entryCapacity];
+            memcpy(bigger, entries, entryCount * sizeof(PackedChunk));
+            delete[] entries;
+            entries = bigger;
+        }
+        if (entryCount * 2 >= slotCount) {
+            delete[] slots;
+            slotCount *= 2;
+            slots = new int[slotCount];
+            for (int i = 0; i < slotCount; i++) slots[i] = -1;
+            for (int i = 0; i < entryCount; i++) slots[slotFor(entries[i].hash)] = i;
+        }
+        entries[entryCount] = chunk;
+        slots[slotFor(chunk.hash)] = entryCount++;
+    }
+
+    int addPack(const string& name)
+    {
+        if (packCount == packCapacity) {
+            packCapacity *= 2;
+            string* biggerNames = new string[packCapacity];
+            FILE** biggerFiles = new FILE*[packCapacity];
+            for (int i = 0; i < packCount; i++) {
+                biggerNames[i] = packNames[i];
+                biggerFiles[i] = packFiles[i];
+            }
+            delete[] packNames;
+            delete[] packFiles;
+            packNames = biggerNames;
+            packFiles = biggerFiles;
+        }
+        packNames[packCount] = name;
+        packFiles[packCount] = NULL;
+        return packCount++;
+    }
+
+    string packPath(const string& name) const { return root + "/packs/" + name + ".pack"; }
+
+    // Reads a finished pack's index; a pack without a valid footer is skipped
+    void loadPackIndex(const string& name)
+    {
+        FILE* file = fopen(packPath(name).c_str(), "rb");
+        if (file == NULL) return;
+        char footer[25];
+        long long indexOffset = -1;
+        if (fseek(file, -24, SEEK_END) == 0 && fread(footer, 1, 24, file) == 24
+            && memcmp(footer + 16, "IGSPIDX\n", 8) == 0) {
+            footer[16] = '\0';
+            indexOffset = strtoll(footer, NULL, 16);
+        }
+        if (indexOffset < 8 || fseek(file, (long)indexOffset, SEEK_SET) != 0) {
+            fclose(file);
+            return;
+        }
+
+        int pack = addPack(name);
+        char line[160];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            PackedChunk chunk;
+            int compressed = 0;
+            if (sscanf(line, "%64[0-9a-f]|%lld|%d|%d|%d", chunk.hash, &chunk.offset, &chunk.storedSize,
+                       &chunk.rawSize, &compressed) != 5) break;
+            chunk.pack = pack;
+            chunk.compressed = compressed != 0;
+            if (find(chunk.hash) == -1) addEntry(chunk);
+        }
+        fclose(file);
+    }
+
+    string chunkPath(const string& hash) const
+    {
+        return root + "/chunks/" + hash.substr(0, 2) + "/" + hash.substr(2);
+    }
+
+public:
+    explicit ChunkStore(const string& directory)
+        : root(directory), entryCount(0), entryCapacity(1024), slotCount(4096), packCount(0), packCapacity(16),
+          writing(NULL), writeOffset(0), packRawBytes(0), packStoredBytes(0), writeFailed(false)
+    {
+        entries = new PackedChunk[entryCapacity];
+        slots = new int[slotCount];
+        for (int i = 0; i < slotCount; i++) slots[i] = -1;
+        packNames = new string[packCapacity];
+        packFiles = new FILE*[packCapacity];
+    }
+
+    ~ChunkStore()
+    {
+        if (writing != NULL) fclose(writing);
+        for (int i = 0; i < packCount; i++) {
+            if (packFiles[i] != NULL) fclose(packFiles[i]);
+        }
+        delete[] entries;
+        delete[] slots;
+        delete[] packNames;
+        delete[] packFiles;
+    }
+
+    // Creates the directories and loads the index of every listed pack
+    bool open()
+    {
+        if (!makeDirectory(root) || !makeDirectory(root + "/packs") || !makeDirectory(root + "/snapshots")) {
+            return false;
+        }
+        FILE* list = fopen((root + "/packs.txt").c_str(), "r");
+        if (list != NULL) {
+            char name[128];
+            while (fscanf(list, "%127s", name) == 1) loadPackIndex(name);
+            fclose(list);
+        }
+        return true;
+    }
+
+    const string& getRoot() const { return root; }
+
+    // True if a backup under this name left anything in directory: a
+    // manifest, a pack or a packs.txt entry. Such a name must not be reused,
+    // since reopening its pack would cut off chunks the index points into.
+    static bool isNameUsed(const string& directory, const string& name)
+    {
+        if (fileExists(directory + "/snapshots/" + name + ".manifest")) return true;
+        if (fileExists(directory + "/packs/" + name + ".pack")) return true;
+        FILE* list = fopen((directory + "/packs.txt").c_str(), "r");
+        if (list == NULL) return false;
+        bool listed = false;
+        char listedName[128];
+        while (!listed && fscanf(list, "%127s", listedName) == 1) listed = (name == listedName);
+        fclose(list);
+        return listed;
+    }
+
+    // Starts the pack that put() appends to; refuses a name that already
+    // has a pack rather than truncate it
+    bool beginPack(const string& name)
+    {
+        if (fileExists(packPath(name))) return false;
+        for (int i = 0; i < packCount; i++) {
+            if (packNames[i] == name) return false;
+        }
+        writing = fopen(packPath(name).c_str(), "wb");
+        if (writing == NULL) return false;
+        addPack(name);
+        writeOffset = 8;
+        packRawBytes = packStoredBytes = 0;
+        writeFailed = fwrite("IGSPACK1", 1, 8, writing) != 8;
+        return !writeFailed;
+    }
+
+    // Stores the chunk unless it is already there. Returns 1 when added,
+    // 0 when already stored, -1 on a write error. Safe to call from
+    // several threads; compression happens outside the lock.
+    int put(const string& hash, const char* data, int size)
+    {
+        {
+            ScopedLock guard(mutex);
+            if (find(hash) != -1 || fileExists(chunkPath(hash))) return 0;
+        }
+
+        char* packed = new char[lzCompressBound(size)];
+        int packedSize = lzCompress(data, size, packed);
+        bool compressed = packedSize < size;
+        const char* stored = compressed ? packed : data;
+        int storedSize = compressed ? packedSize : size;
+
+        ScopedLock guard(mutex);
+        int result = 0;
+        if (find(hash) == -1) {
+            result = -1;
+            if (writing != NULL && !writeFailed) {
+                if (fwrite(stored, 1, storedSize, writing) == (size_t)storedSize) {
+                    PackedChunk chunk;
+                    memcpy(chunk.hash, hash.c_str(), 65);
+                    chunk.pack = packCount - 1;
+                    chunk.offset = writeOffset;
+                    chunk.storedSize = storedSize;
+                    chunk.rawSize = size;
+                    chunk.compressed = compressed;
+                    addEntry(chunk);
+                    writeOffset += storedSize;
+                    packRawBytes += size;
+                    packStoredBytes += storedSize;
+                    result = 1;
+                } else {
+                    writeFailed = true;
+                }
+            }
+        }
+        delete[] packed;
+        return result;
+    }
+
+    // Writes the index and footer, syncs the pack and lists it in
+    // packs.txt. A pack that received no chunks is removed instead.
+    bool finishPack()
+    {
+        if (writing == NULL) return false;
+        int pack = packCount - 1;
+        string path = packPath(packNames[pack]);
+        bool ok = !writeFailed;
+        bool empty = (writeOffset == 8);
+
+        if (ok && !empty) {
+            for (int i = 0; i < entryCount && ok; i++) {
+                if (entries[i].pack != pack) continue;
+                ok = fprintf(writing, "%s|%lld|%d|%d|%d\n", entries[i].hash, entries[i].offset,
+                             entries[i].storedSize, entries[i].rawSize, entries[i].compressed ? 1 : 0) > 0;
+            }
+            ok = ok && fprintf(writing, "%016llxIGSPIDX\n", (unsigned long long)writeOffset) == 24;
+            ok = syncFile(writing) && ok;
+        }
+        ok = (fclose(writing) == 0) && ok;
+        writing = NULL;
+
+        if (empty) {
+            remove(path.c_str());
+            return ok;
+        }
+        return ok && appendDurably(root + "/packs.txt", packNames[pack] + "\n");
+    }
+
+    long long getPackRawBytes() const { return packRawBytes; }
+    long long getPackStoredBytes() const { return packStoredBytes; }
+
+    // Reads a chunk, expands it and checks it still matches its hash.
+    // Safe to call from several threads.
+    bool get(const string& hash, string& data)
+    {
+        data.clear();
+        int index;
+        {
+            ScopedLock guard(mutex);
+            index = find(hash);
+        }
+
+        if (index == -1) {
+            FILE* file = fopen(chunkPath(hash).c_str(), "rb");
+            if (file == NULL) return false;
+            char buffer[16384];
+            size_t got;
+            while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) data.append(buffer, got);
+            fclose(file);
+            return Sha256::hashHex(data.data(), data.size()) == hash;
+        }
+
+        PackedChunk chunk;
+        string stored;
+        {
+            ScopedLock guard(mutex);
+            chunk = entries[index];
+            FILE*& file = packFiles[chunk.pack];
+            if (file == NULL) file = fopen(packPath(packNames[chunk.pack]).c_str(), "rb");
+            if (file == NULL || fseek(file, (long)chunk.offset, SEEK_SET) != 0) return false;
+            stored.resize(chunk.storedSize);
+            if (chunk.storedSize > 0 && fread(&stored[0], 1, chunk.storedSize, file) != (size_t)chunk.storedSize) {
+                return false;
+            }
+        }
+
+        if (chunk.compressed) {
+            data.resize(chunk.rawSize);
+            if (chunk.rawSize > 0 && !lzDecompress(stored.data(), chunk.storedSize, &data[0], chunk.rawSize)) {
+                return false;
+            }
+        } else {
+            data.swap(stored);
+        }
+        return Sha256::hashHex(data.data(), data.size()) == hash;
+    }
+};
+
+
+// Stream buffer that cuts whatever is written to it into content-defined
+// chunks, stores the new ones and records the file's manifest section:
+//   file|<name>
+//   chunk|<sha256>|<bytes>      (one per chunk, in order)
+//   end|<bytes>|<sha256 of the whole file>
+// Boundaries use a gear rolling hash, so they depend only on nearby bytes.
+class ChunkingStreamBuf : public streambuf
+{
+private:
+    ChunkStore& store;
+    char* buffer;
+    int capacity;
+    int scanned;
+    unsigned long long gear;
+    unsigned long long table[256];
+
+    Sha256 fileHash;
+    string manifest;
+    long long totalBytes;
+    long long newBytes;
+    int chunkCount;
+    int newChunkCount;
+    bool failed;
+
+    ChunkingStreamBuf(const ChunkingStreamBuf&);
+    ChunkingStreamBuf& operator=(const ChunkingStreamBuf&);
+
+    void emit(const char* data, int size)
+    {
+        string hash = Sha256::hashHex(data, size);
+        int stored = store.put(hash, data, size);
+        if (stored < 0) failed = true;
+        if (stored > 0) {
+            newChunkCount++;
+            newBytes += size;
+        }
+        fileHash.update(data, size);
+        totalBytes += size;
+        chunkCount++;
+
+        char line[100];
+        sprintf(line, "chunk|%s|%d\n", hash.c_str(), size);
+        manifest += line;
+    }
+
+    // Cuts every complete chunk out of the buffer; with final, the rest too
+    void drain(bool final)
+    {
+        int length = (int)(pptr() - buffer);
+        int start = 0;
+        for (int i = start + scanned; i < length; i++) {
+            gear = (gear << 1) + table[(unsigned char)buffer[i]];
+            int size = i + 1 - start;
+            // The top bits mix the last 64 bytes; the low bits only the last few
+            if ((size >= CHUNK_MIN_SIZE && (gear >> (64 - CHUNK_BOUNDARY_BITS)) == 0) || size == CHUNK_MAX_SIZE) {
+                emit(buffer + start, size);
+                start = i + 1;
+                gear = 0;
+            }
+        }
+        scanned = length - start;
+        if (final && scanned > 0) {
+            emit(buffer + start, scanned);
+            start = length;
+            scanned = 0;
+            gear = 0;
+        }
+        memmove(buffer, buffer + start, length - start);
+        setp(buffer, buffer + capacity);
+        pbump(length - start);
+    }
+
+protected:
+    virtual int overflow(int c)
+    {
+        drain(false);
+        if (c != traits_type::eof()) {
+            *pptr() = (char)c;
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    // Flushes (endl) must not cut a chunk, or boundaries would follow lines
+    virtual int sync() { return 0; }
+
+public:
+    ChunkingStreamBuf(ChunkStore& chunkStore, const string& fileName)
+        : store(chunkStore), capacity(2 * CHUNK_MAX_SIZE), scanned(0), gear(0),
+          totalBytes(0), newBytes(0), chunkCount(0), newChunkCount(0), failed(false)
+    {
+        buffer = new char[capacity];
+        setp(buffer, buffer + capacity);
+
+        // Fixed pseudo-random gear values (splitmix64), so every run cuts
+        // the same data at the same places
+        unsigned long long seed = 0x49475342414b5550ULL;
+        for (int i = 0; i < 256; i++) {
+            unsigned long long z = (seed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            table[i] = z ^ (z >> 31);
+        }
+        manifest = "file|" + fileName + "\n";
+    }
+
+    ~ChunkingStreamBuf() { delete[] buffer; }
+
+    // Stores the last chunk and closes the manifest section
+    void finish()
+    {
+        drain(true);
+        char line[120];
+        sprintf(line, "end|%lld|", totalBytes);
+        manifest += line;
+        manifest += fileHash.finishHex();
+        manifest += "\n";
+    }
+
+    bool good() const { return !failed; }
+    const string& getManifest() const { return manifest; }
+    long long getTotalBytes() const { return totalBytes; }
+    long long getNewBytes() const { return newBytes; }
+    int getChunkCount() const { return chunkCount; }
+    int getNewChunkCount() const { return newChunkCount; }
+};
+
+#endif
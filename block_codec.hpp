@@ -0,0 +1,165 @@
+#ifndef BLOCK_CODEC_HPP
+#define BLOCK_CODEC_HPP
+
+// Fast block compression for Project_GR1.cpp backups, in the LZ4 block
+// layout. A block is a run of sequences:
+//   token          high nibble: literal count, low nibble: match length - 4
+//   [255 ...]      extra literal count bytes when the nibble is 15
+//   literals
+//   offset         2 bytes little-endian, 1..65535 back into the output
+//   [255 ...]      extra match length bytes when the nibble is 15
+// The last sequence has literals only. Matches are found with a single
+// hash table of recent 4-byte positions, which favours speed over ratio.
+
+#include <cstring>
+using namespace std;
+
+
+const int LZ_MIN_MATCH = 4;
+const int LZ_LAST_LITERALS = 5;      // The block always ends with this many literals
+const int LZ_MATCH_FIND_LIMIT = 12;  // No match starts this close to the end
+const int LZ_HASH_BITS = 12;
+const int LZ_MAX_OFFSET = 65535;
+
+
+// Largest compressed size of a size-byte block
+inline int lzCompressBound(int size)
+{
+    return size + size / 255 + 16;
+}
+
+
+inline unsigned int lzRead32(const unsigned char* p)
+{
+    unsigned int value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+
+inline unsigned char* lzWriteLength(unsigned char* out, int length)
+{
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = (unsigned char)length;
+    return out;
+}
+
+
+// Compresses size bytes into out, which needs lzCompressBound(size) bytes;
+// returns the compressed size
+inline int lzCompress(const char* data, int size, char* out)
+{
+    const unsigned char* src = (const unsigned char*)data;
+    unsigned char* dst = (unsigned char*)out;
+    int table[1 << LZ_HASH_BITS];
+    memset(table, 0xff, sizeof(table));  // -1: no position yet
+
+    int anchor = 0;
+    int ip = 0;
+    int matchLimit = size - LZ_MATCH_FIND_LIMIT;
+    int misses = 0;
+
+    while (ip < matchLimit) {
+        unsigned int sequence = lzRead32(src + ip);
+        unsigned int slot = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        int candidate = table[slot];
+        table[slot] = ip;
+
+        if (candidate < 0 || ip - candidate > LZ_MAX_OFFSET || lzRead32(src + candidate) != sequence) {
+            // Step further through data that keeps missing
+            ip += 1 + (misses++ >> 6);
+            continue;
+        }
+        misses = 0;
+
+        int length = LZ_MIN_MATCH;
+        while (ip + length < size - LZ_LAST_LITERALS && src[candidate + length] == src[ip + length]) length++;
+
+        int literals = ip - anchor;
+        unsigned char* token = dst++;
+        int matchCode = length - LZ_MIN_MATCH;
+        *token = (unsigned char)(((literals < 15 ? literals : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+        if (literals >= 15) dst = lzWriteLength(dst, literals - 15);
+        memcpy(dst, src + anchor, literals);
+        dst += literals;
+
+        int offset = ip - candidate;
+        *dst++ = (unsigned char)(offset & 0xff);
+        *dst++ = (unsigned char)(offset >> 8);
+        if (matchCode >= 15) dst = lzWriteLength(dst, matchCode - 15);
+
+        ip += length;
+        anchor = ip;
+        if (ip - 2 < matchLimit) {
+            table[(lzRead32(src + ip - 2) * 2654435761u) >> (32 - LZ_HASH_BITS)] = ip - 2;
+        }
+    }
+
+    int literals = size - anchor;
+    *dst++ = (unsigned char)((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15) dst = lzWriteLength(dst, literals - 15);
+    memcpy(dst, src + anchor, literals);
+    dst += literals;
+    return (int)(dst - (unsigned char*)out);
+}
+
+
+// Reads an extended length; false if the input ends first
+inline bool lzReadLength(const unsigned char* src, int size, int& ip, int& length)
+{
+    unsigned char byte;
+    do {
+        if (ip >= size) return false;
+        byte = src[ip++];
+        length += byte;
+        if (length > (1 << 30)) return false;
+    } while (byte == 255);
+    return true;
+}
+
+
+// Decompresses a block that must expand to exactly rawSize bytes. Every
+// length and offset is checked, so damaged input fails instead of
+// reading or writing out of bounds.
+inline bool lzDecompress(const char* data, int size, char* out, int rawSize)
+{
+    const unsigned char* src = (const unsigned char*)data;
+    unsigned char* dst = (unsigned char*)out;
+    int ip = 0;
+    int op = 0;
+
+    while (ip < size) {
+        int token = src[ip++];
+        int literals = token >> 4;
+        if (literals == 15 && !lzReadLength(src, size, ip, literals)) return false;
+        if (literals > size - ip || literals > rawSize - op) return false;
+        memcpy(dst + op, src + ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == size) return op == rawSize;
+
+        if (size - ip < 2) return false;
+        int offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return false;
+
+        int length = token & 15;
+        if (length == 15 && !lzReadLength(src, size, ip, length)) return false;
+        length += LZ_MIN_MATCH;
+        if (length > rawSize - op) return false;
+
+        const unsigned char* match = dst + op - offset;
+        if (offset >= length) {
+            memcpy(dst + op, match, length);
+        } else {
+            for (int i = 0; i < length; i++) dst[op + i] = match[i];  // Overlapping copy repeats the pattern
+        }
+        op += length;
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,480 @@
+#ifndef FILE_UTILS_HPP
+#define FILE_UTILS_HPP
+
+// Durable file helpers and buffered output for Project_GR1.cpp
+
+#include <cstdio>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "thread_utils.hpp"
+#include "tracing.hpp"
+using namespace std;
+
+
+// Flushes the stdio buffer and asks the OS to put the file on disk
+inline bool syncFile(FILE* file)
+{
+    if (fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+
+// Appends text with a single write and syncs it before returning
+inline bool appendDurably(const string& filename, const string& text)
+{
+    FILE* file = fopen(filename.c_str(), "ab");
+    if (file == NULL) return false;
+
+    bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = syncFile(file) && ok;
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+
+// True if the file is missing, empty or ends with a newline, i.e. the next
+// appended line starts a record of its own
+inline bool endsWithNewline(const string& filename)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL) return true;
+    bool ok = true;
+    if (fseek(file, -1, SEEK_END) == 0) ok = fgetc(file) == '\n';
+    fclose(file);
+    return ok;
+}
+
+
+// Asks the OS to put a directory's entries on disk, so a file created or
+// renamed in it is still there after a crash
+inline bool syncDirectory(const string& directory)
+{
+#ifdef _WIN32
+    (void)directory;
+    return true;  // No directory handles to sync; NTFS journals renames itself
+#else
+    int handle = open(directory.c_str(), O_RDONLY);
+    if (handle < 0) return false;
+    bool ok = fsync(handle) == 0;
+    ok = (close(handle) == 0) && ok;
+    return ok;
+#endif
+}
+
+
+inline string parentDirectory(const string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    if (slash == string::npos) return ".";
+    return (slash == 0) ? path.substr(0, 1) : path.substr(0, slash);
+}
+
+
+// Renames from over to, replacing to if it exists
+inline bool replaceFile(const string& from, const string& to)
+{
+#ifdef _WIN32
+    remove(to.c_str());  // rename() does not replace there
+#endif
+    return rename(from.c_str(), to.c_str()) == 0;
+}
+
+
+// Crash-safe whole-file saves. Each file is written to <name>.tmp in one
+// write and synced; only then is it renamed over the original and the
+// directory synced, so after a crash the file holds either the old or the
+// new contents, never part of either.
+//
+// Saves made between begin() and commit() form a group: nothing is renamed
+// until every file in it has been written, and the group shares one
+// directory sync per directory instead of one per file. Saves must not
+// overlap from several threads.
+class DurableSaver
+{
+private:
+    static const int MAX_GROUP_FILES = 16;
+
+    string temporary[MAX_GROUP_FILES];
+    string target[MAX_GROUP_FILES];
+    int stagedCount;
+    bool grouping;
+    bool failed;
+    double groupStart;
+
+    // Figures for the last save or group, and running totals
+    int lastFiles;
+    long lastBytes;
+    int lastSyncs;
+    double lastSeconds;
+    long operations;
+    long totalSyncs;
+    double totalSeconds;
+
+    DurableSaver(const DurableSaver&);
+    DurableSaver& operator=(const DurableSaver&);
+
+    void startOperation()
+    {
+        if (grouping) return;
+        groupStart = getWallClockSeconds();
+        lastFiles = 0;
+        lastBytes = 0;
+        lastSyncs = 0;
+        failed = false;
+    }
+
+    bool stage(const string& temporaryName, const string& filename)
+    {
+        if (stagedCount == MAX_GROUP_FILES) {
+            remove(temporaryName.c_str());
+            return false;
+        }
+        temporary[stagedCount] = temporaryName;
+        target[stagedCount] = filename;
+        stagedCount++;
+        lastFiles++;
+        return true;
+    }
+
+    void discard()
+    {
+        for (int i = 0; i < stagedCount; i++) remove(temporary[i].c_str());
+        stagedCount = 0;
+    }
+
+    // Renames every staged file into place and syncs each directory once
+    bool finish()
+    {
+        bool ok = !failed;
+        if (!ok) discard();
+        for (int i = 0; i < stagedCount && ok; i++) {
+            if (!replaceFile(temporary[i], target[i])) {
+                for (int j = i; j < stagedCount; j++) remove(temporary[j].c_str());
+                ok = false;
+            }
+        }
+        for (int i = 0; i < stagedCount && ok; i++) {
+            string directory = parentDirectory(target[i]);
+            bool seen = false;
+            for (int j = 0; j < i && !seen; j++) seen = (parentDirectory(target[j]) == directory);
+            if (seen) continue;
+            ok = syncDirectory(directory);
+            lastSyncs++;
+        }
+        stagedCount = 0;
+        failed = false;
+
+        lastSeconds = getWallClockSeconds() - groupStart;
+        operations++;
+        totalSyncs += lastSyncs;
+        totalSeconds += lastSeconds;
+        return ok;
+    }
+
+public:
+    DurableSaver()
+        : stagedCount(0), grouping(false), failed(false), groupStart(0.0), lastFiles(0), lastBytes(0),
+          lastSyncs(0), lastSeconds(0.0), operations(0), totalSyncs(0), totalSeconds(0.0) {}
+
+    ~DurableSaver() { discard(); }
+
+    void begin()
+    {
+        discard();
+        grouping = false;
+        startOperation();
+        grouping = true;
+    }
+
+    // Replaces the staged files; false, with none of them replaced, if
+    // any save in the group failed
+    bool commit()
+    {
+        TRACE_SCOPE("io", "DurableSaver::commit");
+        grouping = false;
+        return finish();
+    }
+
+    // Drops the group without touching the original files
+    void abort()
+    {
+        grouping = false;
+        discard();
+    }
+
+    // Writes contents as the new filename; inside a group the file is only
+    // replaced at commit()
+    bool save(const string& filename, const string& contents)
+    {
+        TRACE_SCOPE("io", "DurableSaver::save");
+        startOperation();
+        string temporaryName = filename + ".tmp";
+        FILE* file = fopen(temporaryName.c_str(), "wb");
+        bool ok = file != NULL;
+        if (ok) {
+            ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+            ok = syncFile(file) && ok;
+            ok = (fclose(file) == 0) && ok;
+            lastSyncs++;
+            lastBytes += (long)contents.size();
+            if (!ok) remove(temporaryName.c_str());
+        }
+        ok = ok && stage(temporaryName, filename);
+        if (!ok) failed = true;
+        return grouping ? ok : finish() && ok;
+    }
+
+    // Takes over a temporary file the caller has already written and synced
+    bool adopt(const string& temporaryName, const string& filename)
+    {
+        startOperation();
+        bool ok = stage(temporaryName, filename);
+        if (!ok) failed = true;
+        return grouping ? ok : finish() && ok;
+    }
+
+    int getLastFiles() const { return lastFiles; }
+    long getLastBytes() const { return lastBytes; }
+    int getLastSyncs() const { return lastSyncs; }
+    double getLastSeconds() const { return lastSeconds; }
+    long getOperations() const { return operations; }
+    long getTotalSyncs() const { return totalSyncs; }
+    double getTotalSeconds() const { return totalSeconds; }
+
+    // "12.4 ms, 3 fsyncs" for the last save or group
+    string describeLast() const
+    {
+        ostringstream text;
+        text << fixed << setprecision(1) << lastSeconds * 1000 << " ms, " << lastSyncs
+             << (lastSyncs == 1 ? " fsync" : " fsyncs");
+        return text.str();
+    }
+};
+
+
+// Collects formatted text in one reusable block and hands it to the
+// stream in large writes; numbers are formatted without iostream state
+class OutputBuffer
+{
+private:
+    ostream& out;
+    char* data;
+    int capacity;
+    int used;
+    long flushed;
+
+    OutputBuffer(const OutputBuffer&);
+    OutputBuffer& operator=(const OutputBuffer&);
+
+    void reserve(int length)
+    {
+        if (used + length > capacity) flush();
+    }
+
+    static void splitDouble(double value, double& high, double& low)
+    {
+        double scaled = 134217729.0 * value;  // 2^27 + 1
+        high = scaled - (scaled - value);
+        low = value - high;
+    }
+
+public:
+    static const int DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit OutputBuffer(ostream& stream, int size = DEFAULT_CAPACITY)
+        : out(stream), data(new char[size]), capacity(size), used(0), flushed(0) {}
+
+    ~OutputBuffer()
+    {
+        flush();
+        delete[] data;
+    }
+
+    void flush()
+    {
+        if (used == 0) return;
+        TRACE_SCOPE("io", "OutputBuffer::flush");
+        out.write(data, used);
+        flushed += used;
+        used = 0;
+    }
+
+    bool good() const { return out.good(); }
+
+    // Characters written so far, flushed or not
+    long getPosition() const { return flushed + used; }
+
+    OutputBuffer& put(char c)
+    {
+        reserve(1);
+        data[used++] = c;
+        return *this;
+    }
+
+    OutputBuffer& put(const char* text, int length)
+    {
+        if (length > capacity) {
+            flush();
+            out.write(text, length);
+            flushed += length;
+            return *this;
+        }
+        reserve(length);
+        memcpy(data + used, text, length);
+        used += length;
+        return *this;
+    }
+
+    OutputBuffer& put(const char* text) { return put(text, (int)strlen(text)); }
+    OutputBuffer& put(const string& text) { return put(text.data(), (int)text.size()); }
+
+    OutputBuffer& repeat(char c, int count)
+    {
+        if (count <= 0) return *this;
+        if (count > capacity) {
+            for (int i = 0; i < count; i++) put(c);
+            return *this;
+        }
+        reserve(count);
+        memset(data + used, c, count);
+        used += count;
+        return *this;
+    }
+
+    // Pads text with spaces to width, like setw with left alignment
+    OutputBuffer& padded(const string& text, int width)
+    {
+        put(text);
+        return repeat(' ', width - (int)text.size());
+    }
+
+    // Pads what was written since position start to width, for numbers:
+    //   long start = out.getPosition(); out.putFixed(cgpa, 2).padFrom(start, 6);
+    OutputBuffer& padFrom(long start, int width)
+    {
+        return repeat(' ', width - (int)(getPosition() - start));
+    }
+
+    OutputBuffer& paddedInt(long value, int width)
+    {
+        long start = getPosition();
+        return putInt(value).padFrom(start, width);
+    }
+
+    OutputBuffer& paddedFixed(double value, int decimals, int width)
+    {
+        long start = getPosition();
+        return putFixed(value, decimals).padFrom(start, width);
+    }
+
+    OutputBuffer& putInt(long value)
+    {
+        char digits[24];
+        int length = 0;
+        unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+        do {
+            digits[length++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0) digits[length++] = '-';
+
+        reserve(length);
+        while (length > 0) data[used++] = digits[--length];
+        return *this;
+    }
+
+    // Same digits as fixed << setprecision(decimals), ties go to even.
+    // The fast path needs value * scale below 2^53, where a double still
+    // holds the fraction that decides the rounding, and within an unsigned
+    // long; larger values go through the stream.
+    OutputBuffer& putFixed(double value, int decimals)
+    {
+        unsigned long scale = 1;
+        for (int i = 0; i < decimals && i < 9; i++) scale *= 10;
+
+        double scaledSize = fabs(value) * scale;
+        if (value != value || decimals > 9 || !(scaledSize < 9007199254740992.0) || scaledSize >= (double)ULONG_MAX) {
+            ostringstream text;
+            text << fixed << setprecision(decimals) << value;
+            return put(text.str());
+        }
+
+        if (value < 0 || (value == 0 && 1 / value < 0)) {
+            put('-');
+            value = -value;
+        }
+        // value * scale is not exact in a double, so keep the rounding error
+        // (Dekker's product) and round on the exact value as printf does
+        double scaled = value * scale;
+        double valueHigh, valueLow, scaleHigh, scaleLow;
+        splitDouble(value, valueHigh, valueLow);
+        splitDouble((double)scale, scaleHigh, scaleLow);
+        double error = ((valueHigh * scaleHigh - scaled) + valueHigh * scaleLow + valueLow * scaleHigh)
+                       + valueLow * scaleLow;
+
+        double whole = floor(scaled);
+        double aboveHalf = (scaled - whole - 0.5) + error;
+        if (aboveHalf > 0 || (aboveHalf == 0 && fmod(whole, 2.0) != 0)) whole += 1;
+
+        unsigned long units = (unsigned long)whole;
+        putInt((long)(units / scale));
+        if (decimals > 0) {
+            char digits[10];
+            unsigned long rest = units % scale;
+            for (int i = decimals - 1; i >= 0; i--) {
+                digits[i] = (char)('0' + rest % 10);
+                rest /= 10;
+            }
+            put('.');
+            put(digits, decimals);
+        }
+        return *this;
+    }
+};
+
+// Stream buffer that accepts everything and keeps nothing
+class DiscardBuffer : public streambuf
+{
+protected:
+    int overflow(int c) { return traits_type::not_eof(c); }
+    streamsize xsputn(const char* text, streamsize length) { (void)text; return length; }
+};
+
+
+// Sends a stream's output nowhere while in scope, e.g. the console while
+// menu functions are timed; does nothing unless active
+class StreamSilencer
+{
+private:
+    ostream& stream;
+    DiscardBuffer discard;
+    streambuf* saved;
+
+    StreamSilencer(const StreamSilencer&);
+    StreamSilencer& operator=(const StreamSilencer&);
+
+public:
+    explicit StreamSilencer(ostream& target, bool active = true)
+        : stream(target), saved(active ? target.rdbuf(&discard) : NULL) {}
+
+    ~StreamSilencer()
+    {
+        if (saved != NULL) stream.rdbuf(saved);
+    }
+};
+
+#endif
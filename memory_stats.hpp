@@ -0,0 +1,135 @@
+#ifndef MEMORY_STATS_HPP
+#define MEMORY_STATS_HPP
+
+// Memory measurement for Project_GR1.cpp: heap bytes of objects and strings
+// as the allocator hands them out, the allocator's own totals, and the
+// process's resident memory from /proc/self/status (Linux).
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+using namespace std;
+
+
+// Heap a request of size bytes really takes: ptmalloc (glibc, MinGW's
+// msvcrt is close) adds one word of header and rounds up to two words,
+// with a minimum of four words per block
+inline long heapBlockBytes(size_t size)
+{
+    const size_t word = sizeof(size_t);
+    size_t block = (size + word + 2 * word - 1) & ~(2 * word - 1);
+    return (long)(block < 4 * word ? 4 * word : block);
+}
+
+
+// Heap behind a string's text; short strings kept inside the object
+// (small-string optimisation) take none
+inline long stringHeapBytes(const string& value)
+{
+    const char* object = (const char*)&value;
+    const char* text = value.data();
+    if (text >= object && text < object + sizeof(value)) return 0;
+    if (value.capacity() == 0) return 0;  // Shared empty representation
+#if defined(__GLIBCXX__) && !_GLIBCXX_USE_CXX11_ABI
+    // Reference-counted strings keep length, capacity and count before the text
+    return heapBlockBytes(value.capacity() + 1 + 3 * sizeof(size_t));
+#else
+    return heapBlockBytes(value.capacity() + 1);
+#endif
+}
+
+
+// Totals from the C allocator; available is false where they cannot be read
+struct AllocatorStats
+{
+    bool available;
+    long arenaBytes;    // Heap obtained with brk/sbrk
+    long mappedBytes;   // Large blocks obtained with mmap
+    long inUseBytes;    // Handed out and not freed
+    long freeBytes;     // Held by the allocator but free
+
+    AllocatorStats() : available(false), arenaBytes(0), mappedBytes(0), inUseBytes(0), freeBytes(0) {}
+
+    // Share of the arena that is free but not returned to the system
+    double fragmentation() const { return arenaBytes > 0 ? (double)freeBytes / arenaBytes : 0.0; }
+};
+
+
+inline AllocatorStats readAllocatorStats()
+{
+    AllocatorStats stats;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    stats.available = true;
+    stats.arenaBytes = (long)info.arena;
+    stats.mappedBytes = (long)info.hblkhd;
+    stats.inUseBytes = (long)info.uordblks + (long)info.hblkhd;
+    stats.freeBytes = (long)info.fordblks;
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();  // int fields: wrong past 2GB of heap
+    stats.available = true;
+    stats.arenaBytes = (unsigned int)info.arena;
+    stats.mappedBytes = (unsigned int)info.hblkhd;
+    stats.inUseBytes = (long)(unsigned int)info.uordblks + (unsigned int)info.hblkhd;
+    stats.freeBytes = (unsigned int)info.fordblks;
+#endif
+    return stats;
+}
+
+
+// Memory of the whole process as the kernel sees it
+struct ProcessMemory
+{
+    bool available;
+    long residentBytes;      // VmRSS
+    long peakResidentBytes;  // VmHWM
+    long virtualBytes;       // VmSize
+    long anonymousBytes;     // RssAnon: heap and stacks, not mapped files
+    long systemBytes;        // MemTotal of the machine
+
+    ProcessMemory() : available(false), residentBytes(0), peakResidentBytes(0), virtualBytes(0),
+                      anonymousBytes(0), systemBytes(0) {}
+};
+
+
+// Value of a "Name:   1234 kB" line, in bytes
+inline bool readKilobyteField(const char* line, const char* name, long& bytes)
+{
+    size_t length = strlen(name);
+    if (strncmp(line, name, length) != 0 || line[length] != ':') return false;
+    long kilobytes = 0;
+    if (sscanf(line + length + 1, "%ld", &kilobytes) != 1) return false;
+    bytes = kilobytes * 1024;
+    return true;
+}
+
+
+inline ProcessMemory readProcessMemory()
+{
+    ProcessMemory memory;
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status == NULL) return memory;
+
+    char line[256];
+    while (fgets(line, sizeof(line), status) != NULL) {
+        if (readKilobyteField(line, "VmRSS", memory.residentBytes)) memory.available = true;
+        readKilobyteField(line, "VmHWM", memory.peakResidentBytes);
+        readKilobyteField(line, "VmSize", memory.virtualBytes);
+        readKilobyteField(line, "RssAnon", memory.anonymousBytes);
+    }
+    fclose(status);
+
+    FILE* info = fopen("/proc/meminfo", "r");
+    if (info != NULL) {
+        while (fgets(line, sizeof(line), info) != NULL) {
+            if (readKilobyteField(line, "MemTotal", memory.systemBytes)) break;
+        }
+        fclose(info);
+    }
+    return memory;
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+// Operation counters and latency histograms for Project_GR1.cpp.
+// Every thread records into a shard of its own with plain stores, so
+// recording takes no lock and no atomic instruction; readers add the
+// shards up. Latencies go into log-linear buckets in the style of
+// HdrHistogram: 16 buckets per power of two, so any quantile is within
+// 1/16 of the true value from a nanosecond to several hours.
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include "thread_utils.hpp"
+#include "file_utils.hpp"
+using namespace std;
+
+
+enum MetricKind { METRIC_COUNTER, METRIC_TIMER };
+
+struct MetricDefinition
+{
+    const char* name;   // Prometheus name without the "igs_" prefix
+    const char* help;
+    MetricKind kind;
+};
+
+const int MAX_METRICS = 32;
+const int MAX_METRIC_SHARDS = 128;      // Threads past this share one locked shard
+const int LATENCY_SUB_BUCKETS = 16;     // Buckets per power of two
+const int LATENCY_MAX_SHIFT = 40;       // Longest latency kept exactly: 2^45 ns, about 9.7 hours
+const int LATENCY_BUCKETS = LATENCY_MAX_SHIFT * LATENCY_SUB_BUCKETS + 2 * LATENCY_SUB_BUCKETS;
+
+
+// Bucket of a latency: values below 32 ns have one bucket each, larger
+// values keep their top five bits
+inline int latencyBucket(long long nanoseconds)
+{
+    if (nanoseconds < 2 * LATENCY_SUB_BUCKETS) return nanoseconds < 0 ? 0 : (int)nanoseconds;
+    int highestBit = 63 - __builtin_clzll((unsigned long long)nanoseconds);
+    int shift = highestBit - 4;
+    if (shift > LATENCY_MAX_SHIFT) return LATENCY_BUCKETS - 1;
+    return shift * LATENCY_SUB_BUCKETS + (int)(nanoseconds >> shift);
+}
+
+// Largest latency that falls in a bucket
+inline long long latencyBucketValue(int bucket)
+{
+    if (bucket < 2 * LATENCY_SUB_BUCKETS) return bucket;
+    int shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    long long sub = bucket - shift * LATENCY_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+
+// One thread's figures. Only the owning thread writes; a reader may see
+// a sample half recorded, which only matters for the sample in flight.
+struct MetricShard
+{
+    volatile long counts[MAX_METRICS];           // Events, or samples of a timer
+    volatile long long totalNanoseconds[MAX_METRICS];
+    volatile long long maxNanoseconds[MAX_METRICS];
+    volatile long buckets[MAX_METRICS][LATENCY_BUCKETS];
+
+    MetricShard()
+    {
+        for (int m = 0; m < MAX_METRICS; m++) {
+            counts[m] = 0;
+            totalNanoseconds[m] = 0;
+            maxNanoseconds[m] = 0;
+            for (int b = 0; b < LATENCY_BUCKETS; b++) buckets[m][b] = 0;
+        }
+    }
+};
+
+
+// All shards of one metric added up
+struct MetricSummary
+{
+    long count;
+    long long totalNanoseconds;
+    long long maxNanoseconds;
+    long buckets[LATENCY_BUCKETS];
+
+    MetricSummary() : count(0), totalNanoseconds(0), maxNanoseconds(0)
+    {
+        for (int b = 0; b < LATENCY_BUCKETS; b++) buckets[b] = 0;
+    }
+
+    // Latency at or below which the fraction q of samples fall
+    long long quantile(double q) const
+    {
+        long samples = 0;
+        for (int b = 0; b < LATENCY_BUCKETS; b++) samples += buckets[b];
+        if (samples == 0) return 0;
+        long rank = (long)(q * samples + 0.999999);
+        if (rank < 1) rank = 1;
+        long seen = 0;
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            seen += buckets[b];
+            if (seen >= rank) {
+                long long value = latencyBucketValue(b);
+                return value < maxNanoseconds ? value : maxNanoseconds;
+            }
+        }
+        return maxNanoseconds;
+    }
+
+    double meanNanoseconds() const { return count > 0 ? (double)totalNanoseconds / count : 0.0; }
+};
+
+
+class MetricsRegistry
+{
+private:
+    const MetricDefinition* definitions;
+    int metricCount;
+    ThreadLocalPointer threadShard;
+    MetricShard* volatile shards[MAX_METRIC_SHARDS];
+    volatile long shardCount;
+    Mutex registerMutex;
+    MetricShard overflow;        // Shared by threads past MAX_METRIC_SHARDS
+    Mutex overflowMutex;
+
+    MetricShard* shard()
+    {
+        MetricShard* mine = (MetricShard*)threadShard.get();
+        if (mine != NULL) return mine;
+
+        ScopedLock guard(registerMutex);
+        long used = relaxedLoad(&shardCount);
+        if (used < MAX_METRIC_SHARDS) {
+            mine = new MetricShard();
+            shards[used] = mine;
+            atomicIncrement(&shardCount);
+        } else {
+            mine = &overflow;
+        }
+        threadShard.set(mine);
+        return mine;
+    }
+
+    static void add(MetricShard* target, int metric, long long nanoseconds)
+    {
+        relaxedStore(&target->counts[metric], target->counts[metric] + 1);
+        relaxedStore(&target->totalNanoseconds[metric], target->totalNanoseconds[metric] + nanoseconds);
+        if (nanoseconds > target->maxNanoseconds[metric]) relaxedStore(&target->maxNanoseconds[metric], nanoseconds);
+        int bucket = latencyBucket(nanoseconds);
+        relaxedStore(&target->buckets[metric][bucket], target->buckets[metric][bucket] + 1);
+    }
+
+    MetricsRegistry(const MetricsRegistry&);
+    MetricsRegistry& operator=(const MetricsRegistry&);
+
+public:
+    MetricsRegistry(const MetricDefinition* list, int count)
+        : definitions(list), metricCount(count < MAX_METRICS ? count : MAX_METRICS), shardCount(0)
+    {
+        for (int i = 0; i < MAX_METRIC_SHARDS; i++) shards[i] = NULL;
+    }
+
+    ~MetricsRegistry()
+    {
+        for (int i = 0; i < shardCount; i++) delete shards[i];
+    }
+
+    void increment(int metric, long by = 1)
+    {
+        MetricShard* mine = shard();
+        if (mine == &overflow) {
+            ScopedLock guard(overflowMutex);
+            relaxedStore(&overflow.counts[metric], overflow.counts[metric] + by);
+            return;
+        }
+        relaxedStore(&mine->counts[metric], mine->counts[metric] + by);
+    }
+
+    void record(int metric, long long nanoseconds)
+    {
+        MetricShard* mine = shard();
+        if (mine == &overflow) {
+            ScopedLock guard(overflowMutex);
+            add(&overflow, metric, nanoseconds);
+            return;
+        }
+        add(mine, metric, nanoseconds);
+    }
+
+    void summarize(int metric, MetricSummary& summary)
+    {
+        int shardTotal = (int)atomicLoad(&shardCount);
+        for (int i = 0; i <= shardTotal; i++) {
+            MetricShard* source = (i < shardTotal) ? shards[i] : &overflow;
+            summary.count += relaxedLoad(&source->counts[metric]);
+            summary.totalNanoseconds += relaxedLoad(&source->totalNanoseconds[metric]);
+            long long longest = relaxedLoad(&source->maxNanoseconds[metric]);
+            if (longest > summary.maxNanoseconds) summary.maxNanoseconds = longest;
+            if (definitions[metric].kind == METRIC_TIMER) {
+                for (int b = 0; b < LATENCY_BUCKETS; b++) summary.buckets[b] += relaxedLoad(&source->buckets[metric][b]);
+            }
+        }
+    }
+
+    int getMetricCount() const { return metricCount; }
+    const MetricDefinition& getDefinition(int metric) const { return definitions[metric]; }
+
+    // Prometheus text exposition: timers as summaries in seconds with
+    // the 0.5, 0.99 and 0.999 quantiles, counters as *_total
+    void writePrometheus(ostream& out)
+    {
+        static const double QUANTILES[3] = { 0.5, 0.99, 0.999 };
+        static const char* const QUANTILE_LABELS[3] = { "0.5", "0.99", "0.999" };
+        for (int m = 0; m < metricCount; m++) {
+            MetricSummary summary;
+            summarize(m, summary);
+            string name = string("igs_") + definitions[m].name;
+            if (definitions[m].kind == METRIC_COUNTER) {
+                out << "# HELP " << name << "_total " << definitions[m].help << "\n";
+                out << "# TYPE " << name << "_total counter\n";
+                out << name << "_total " << summary.count << "\n";
+                continue;
+            }
+            name += "_seconds";
+            out << "# HELP " << name << " " << definitions[m].help << "\n";
+            out << "# TYPE " << name << " summary\n";
+            out << setprecision(9) << fixed;
+            for (int q = 0; q < 3; q++) {
+                out << name << "{quantile=\"" << QUANTILE_LABELS[q] << "\"} "
+                    << summary.quantile(QUANTILES[q]) / 1e9 << "\n";
+            }
+            out << name << "_sum " << summary.totalNanoseconds / 1e9 << "\n";
+            out << name << "_count " << summary.count << "\n";
+        }
+    }
+
+    // Replaces path in one rename so a scraper never reads half a file
+    bool exportTo(const string& path)
+    {
+        string temporary = path + ".tmp";
+        {
+            ofstream file(temporary.c_str(), ios::out | ios::trunc);
+            if (!file.is_open()) return false;
+            writePrometheus(file);
+            if (!file.good()) return false;
+        }
+        return replaceFile(temporary, path);
+    }
+};
+
+
+// Records the time from construction to destruction under one metric
+class MetricTimer
+{
+private:
+    MetricsRegistry& registry;
+    int metric;
+    long long start;
+
+    MetricTimer(const MetricTimer&);
+    MetricTimer& operator=(const MetricTimer&);
+
+public:
+    MetricTimer(MetricsRegistry& r, int m) : registry(r), metric(m), start(getMonotonicNanoseconds()) {}
+    ~MetricTimer() { registry.record(metric, getMonotonicNanoseconds() - start); }
+};
+
+
+// Rewrites a Prometheus text file every few seconds on a thread of its
+// own, and once more when stopped
+class MetricsExporter
+{
+private:
+    MetricsRegistry& registry;
+    string path;
+    long intervalMilliseconds;
+    bool stopping;
+    Mutex mutex;
+    ConditionVariable wake;
+    WorkerThread thread;
+
+    static void run(void* argument)
+    {
+        MetricsExporter* self = (MetricsExporter*)argument;
+        ScopedLock guard(self->mutex);
+        while (!self->stopping) {
+            self->wake.waitFor(self->mutex, self->intervalMilliseconds);
+            if (self->stopping) break;
+            self->mutex.unlock();
+            self->registry.exportTo(self->path);
+            self->mutex.lock();
+        }
+    }
+
+    MetricsExporter(const MetricsExporter&);
+    MetricsExporter& operator=(const MetricsExporter&);
+
+public:
+    MetricsExporter(MetricsRegistry& r) : registry(r), intervalMilliseconds(0), stopping(false) {}
+    ~MetricsExporter() { stop(); }
+
+    bool start(const string& file, int seconds)
+    {
+        path = file;
+        intervalMilliseconds = (seconds > 0 ? seconds : 1) * 1000L;
+        stopping = false;
+        if (!registry.exportTo(path)) return false;
+        return thread.start(run, this);
+    }
+
+    void stop()
+    {
+        if (path.empty()) return;
+        {
+            ScopedLock guard(mutex);
+            stopping = true;
+            wake.signal();
+        }
+        thread.join();
+        registry.exportTo(path);
+        path = "";
+    }
+};
+
+#endif
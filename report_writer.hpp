@@ -0,0 +1,552 @@
+#ifndef REPORT_WRITER_HPP
+#define REPORT_WRITER_HPP
+
+// Report output formats for Project_GR1.cpp. A report describes its data as
+// tables of typed columns and streams the rows into a ReportWriter, which
+// renders them as text, CSV, JSON lines or a columnar binary file. Rows are
+// written as they arrive, so exports of any size use a fixed amount of memory.
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include "file_utils.hpp"
+using namespace std;
+
+
+enum ReportFormat { REPORT_TEXT, REPORT_CSV, REPORT_JSONL, REPORT_COLUMNAR };
+
+enum ColumnType { COLUMN_TEXT, COLUMN_INTEGER, COLUMN_DECIMAL };
+
+// RECORD tables hold one row shown as "Label: value" lines in the text
+// format; ROWS tables are shown as an aligned grid
+enum TableLayout { TABLE_RECORD, TABLE_ROWS };
+
+const int REPORT_DECIMALS = 2;          // Digits after the point for decimal columns
+const int COLUMNAR_BLOCK_ROWS = 65536;  // Rows buffered per columnar block
+
+
+struct ReportColumn
+{
+    const char* name;   // CSV header, JSON key and columnar schema name
+    const char* label;  // Heading in the text format
+    ColumnType type;
+    int width;          // Text format column width in ROWS tables
+};
+
+struct ReportTable
+{
+    const char* name;
+    const char* title;
+    const ReportColumn* columns;
+    int columnCount;
+    TableLayout layout;
+};
+
+
+inline const char* reportFormatName(ReportFormat format)
+{
+    switch (format) {
+        case REPORT_CSV: return "CSV";
+        case REPORT_JSONL: return "JSON lines";
+        case REPORT_COLUMNAR: return "columnar";
+        default: return "text";
+    }
+}
+
+
+// Format named "text", "csv", "jsonl" or "columnar"
+inline bool parseReportFormat(const string& name, ReportFormat& format)
+{
+    if (name == "text") format = REPORT_TEXT;
+    else if (name == "csv") format = REPORT_CSV;
+    else if (name == "jsonl") format = REPORT_JSONL;
+    else if (name == "columnar") format = REPORT_COLUMNAR;
+    else return false;
+    return true;
+}
+
+
+// Base writer: owns the output file and its buffer. Values of a row are
+// passed in column order between beginTable() and endTable().
+class ReportWriter
+{
+protected:
+    string basePath;
+    ofstream file;
+    OutputBuffer out;
+    const ReportTable* table;
+    int column;
+    bool failed;
+    string files;
+
+    bool openFile(const string& path)
+    {
+        closeFile();
+        file.clear();
+        file.open(path.c_str(), ios::out | ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            failed = true;
+            return false;
+        }
+        files += (files.empty() ? "" : ", ") + path;
+        return true;
+    }
+
+    void closeFile()
+    {
+        out.flush();
+        if (!out.good()) failed = true;
+        if (file.is_open()) file.close();
+    }
+
+    const ReportColumn& currentColumn() const { return table->columns[column]; }
+
+private:
+    ReportWriter(const ReportWriter&);
+    ReportWriter& operator=(const ReportWriter&);
+
+public:
+    explicit ReportWriter(const string& base)
+        : basePath(base), out(file), table(NULL), column(0), failed(false) {}
+
+    // Writes to a stream the caller owns, such as cout, instead of a file
+    explicit ReportWriter(ostream& stream)
+        : out(stream), table(NULL), column(0), failed(false) {}
+
+    virtual ~ReportWriter() { closeFile(); }
+
+    // Free-form lines such as the report title; only the text format shows them
+    virtual void heading(const string& text) { (void)text; }
+
+    virtual void beginTable(const ReportTable& newTable)
+    {
+        table = &newTable;
+        column = 0;
+    }
+
+    virtual void text(const string& value) = 0;
+    virtual void integer(long value) = 0;
+    virtual void decimal(double value) = 0;
+    // A value the row does not have, such as the CGPA of an unknown
+    // student; the column keeps its declared type in every format
+    virtual void missing() = 0;
+    virtual void endRow() = 0;
+    virtual void endTable() { table = NULL; }
+
+    // Flushes and closes the output; false if any file could not be written
+    virtual bool finish()
+    {
+        TRACE_SCOPE("io", "ReportWriter::finish");
+        closeFile();
+        return !failed;
+    }
+
+    bool good() const { return !failed; }
+    const string& getFiles() const { return files; }
+};
+
+
+class TextReportWriter : public ReportWriter
+{
+private:
+    long valueStart;
+
+    void beginValue()
+    {
+        if (table->layout == TABLE_RECORD) {
+            out.put(currentColumn().label).put(": ");
+        }
+        valueStart = out.getPosition();
+    }
+
+    void endValue()
+    {
+        if (table->layout == TABLE_RECORD) {
+            out.put('\n');
+        } else if (column + 1 < table->columnCount) {
+            out.repeat(' ', currentColumn().width - (int)(out.getPosition() - valueStart));
+        }
+        column++;
+    }
+
+public:
+    explicit TextReportWriter(const string& base) : ReportWriter(base), valueStart(0)
+    {
+        openFile(basePath + ".txt");
+    }
+
+    explicit TextReportWriter(ostream& stream) : ReportWriter(stream), valueStart(0) {}
+
+    void heading(const string& line)
+    {
+        out.put(line).put('\n');
+    }
+
+    void beginTable(const ReportTable& newTable)
+    {
+        ReportWriter::beginTable(newTable);
+        out.put("\n--- ").put(table->title).put(" ---\n");
+        if (table->layout == TABLE_ROWS) {
+            long start = out.getPosition();
+            for (int i = 0; i < table->columnCount; i++) {
+                const ReportColumn& col = table->columns[i];
+                if (i + 1 < table->columnCount) out.padded(col.label, col.width);
+                else out.put(col.label);
+            }
+            int width = (int)(out.getPosition() - start);
+            out.put('\n').repeat('-', width).put('\n');
+        }
+    }
+
+    void text(const string& value)
+    {
+        beginValue();
+        out.put(value);
+        endValue();
+    }
+
+    void integer(long value)
+    {
+        beginValue();
+        out.putInt(value);
+        endValue();
+    }
+
+    void decimal(double value)
+    {
+        beginValue();
+        out.putFixed(value, REPORT_DECIMALS);
+        endValue();
+    }
+
+    void missing()
+    {
+        beginValue();
+        endValue();
+    }
+
+    void endRow()
+    {
+        if (table->layout == TABLE_ROWS) out.put('\n');
+        column = 0;
+    }
+};
+
+
+class CsvReportWriter : public ReportWriter
+{
+private:
+    void separator()
+    {
+        if (column++ > 0) out.put(',');
+    }
+
+public:
+    explicit CsvReportWriter(const string& base) : ReportWriter(base) {}
+
+    // One file per table, named <base>_<table>.csv, with a header row
+    void beginTable(const ReportTable& newTable)
+    {
+        ReportWriter::beginTable(newTable);
+        openFile(basePath + "_" + table->name + ".csv");
+        for (int i = 0; i < table->columnCount; i++) {
+            if (i > 0) out.put(',');
+            out.put(table->columns[i].name);
+        }
+        out.put('\n');
+    }
+
+    void text(const string& value)
+    {
+        separator();
+        if (value.find_first_of(",\"\r\n") == string::npos &&
+            (value.empty() || (value[0] != ' ' && value[value.size() - 1] != ' '))) {
+            out.put(value);
+            return;
+        }
+        out.put('"');
+        for (size_t i = 0; i < value.size(); i++) {
+            if (value[i] == '"') out.put('"');
+            out.put(value[i]);
+        }
+        out.put('"');
+    }
+
+    void integer(long value)
+    {
+        separator();
+        out.putInt(value);
+    }
+
+    void decimal(double value)
+    {
+        separator();
+        out.putFixed(value, REPORT_DECIMALS);
+    }
+
+    // An empty field
+    void missing()
+    {
+        separator();
+    }
+
+    void endRow()
+    {
+        out.put('\n');
+        column = 0;
+    }
+};
+
+
+class JsonLinesReportWriter : public ReportWriter
+{
+private:
+    void key()
+    {
+        out.put(column == 0 ? "{\"table\":\"" : ",\"");
+        if (column == 0) out.put(table->name).put("\",\"");
+        out.put(currentColumn().name).put("\":");
+        column++;
+    }
+
+    void quoted(const string& value)
+    {
+        static const char hex[] = "0123456789abcdef";
+        out.put('"');
+        for (size_t i = 0; i < value.size(); i++) {
+            unsigned char c = (unsigned char)value[i];
+            if (c == '"' || c == '\\') {
+                out.put('\\').put((char)c);
+            } else if (c == '\n') {
+                out.put("\\n");
+            } else if (c == '\r') {
+                out.put("\\r");
+            } else if (c == '\t') {
+                out.put("\\t");
+            } else if (c < 0x20) {
+                out.put("\\u00").put(hex[c >> 4]).put(hex[c & 15]);
+            } else {
+                out.put((char)c);
+            }
+        }
+        out.put('"');
+    }
+
+public:
+    explicit JsonLinesReportWriter(const string& base) : ReportWriter(base)
+    {
+        openFile(basePath + ".jsonl");
+    }
+
+    void text(const string& value)
+    {
+        key();
+        quoted(value);
+    }
+
+    void integer(long value)
+    {
+        key();
+        out.putInt(value);
+    }
+
+    void decimal(double value)
+    {
+        key();
+        out.putFixed(value, REPORT_DECIMALS);
+    }
+
+    void missing()
+    {
+        key();
+        out.put("null");
+    }
+
+    void endRow()
+    {
+        out.put("}\n");
+        column = 0;
+    }
+};
+
+
+// Columnar binary layout (all integers little-endian):
+//   file  := "IGSCOL1\n" table*
+//   table := 'T' str(name) u32(columns) { str(column) u8(type) }* block* 'E'
+//   block := 'B' u32(rows) { u32(bytes) values }* one entry per column
+// Integer values are 8-byte signed, decimals 8-byte IEEE doubles and text
+// values are str. str := u32(length) bytes. Types: 0 text, 1 integer, 2 decimal.
+// Missing values are an empty str, the smallest 8-byte integer or a NaN.
+class ColumnarReportWriter : public ReportWriter
+{
+private:
+    string* blocks;     // Encoded values of the current block, one per column
+    int blockCapacity;
+    int blockRows;
+
+    static void appendBytes(string& target, unsigned long value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++) {
+            target += (char)(value & 0xFF);
+            value >>= 8;
+        }
+    }
+
+    static void appendLength(string& target, const string& value)
+    {
+        appendBytes(target, (unsigned long)value.size(), 4);
+        target += value;
+    }
+
+    void putBytes(unsigned long value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++) {
+            out.put((char)(value & 0xFF));
+            value >>= 8;
+        }
+    }
+
+    void putString(const char* value)
+    {
+        int length = (int)strlen(value);
+        putBytes((unsigned long)length, 4);
+        out.put(value, length);
+    }
+
+    void flushBlock()
+    {
+        if (blockRows == 0) return;
+        out.put('B');
+        putBytes((unsigned long)blockRows, 4);
+        for (int i = 0; i < table->columnCount; i++) {
+            putBytes((unsigned long)blocks[i].size(), 4);
+            out.put(blocks[i]);
+            blocks[i].clear();   // Keeps its capacity for the next block
+        }
+        blockRows = 0;
+    }
+
+public:
+    explicit ColumnarReportWriter(const string& base)
+        : ReportWriter(base), blocks(NULL), blockCapacity(0), blockRows(0)
+    {
+        if (openFile(basePath + ".igc")) out.put("IGSCOL1\n");
+    }
+
+    ~ColumnarReportWriter()
+    {
+        delete[] blocks;
+    }
+
+    void beginTable(const ReportTable& newTable)
+    {
+        ReportWriter::beginTable(newTable);
+        if (blockCapacity < table->columnCount) {
+            delete[] blocks;
+            blocks = new string[table->columnCount];
+            blockCapacity = table->columnCount;
+        }
+        out.put('T');
+        putString(table->name);
+        putBytes((unsigned long)table->columnCount, 4);
+        for (int i = 0; i < table->columnCount; i++) {
+            putString(table->columns[i].name);
+            out.put((char)table->columns[i].type);
+        }
+    }
+
+    void text(const string& value)
+    {
+        appendLength(blocks[column++], value);
+    }
+
+    void integer(long value)
+    {
+        // Sign-extend to 8 bytes even where long is 4 bytes
+        string& target = blocks[column++];
+        for (int i = 0; i < 8; i++) {
+            int shift = 8 * i;
+            unsigned char byte = (shift < (int)(8 * sizeof(long)))
+                ? (unsigned char)((value >> shift) & 0xFF)
+                : (unsigned char)(value < 0 ? 0xFF : 0);
+            target += (char)byte;
+        }
+    }
+
+    void decimal(double value)
+    {
+        unsigned char bytes[sizeof(double)];
+        memcpy(bytes, &value, sizeof(double));
+        const unsigned short probe = 1;
+        bool littleEndian = *(const unsigned char*)&probe == 1;
+        string& target = blocks[column++];
+        for (int i = 0; i < (int)sizeof(double); i++) {
+            target += (char)bytes[littleEndian ? i : (int)sizeof(double) - 1 - i];
+        }
+    }
+
+    void missing()
+    {
+        switch (currentColumn().type) {
+            case COLUMN_INTEGER: {
+                string& target = blocks[column++];
+                target.append(7, '\0');
+                target += (char)0x80;
+                break;
+            }
+            case COLUMN_DECIMAL:
+                decimal(numeric_limits<double>::quiet_NaN());
+                break;
+            default:
+                text("");
+        }
+    }
+
+    void endRow()
+    {
+        column = 0;
+        if (++blockRows == COLUMNAR_BLOCK_ROWS) flushBlock();
+    }
+
+    void endTable()
+    {
+        flushBlock();
+        out.put('E');
+        ReportWriter::endTable();
+    }
+};
+
+
+// Opens the writer for a format; check good() before writing
+inline ReportWriter* createReportWriter(ReportFormat format, const string& basePath)
+{
+    switch (format) {
+        case REPORT_CSV: return new CsvReportWriter(basePath);
+        case REPORT_JSONL: return new JsonLinesReportWriter(basePath);
+        case REPORT_COLUMNAR: return new ColumnarReportWriter(basePath);
+        default: return new TextReportWriter(basePath);
+    }
+}
+
+
+// Owns the writer of one report so it is closed on every exit path
+class ReportOutput
+{
+private:
+    ReportWriter* writer;
+
+    ReportOutput(const ReportOutput&);
+    ReportOutput& operator=(const ReportOutput&);
+
+public:
+    ReportOutput(ReportFormat format, const string& basePath)
+        : writer(createReportWriter(format, basePath)) {}
+
+    ~ReportOutput() { delete writer; }
+
+    ReportWriter* operator->() const { return writer; }
+    ReportWriter& operator*() const { return *writer; }
+};
+
+#endif
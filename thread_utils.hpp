@@ -0,0 +1,991 @@
+#ifndef THREAD_UTILS_HPP
+#define THREAD_UTILS_HPP
+
+// Small portable threading helpers for Project_GR1.cpp.
+// Dev-C++ (MinGW 4.9.2) has no std::thread, so we wrap Win32 threads on
+// Windows and pthreads everywhere else. Link with -pthread on Linux/Mac.
+
+#ifdef _WIN32
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // Vista+: SRW locks and condition variables
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+// Maximum number of worker threads any parallel operation will start
+const int MAX_WORKER_THREADS = 16;
+
+typedef void (*ThreadFunction)(void* argument);
+
+// Body of a parallel loop: handles indexes [begin, end)
+typedef void (*RangeFunction)(void* context, int begin, int end);
+
+
+class ConditionVariable;
+
+
+// Plain mutex
+class Mutex
+{
+    friend class ConditionVariable;
+
+private:
+#ifdef _WIN32
+    CRITICAL_SECTION section;
+#else
+    pthread_mutex_t mutex;
+#endif
+
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+
+public:
+#ifdef _WIN32
+    Mutex() { InitializeCriticalSection(&section); }
+    ~Mutex() { DeleteCriticalSection(&section); }
+    void lock() { EnterCriticalSection(&section); }
+    void unlock() { LeaveCriticalSection(&section); }
+#else
+    Mutex() { pthread_mutex_init(&mutex, NULL); }
+    ~Mutex() { pthread_mutex_destroy(&mutex); }
+    void lock() { pthread_mutex_lock(&mutex); }
+    void unlock() { pthread_mutex_unlock(&mutex); }
+#endif
+};
+
+
+// Locks a mutex for the lifetime of the object
+class ScopedLock
+{
+private:
+    Mutex& mutex;
+
+    ScopedLock(const ScopedLock&);
+    ScopedLock& operator=(const ScopedLock&);
+
+public:
+    ScopedLock(Mutex& m) : mutex(m) { mutex.lock(); }
+    ~ScopedLock() { mutex.unlock(); }
+};
+
+
+// Condition variable used together with a locked Mutex
+class ConditionVariable
+{
+private:
+#ifdef _WIN32
+    CONDITION_VARIABLE condition;
+#else
+    pthread_cond_t condition;
+#endif
+
+    ConditionVariable(const ConditionVariable&);
+    ConditionVariable& operator=(const ConditionVariable&);
+
+public:
+#ifdef _WIN32
+    ConditionVariable() { InitializeConditionVariable(&condition); }
+    ~ConditionVariable() {}
+    void wait(Mutex& mutex) { SleepConditionVariableCS(&condition, &mutex.section, INFINITE); }
+    void waitFor(Mutex& mutex, long milliseconds)
+    {
+        SleepConditionVariableCS(&condition, &mutex.section, (DWORD)milliseconds);
+    }
+    void signal() { WakeConditionVariable(&condition); }
+    void broadcast() { WakeAllConditionVariable(&condition); }
+#else
+    ConditionVariable() { pthread_cond_init(&condition, NULL); }
+    ~ConditionVariable() { pthread_cond_destroy(&condition); }
+    void wait(Mutex& mutex) { pthread_cond_wait(&condition, &mutex.mutex); }
+
+    // Waits until signalled or the time is up; callers recheck their condition
+    void waitFor(Mutex& mutex, long milliseconds)
+    {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        long long nanoseconds = (long long)now.tv_usec * 1000 + (long long)milliseconds * 1000000;
+        struct timespec deadline;
+        deadline.tv_sec = now.tv_sec + (time_t)(nanoseconds / 1000000000);
+        deadline.tv_nsec = (long)(nanoseconds % 1000000000);
+        pthread_cond_timedwait(&condition, &mutex.mutex, &deadline);
+    }
+    void signal() { pthread_cond_signal(&condition); }
+    void broadcast() { pthread_cond_broadcast(&condition); }
+#endif
+};
+
+
+// Many readers or one writer
+class ReadWriteLock
+{
+private:
+#ifdef _WIN32
+    SRWLOCK lock;
+#else
+    pthread_rwlock_t lock;
+#endif
+
+    ReadWriteLock(const ReadWriteLock&);
+    ReadWriteLock& operator=(const ReadWriteLock&);
+
+public:
+#ifdef _WIN32
+    ReadWriteLock() { InitializeSRWLock(&lock); }
+    ~ReadWriteLock() {}
+    void lockRead() { AcquireSRWLockShared(&lock); }
+    void unlockRead() { ReleaseSRWLockShared(&lock); }
+    void lockWrite() { AcquireSRWLockExclusive(&lock); }
+    void unlockWrite() { ReleaseSRWLockExclusive(&lock); }
+#else
+    ReadWriteLock() { pthread_rwlock_init(&lock, NULL); }
+    ~ReadWriteLock() { pthread_rwlock_destroy(&lock); }
+    void lockRead() { pthread_rwlock_rdlock(&lock); }
+    void unlockRead() { pthread_rwlock_unlock(&lock); }
+    void lockWrite() { pthread_rwlock_wrlock(&lock); }
+    void unlockWrite() { pthread_rwlock_unlock(&lock); }
+#endif
+};
+
+
+// Scoped shared (read) lock
+class ReadLock
+{
+private:
+    ReadWriteLock& lock;
+
+    ReadLock(const ReadLock&);
+    ReadLock& operator=(const ReadLock&);
+
+public:
+    ReadLock(ReadWriteLock& l) : lock(l) { lock.lockRead(); }
+    ~ReadLock() { lock.unlockRead(); }
+};
+
+
+// Scoped exclusive (write) lock
+class WriteLock
+{
+private:
+    ReadWriteLock& lock;
+
+    WriteLock(const WriteLock&);
+    WriteLock& operator=(const WriteLock&);
+
+public:
+    WriteLock(ReadWriteLock& l) : lock(l) { lock.lockWrite(); }
+    ~WriteLock() { lock.unlockWrite(); }
+};
+
+
+// One OS thread running a plain function
+class WorkerThread
+{
+private:
+    ThreadFunction function;
+    void* argument;
+    bool started;
+#ifdef _WIN32
+    HANDLE handle;
+
+    static DWORD WINAPI entry(LPVOID self)
+    {
+        WorkerThread* thread = (WorkerThread*)self;
+        thread->function(thread->argument);
+        return 0;
+    }
+#else
+    pthread_t handle;
+
+    static void* entry(void* self)
+    {
+        WorkerThread* thread = (WorkerThread*)self;
+        thread->function(thread->argument);
+        return NULL;
+    }
+#endif
+
+    WorkerThread(const WorkerThread&);
+    WorkerThread& operator=(const WorkerThread&);
+
+public:
+    WorkerThread() : function(NULL), argument(NULL), started(false) {}
+    ~WorkerThread() { join(); }
+
+    bool start(ThreadFunction fn, void* arg)
+    {
+        if (started) return false;
+        function = fn;
+        argument = arg;
+#ifdef _WIN32
+        handle = CreateThread(NULL, 0, entry, this, 0, NULL);
+        started = (handle != NULL);
+#else
+        started = (pthread_create(&handle, NULL, entry, this) == 0);
+#endif
+        return started;
+    }
+
+    void join()
+    {
+        if (!started) return;
+#ifdef _WIN32
+        WaitForSingleObject(handle, INFINITE);
+        CloseHandle(handle);
+#else
+        pthread_join(handle, NULL);
+#endif
+        started = false;
+    }
+};
+
+
+// Fixed set of worker threads taking tasks from a shared FIFO queue.
+// Suited to blocking work such as serving one client connection per task.
+class ThreadPool
+{
+private:
+    struct Task
+    {
+        ThreadFunction function;
+        void* argument;
+    };
+
+    WorkerThread* threads;
+    int threadCount;
+    Task* queue;
+    int queueHead;
+    int queueCount;
+    int queueCapacity;
+    bool stopping;
+    Mutex mutex;
+    ConditionVariable taskReady;
+
+    static void workerLoop(void* self)
+    {
+        ThreadPool* pool = (ThreadPool*)self;
+        while (true) {
+            Task task;
+            {
+                ScopedLock guard(pool->mutex);
+                while (pool->queueCount == 0 && !pool->stopping) {
+                    pool->taskReady.wait(pool->mutex);
+                }
+                if (pool->queueCount == 0) return; // stopping and drained
+                task = pool->queue[pool->queueHead];
+                pool->queueHead = (pool->queueHead + 1) % pool->queueCapacity;
+                pool->queueCount--;
+            }
+            task.function(task.argument);
+        }
+    }
+
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+public:
+    ThreadPool(int count) : threadCount(count < 1 ? 1 : count), queueHead(0), queueCount(0),
+                            queueCapacity(64), stopping(false)
+    {
+        queue = new Task[queueCapacity];
+        threads = new WorkerThread[threadCount];
+        for (int i = 0; i < threadCount; i++) {
+            threads[i].start(workerLoop, this);
+        }
+    }
+
+    ~ThreadPool()
+    {
+        shutdown();
+        delete[] threads;
+        delete[] queue;
+    }
+
+    // Queues a task; returns false once shutdown() has started
+    bool submit(ThreadFunction fn, void* arg)
+    {
+        ScopedLock guard(mutex);
+        if (stopping) return false;
+        if (queueCount == queueCapacity) {
+            Task* bigger = new Task[queueCapacity * 2];
+            for (int i = 0; i < queueCount; i++) {
+                bigger[i] = queue[(queueHead + i) % queueCapacity];
+            }
+            delete[] queue;
+            queue = bigger;
+            queueHead = 0;
+            queueCapacity *= 2;
+        }
+        Task& task = queue[(queueHead + queueCount) % queueCapacity];
+        task.function = fn;
+        task.argument = arg;
+        queueCount++;
+        taskReady.signal();
+        return true;
+    }
+
+    // Runs the tasks already queued, then joins the workers
+    void shutdown()
+    {
+        {
+            ScopedLock guard(mutex);
+            if (stopping) return;
+            stopping = true;
+            taskReady.broadcast();
+        }
+        for (int i = 0; i < threadCount; i++) {
+            threads[i].join();
+        }
+    }
+
+    int getThreadCount() const { return threadCount; }
+};
+
+
+// Word-sized atomics with full memory barriers (GCC / MinGW builtins)
+inline long atomicLoad(volatile long* value)
+{
+    return __sync_fetch_and_add(value, 0);
+}
+
+inline void atomicStore(volatile long* value, long newValue)
+{
+    __sync_synchronize();
+    __sync_lock_test_and_set(value, newValue);
+    __sync_synchronize();
+}
+
+inline bool atomicCompareAndSwap(volatile long* value, long expected, long newValue)
+{
+    return __sync_bool_compare_and_swap(value, expected, newValue);
+}
+
+inline long atomicIncrement(volatile long* value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
+
+inline long atomicDecrement(volatile long* value)
+{
+    return __sync_sub_and_fetch(value, 1);
+}
+
+template <typename T>
+inline T* atomicLoadPointer(T* volatile* pointer)
+{
+    return __sync_val_compare_and_swap(pointer, (T*)NULL, (T*)NULL);
+}
+
+template <typename T>
+inline T* atomicExchangePointer(T* volatile* pointer, T* newValue)
+{
+    __sync_synchronize();
+    return __sync_lock_test_and_set(pointer, newValue);
+}
+
+// Loads and stores that are atomic but not ordered: plain moves on x86,
+// and readers on other threads never see a torn value
+template <class T>
+inline T relaxedLoad(const volatile T* value)
+{
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
+
+template <class T>
+inline void relaxedStore(volatile T* value, T newValue)
+{
+    __atomic_store_n(value, newValue, __ATOMIC_RELAXED);
+}
+
+// Publishes a value after the writes before it; pair with acquireLoad
+template <class T>
+inline void releaseStore(volatile T* value, T newValue)
+{
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+template <class T>
+inline T acquireLoad(const volatile T* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+// Gives up the rest of this thread's time slice
+inline void yieldThread()
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+
+// One pointer per thread (pthread keys / Win32 TLS)
+class ThreadLocalPointer
+{
+private:
+#ifdef _WIN32
+    DWORD key;
+#else
+    pthread_key_t key;
+#endif
+
+    ThreadLocalPointer(const ThreadLocalPointer&);
+    ThreadLocalPointer& operator=(const ThreadLocalPointer&);
+
+public:
+#ifdef _WIN32
+    ThreadLocalPointer() { key = TlsAlloc(); }
+    ~ThreadLocalPointer() { TlsFree(key); }
+    void set(void* value) { TlsSetValue(key, value); }
+    void* get() const { return TlsGetValue(key); }
+#else
+    ThreadLocalPointer() { pthread_key_create(&key, NULL); }
+    ~ThreadLocalPointer() { pthread_key_delete(key); }
+    void set(void* value) { pthread_setspecific(key, value); }
+    void* get() const { return pthread_getspecific(key); }
+#endif
+};
+
+
+class TaskScheduler;
+
+
+// Fork/join region: tasks spawned through the group are waited for
+// together. Tasks must not throw.
+class TaskGroup
+{
+private:
+    TaskScheduler& scheduler;
+    volatile long pending;
+
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+
+    friend class TaskScheduler;
+
+public:
+    TaskGroup(TaskScheduler& s) : scheduler(s), pending(0) {}
+    ~TaskGroup() { wait(); }
+
+    void spawn(ThreadFunction fn, void* arg);
+    void wait();
+};
+
+
+// Work-stealing scheduler for CPU-bound work. Every worker owns a queue:
+// it pushes and pops its own tasks at the back and steals from the front
+// of the others when it runs dry. Threads outside the pool share one extra
+// queue and run tasks themselves while they wait on a TaskGroup, so a
+// scheduler with N workers runs on N + 1 threads.
+class TaskScheduler
+{
+private:
+    struct Task
+    {
+        ThreadFunction function;
+        void* argument;
+        TaskGroup* group;
+    };
+
+    struct WorkQueue
+    {
+        Mutex mutex;
+        Task* tasks;
+        int head;
+        int count;
+        int capacity;
+
+        WorkQueue() : head(0), count(0), capacity(64) { tasks = new Task[capacity]; }
+        ~WorkQueue() { delete[] tasks; }
+
+        void pushBack(const Task& task)
+        {
+            ScopedLock guard(mutex);
+            if (count == capacity) {
+                Task* bigger = new Task[capacity * 2];
+                for (int i = 0; i < count; i++) {
+                    bigger[i] = tasks[(head + i) % capacity];
+                }
+                delete[] tasks;
+                tasks = bigger;
+                head = 0;
+                capacity *= 2;
+            }
+            tasks[(head + count) % capacity] = task;
+            count++;
+        }
+
+        bool popBack(Task& task)
+        {
+            ScopedLock guard(mutex);
+            if (count == 0) return false;
+            count--;
+            task = tasks[(head + count) % capacity];
+            return true;
+        }
+
+        bool popFront(Task& task)
+        {
+            ScopedLock guard(mutex);
+            if (count == 0) return false;
+            task = tasks[head];
+            head = (head + 1) % capacity;
+            count--;
+            return true;
+        }
+    };
+
+    struct WorkerStart
+    {
+        TaskScheduler* scheduler;
+        int index;
+    };
+
+    int workerCount;
+    WorkQueue* queues;          // workerCount worker queues + 1 shared queue
+    WorkerThread* threads;
+    WorkerStart* starts;
+    ThreadLocalPointer currentWorker;
+    volatile long queuedTasks;
+    volatile long sleepingWorkers;
+    volatile long stopping;
+    Mutex idleMutex;
+    ConditionVariable workAvailable;
+
+    // Queue index of the calling thread
+    int queueIndex() const
+    {
+        WorkerStart* start = (WorkerStart*)currentWorker.get();
+        return (start != NULL && start->scheduler == this) ? start->index : workerCount;
+    }
+
+    static void workerLoop(void* argument)
+    {
+        WorkerStart* start = (WorkerStart*)argument;
+        TaskScheduler* scheduler = start->scheduler;
+        scheduler->currentWorker.set(start);
+
+        while (true) {
+            if (scheduler->runOneTask()) continue;
+
+            ScopedLock guard(scheduler->idleMutex);
+            atomicIncrement(&scheduler->sleepingWorkers);
+            while (atomicLoad(&scheduler->queuedTasks) == 0 && !atomicLoad(&scheduler->stopping)) {
+                scheduler->workAvailable.wait(scheduler->idleMutex);
+            }
+            atomicDecrement(&scheduler->sleepingWorkers);
+            if (atomicLoad(&scheduler->stopping) && atomicLoad(&scheduler->queuedTasks) == 0) return;
+        }
+    }
+
+    struct RangeTask
+    {
+        TaskGroup* group;
+        RangeFunction function;
+        void* context;
+        int begin;
+        int end;
+        int grain;
+    };
+
+    // Splits off the upper half for thieves until the range is one grain
+    static void runRange(void* argument)
+    {
+        RangeTask* task = (RangeTask*)argument;
+        while (task->end - task->begin > task->grain) {
+            int mid = task->begin + (task->end - task->begin) / 2;
+            RangeTask* upper = new RangeTask(*task);
+            upper->begin = mid;
+            task->group->spawn(runRange, upper);
+            task->end = mid;
+        }
+        task->function(task->context, task->begin, task->end);
+        delete task;
+    }
+
+    TaskScheduler(const TaskScheduler&);
+    TaskScheduler& operator=(const TaskScheduler&);
+
+    friend class TaskGroup;
+
+public:
+    TaskScheduler(int workers) : workerCount(workers < 0 ? 0 : workers), queuedTasks(0),
+                                 sleepingWorkers(0), stopping(0)
+    {
+        if (workerCount > MAX_WORKER_THREADS) workerCount = MAX_WORKER_THREADS;
+        queues = new WorkQueue[workerCount + 1];
+        threads = new WorkerThread[workerCount];
+        starts = new WorkerStart[workerCount];
+        for (int i = 0; i < workerCount; i++) {
+            starts[i].scheduler = this;
+            starts[i].index = i;
+            threads[i].start(workerLoop, &starts[i]);
+        }
+    }
+
+    ~TaskScheduler()
+    {
+        {
+            ScopedLock guard(idleMutex);
+            atomicStore(&stopping, 1);
+            workAvailable.broadcast();
+        }
+        for (int i = 0; i < workerCount; i++) {
+            threads[i].join();
+        }
+        delete[] threads;
+        delete[] starts;
+        delete[] queues;
+    }
+
+    // Threads that run work, counting the caller
+    int getConcurrency() const { return workerCount + 1; }
+
+    // Runs one queued task on the calling thread: its own newest task
+    // first, otherwise the oldest task of another queue
+    bool runOneTask()
+    {
+        int self = queueIndex();
+        int queueCount = workerCount + 1;
+        Task task;
+        bool found = queues[self].popBack(task);
+        for (int i = 1; i < queueCount && !found; i++) {
+            found = queues[(self + i) % queueCount].popFront(task);
+        }
+        if (!found) return false;
+
+        atomicDecrement(&queuedTasks);
+        task.function(task.argument);
+        atomicDecrement(&task.group->pending);
+        return true;
+    }
+
+    // Calls fn(context, begin, end) over [begin, end) in grain-sized pieces,
+    // spread over the workers; returns when every piece is done.
+    // A grain of 0 picks one that gives each thread several pieces.
+    void parallelFor(int begin, int end, int grain, RangeFunction fn, void* context)
+    {
+        if (end <= begin) return;
+        if (grain <= 0) grain = (end - begin) / (getConcurrency() * 8);
+        if (grain < 1) grain = 1;
+
+        TaskGroup group(*this);
+        RangeTask* root = new RangeTask;
+        root->group = &group;
+        root->function = fn;
+        root->context = context;
+        root->begin = begin;
+        root->end = end;
+        root->grain = grain;
+        runRange(root);
+        group.wait();
+    }
+};
+
+
+inline void TaskGroup::spawn(ThreadFunction fn, void* arg)
+{
+    atomicIncrement(&pending);
+
+    TaskScheduler::Task task;
+    task.function = fn;
+    task.argument = arg;
+    task.group = this;
+    scheduler.queues[scheduler.queueIndex()].pushBack(task);
+
+    atomicIncrement(&scheduler.queuedTasks);
+    if (atomicLoad(&scheduler.sleepingWorkers) > 0) {
+        ScopedLock guard(scheduler.idleMutex);
+        scheduler.workAvailable.signal();
+    }
+}
+
+// Helps run tasks until everything spawned through this group has finished
+inline void TaskGroup::wait()
+{
+    while (atomicLoad(&pending) > 0) {
+        if (!scheduler.runOneTask()) yieldThread();
+    }
+}
+
+
+// Stable merge sort of items[0, count) on a TaskScheduler: the halves are
+// sorted as fork/join tasks and large merges are split around a pivot so
+// they run in parallel too. less(a, b) must be a strict weak ordering.
+template <typename T>
+class ParallelMergeSort
+{
+public:
+    typedef bool (*LessFunction)(const T& a, const T& b);
+
+private:
+    enum { SEQUENTIAL_CUTOFF = 2048, INSERTION_CUTOFF = 24 };
+
+    struct SortTask
+    {
+        TaskScheduler* scheduler;
+        T* items;
+        T* buffer;
+        int begin;
+        int end;
+        LessFunction less;
+    };
+
+    struct MergeTask
+    {
+        TaskScheduler* scheduler;
+        const T* source;
+        int leftBegin, leftEnd;
+        int rightBegin, rightEnd;
+        T* output;
+        LessFunction less;
+    };
+
+    struct CopyContext
+    {
+        const T* from;
+        T* to;
+    };
+
+    static void sequentialSort(T* items, T* buffer, int begin, int end, LessFunction less)
+    {
+        if (end - begin <= INSERTION_CUTOFF) {
+            for (int i = begin + 1; i < end; i++) {
+                T key = items[i];
+                int j = i - 1;
+                while (j >= begin && less(key, items[j])) {
+                    items[j + 1] = items[j];
+                    j--;
+                }
+                items[j + 1] = key;
+            }
+            return;
+        }
+        int mid = begin + (end - begin) / 2;
+        sequentialSort(items, buffer, begin, mid, less);
+        sequentialSort(items, buffer, mid, end, less);
+        if (!less(items[mid], items[mid - 1])) return; // already in order
+
+        int i = begin, j = mid, k = begin;
+        while (i < mid && j < end) {
+            buffer[k++] = less(items[j], items[i]) ? items[j++] : items[i++];
+        }
+        while (i < mid) buffer[k++] = items[i++];
+        while (j < end) buffer[k++] = items[j++];
+        for (k = begin; k < end; k++) items[k] = buffer[k];
+    }
+
+    // First index in [begin, end) whose item is not less than value
+    static int lowerBound(const T* items, int begin, int end, const T& value, LessFunction less)
+    {
+        while (begin < end) {
+            int mid = begin + (end - begin) / 2;
+            if (less(items[mid], value)) begin = mid + 1; else end = mid;
+        }
+        return begin;
+    }
+
+    // First index in [begin, end) whose item is greater than value
+    static int upperBound(const T* items, int begin, int end, const T& value, LessFunction less)
+    {
+        while (begin < end) {
+            int mid = begin + (end - begin) / 2;
+            if (less(value, items[mid])) end = mid; else begin = mid + 1;
+        }
+        return begin;
+    }
+
+    // Merges two sorted runs into output; equal items keep left before right
+    static void merge(void* argument)
+    {
+        MergeTask* task = (MergeTask*)argument;
+        int leftSize = task->leftEnd - task->leftBegin;
+        int rightSize = task->rightEnd - task->rightBegin;
+
+        if (leftSize + rightSize <= SEQUENTIAL_CUTOFF || task->scheduler->getConcurrency() == 1) {
+            const T* source = task->source;
+            int i = task->leftBegin, j = task->rightBegin;
+            T* out = task->output;
+            while (i < task->leftEnd && j < task->rightEnd) {
+                *out++ = task->less(source[j], source[i]) ? source[j++] : source[i++];
+            }
+            while (i < task->leftEnd) *out++ = source[i++];
+            while (j < task->rightEnd) *out++ = source[j++];
+            return;
+        }
+
+        // Split both runs around a pivot from the longer one
+        int leftSplit, rightSplit;
+        if (leftSize >= rightSize) {
+            leftSplit = task->leftBegin + leftSize / 2;
+            rightSplit = lowerBound(task->source, task->rightBegin, task->rightEnd,
+                                    task->source[leftSplit], task->less);
+        } else {
+            rightSplit = task->rightBegin + rightSize / 2;
+            leftSplit = upperBound(task->source, task->leftBegin, task->leftEnd,
+                                   task->source[rightSplit], task->less);
+        }
+
+        MergeTask lower = *task;
+        lower.leftEnd = leftSplit;
+        lower.rightEnd = rightSplit;
+
+        MergeTask upper = *task;
+        upper.leftBegin = leftSplit;
+        upper.rightBegin = rightSplit;
+        upper.output = task->output + (leftSplit - task->leftBegin) + (rightSplit - task->rightBegin);
+
+        TaskGroup group(*task->scheduler);
+        group.spawn(merge, &upper);
+        merge(&lower);
+        group.wait();
+    }
+
+    static void copyRange(void* context, int begin, int end)
+    {
+        CopyContext* copy = (CopyContext*)context;
+        for (int i = begin; i < end; i++) copy->to[i] = copy->from[i];
+    }
+
+    static void sort(void* argument)
+    {
+        SortTask* task = (SortTask*)argument;
+        if (task->end - task->begin <= SEQUENTIAL_CUTOFF || task->scheduler->getConcurrency() == 1) {
+            sequentialSort(task->items, task->buffer, task->begin, task->end, task->less);
+            return;
+        }
+
+        int mid = task->begin + (task->end - task->begin) / 2;
+        SortTask lower = *task;
+        lower.end = mid;
+        SortTask upper = *task;
+        upper.begin = mid;
+        {
+            TaskGroup group(*task->scheduler);
+            group.spawn(sort, &upper);
+            sort(&lower);
+            group.wait();
+        }
+        if (!task->less(task->items[mid], task->items[mid - 1])) return; // already in order
+
+        MergeTask join;
+        join.scheduler = task->scheduler;
+        join.source = task->items;
+        join.leftBegin = task->begin;
+        join.leftEnd = mid;
+        join.rightBegin = mid;
+        join.rightEnd = task->end;
+        join.output = task->buffer + task->begin;
+        join.less = task->less;
+        merge(&join);
+
+        CopyContext copy;
+        copy.from = task->buffer;
+        copy.to = task->items;
+        task->scheduler->parallelFor(task->begin, task->end, SEQUENTIAL_CUTOFF, copyRange, &copy);
+    }
+
+public:
+    // Same algorithm and result on the calling thread only
+    static void runSequential(T* items, int count, LessFunction less)
+    {
+        if (count < 2) return;
+        T* buffer = new T[count];
+        sequentialSort(items, buffer, 0, count, less);
+        delete[] buffer;
+    }
+
+    static void run(TaskScheduler& scheduler, T* items, int count, LessFunction less)
+    {
+        if (count < 2) return;
+        T* buffer = new T[count];
+        SortTask task;
+        task.scheduler = &scheduler;
+        task.items = items;
+        task.buffer = buffer;
+        task.begin = 0;
+        task.end = count;
+        task.less = less;
+        sort(&task);
+        delete[] buffer;
+    }
+};
+
+
+// Convenience wrapper: parallelStableSort(scheduler, students, n, byCGPA)
+template <typename T>
+inline void parallelStableSort(TaskScheduler& scheduler, T* items, int count,
+                               bool (*less)(const T& a, const T& b))
+{
+    ParallelMergeSort<T>::run(scheduler, items, count, less);
+}
+
+template <typename T>
+inline void sequentialStableSort(T* items, int count, bool (*less)(const T& a, const T& b))
+{
+    ParallelMergeSort<T>::runSequential(items, count, less);
+}
+
+
+// Number of hardware threads, at least 1 and at most MAX_WORKER_THREADS
+inline int getHardwareThreadCount()
+{
+    long n = 1;
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    n = (long)info.dwNumberOfProcessors;
+#else
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (n < 1) n = 1;
+    if (n > MAX_WORKER_THREADS) n = MAX_WORKER_THREADS;
+    return (int)n;
+}
+
+
+// Wall clock in seconds with sub-millisecond resolution (for throughput figures)
+inline double getWallClockSeconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+#endif
+}
+
+
+// Monotonic clock in nanoseconds, for timing operations
+inline long long getMonotonicNanoseconds()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+#endif
+}
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+// Scoped trace spans for Project_GR1.cpp, written as a Chrome trace-event
+// file that chrome://tracing and Perfetto (ui.perfetto.dev) open directly.
+//
+//   TRACE_SCOPE("save", "saveStudentsToFile");
+//
+// records the enclosing block as one span on the calling thread's lane.
+// Tracing is off until TraceRecorder::start() and then costs two clock
+// reads and a store per span; each thread appends to its own buffer, so
+// spans never take a lock. Build with -DIGS_NO_TRACING to compile every
+// TRACE_SCOPE out.
+
+#include <cstdio>
+#include <string>
+#include "thread_utils.hpp"
+using namespace std;
+
+
+const int TRACE_CHUNK_EVENTS = 4096;              // Spans per buffer allocation
+const long MAX_TRACE_EVENTS_PER_THREAD = 1L << 18; // Later spans are counted as dropped
+
+
+struct TraceEvent
+{
+    const char* category;  // String literals only: kept until the file is written
+    const char* name;
+    long long start;       // Nanoseconds since the recorder started
+    long long duration;
+};
+
+struct TraceChunk
+{
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+    volatile long count;
+    TraceChunk* volatile next;
+
+    TraceChunk() : count(0), next(NULL) {}
+};
+
+// Spans of one thread; only that thread appends
+struct TraceBuffer
+{
+    int threadID;
+    TraceChunk* first;
+    TraceChunk* last;
+    long events;
+    long dropped;
+    TraceBuffer* next;
+};
+
+
+class TraceRecorder
+{
+private:
+    volatile long enabled;
+    string path;
+    long long origin;
+    ThreadLocalPointer threadBuffer;
+    Mutex mutex;              // Guards the list of buffers
+    TraceBuffer* buffers;
+    int bufferCount;
+
+    TraceBuffer* buffer()
+    {
+        TraceBuffer* mine = (TraceBuffer*)threadBuffer.get();
+        if (mine != NULL) return mine;
+
+        mine = new TraceBuffer();
+        mine->first = mine->last = new TraceChunk();
+        mine->events = 0;
+        mine->dropped = 0;
+        {
+            ScopedLock guard(mutex);
+            mine->threadID = ++bufferCount;
+            mine->next = buffers;
+            buffers = mine;
+        }
+        threadBuffer.set(mine);
+        return mine;
+    }
+
+    static void writeString(FILE* file, const char* text)
+    {
+        fputc('"', file);
+        for (const char* p = text; *p != '\0'; p++) {
+            if (*p == '"' || *p == '\\') fputc('\\', file);
+            fputc(*p, file);
+        }
+        fputc('"', file);
+    }
+
+    void release()
+    {
+        while (buffers != NULL) {
+            TraceBuffer* next = buffers->next;
+            TraceChunk* chunk = buffers->first;
+            while (chunk != NULL) {
+                TraceChunk* following = chunk->next;
+                delete chunk;
+                chunk = following;
+            }
+            delete buffers;
+            buffers = next;
+        }
+        bufferCount = 0;
+    }
+
+    TraceRecorder(const TraceRecorder&);
+    TraceRecorder& operator=(const TraceRecorder&);
+
+public:
+    TraceRecorder() : enabled(0), origin(0), buffers(NULL), bufferCount(0) {}
+    ~TraceRecorder() { release(); }
+
+    // Starts recording spans for file; false if it cannot be created
+    bool start(const string& file)
+    {
+        FILE* probe = fopen(file.c_str(), "w");
+        if (probe == NULL) return false;
+        fclose(probe);
+        path = file;
+        origin = getMonotonicNanoseconds();
+        releaseStore(&enabled, 1L);
+        return true;
+    }
+
+    bool isEnabled() const { return relaxedLoad(&enabled) != 0; }
+    long long now() const { return getMonotonicNanoseconds() - origin; }
+
+    void record(const char* category, const char* name, long long start, long long end)
+    {
+        TraceBuffer* mine = buffer();
+        if (mine->events >= MAX_TRACE_EVENTS_PER_THREAD) {
+            mine->dropped++;
+            return;
+        }
+        TraceChunk* chunk = mine->last;
+        long used = chunk->count;
+        if (used == TRACE_CHUNK_EVENTS) {
+            TraceChunk* fresh = new TraceChunk();
+            releaseStore(&chunk->next, fresh);
+            mine->last = chunk = fresh;
+            used = 0;
+        }
+        TraceEvent& event = chunk->events[used];
+        event.category = category;
+        event.name = name;
+        event.start = start;
+        event.duration = end - start;
+        releaseStore(&chunk->count, used + 1);
+        mine->events++;
+    }
+
+    // Stops recording and writes every span as a Chrome trace; returns the
+    // number of spans written, or -1 if the file could not be written.
+    // Spans still open on other threads when this runs are left out.
+    long stop()
+    {
+        if (!isEnabled()) return 0;
+        releaseStore(&enabled, 0L);
+
+        FILE* file = fopen(path.c_str(), "w");
+        if (file == NULL) return -1;
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"InternshipSystem\"}}");
+
+        long written = 0;
+        long dropped = 0;
+        ScopedLock guard(mutex);
+        for (TraceBuffer* thread = buffers; thread != NULL; thread = thread->next) {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                          "\"args\":{\"name\":\"thread %d\"}}",
+                    thread->threadID, thread->threadID);
+            for (TraceChunk* chunk = thread->first; chunk != NULL; chunk = acquireLoad(&chunk->next)) {
+                long count = acquireLoad(&chunk->count);
+                for (long i = 0; i < count; i++) {
+                    const TraceEvent& event = chunk->events[i];
+                    fprintf(file, ",\n{\"name\":");
+                    writeString(file, event.name);
+                    fprintf(file, ",\"cat\":");
+                    writeString(file, event.category);
+                    fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                            thread->threadID, event.start / 1000.0, event.duration / 1000.0);
+                    written++;
+                }
+            }
+            dropped += thread->dropped;
+        }
+        if (dropped > 0) {
+            fprintf(file, ",\n{\"name\":\"dropped_spans\",\"ph\":\"M\",\"pid\":1,\"args\":{\"count\":%ld}}", dropped);
+        }
+        fprintf(file, "\n]}\n");
+        bool ok = !ferror(file);
+        ok = (fclose(file) == 0) && ok;
+        return ok ? written : -1;
+    }
+
+    const string& getPath() const { return path; }
+};
+
+
+// The process-wide recorder
+inline TraceRecorder& traceRecorder()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+
+// Records its own lifetime as a span when tracing is on
+class TraceSpan
+{
+private:
+    const char* category;
+    const char* name;
+    long long start;  // -1 when tracing was off at construction
+
+    TraceSpan(const TraceSpan&);
+    TraceSpan& operator=(const TraceSpan&);
+
+public:
+    TraceSpan(const char* c, const char* n)
+        : category(c), name(n), start(traceRecorder().isEnabled() ? traceRecorder().now() : -1) {}
+
+    ~TraceSpan()
+    {
+        if (start >= 0 && traceRecorder().isEnabled()) {
+            traceRecorder().record(category, name, start, traceRecorder().now());
+        }
+    }
+};
+
+
+// Writes the trace when it goes out of scope, so every way out of main()
+// saves it
+class TraceSession
+{
+private:
+    bool active;
+
+    TraceSession(const TraceSession&);
+    TraceSession& operator=(const TraceSession&);
+
+public:
+    TraceSession() : active(false) {}
+
+    bool start(const string& file)
+    {
+        active = traceRecorder().start(file);
+        return active;
+    }
+
+    ~TraceSession()
+    {
+        if (!active) return;
+        long spans = traceRecorder().stop();
+        if (spans < 0) {
+            printf("Cannot write trace file %s\n", traceRecorder().getPath().c_str());
+        } else {
+            printf("Trace written to %s (%ld spans)\n", traceRecorder().getPath().c_str(), spans);
+        }
+    }
+};
+
+
+#ifdef IGS_NO_TRACING
+#define TRACE_SCOPE(category, name)
+#else
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(category, name)
+#endif
+
+#endif